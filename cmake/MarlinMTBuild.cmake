@@ -66,12 +66,19 @@ marlinmt_option(
   VALUE OFF
   DOC "Set to ON to compile MarlinMT with -Werror"
 )
+marlinmt_option(
+  NAME MARLINMT_MIN_LOG_LEVEL
+  VALUE DEBUG
+  DOC "The lowest log level compiled in. Lazy logging statements below this level are removed"
+  CACHE
+  POSSIBLE_VALUES DEBUG MESSAGE WARNING ERROR
+)
 marlinmt_option(
   NAME MARLINMT_BOOK_IMPL
   VALUE dummy
   DOC "The MarlinMT Book implementation"
   CACHE 
-  POSSIBLE_VALUES root6 root7 dummy
+  POSSIBLE_VALUES root6 root7 native dummy
 )
 
 # List of compiler we want to compile MarlinMT with.
@@ -114,6 +114,7 @@ endfunction()
 # Usage:
 #    marlinmt_add_test( <name>
 #       [BUILD_EXEC]
+#       [NO_TEST]
 #       [COMMAND <cmd>]
 #       [DEPENDS <dependencies>]
 #       [EXEC_ARGS <args>]
@@ -122,8 +123,10 @@ endfunction()
 #       [REQUIRES <target(s)>]
 #    )
 #
+# With NO_TEST, the executable is built but not registered as a test (e.g benchmarks)
+#
 function ( MARLINMT_ADD_TEST test_name )
-  cmake_parse_arguments(ARG "BUILD_EXEC" "" "COMMAND;DEPENDS;EXEC_ARGS;REGEX_PASS;REGEX_FAIL;REQUIRES;COMPONENTS;MARLINMT_DLL" ${ARGN} )
+  cmake_parse_arguments(ARG "BUILD_EXEC;NO_TEST" "" "COMMAND;DEPENDS;EXEC_ARGS;REGEX_PASS;REGEX_FAIL;REQUIRES;COMPONENTS;MARLINMT_DLL" ${ARGN} )
   set ( missing )
   set ( use_test 1 )
 
@@ -154,6 +157,10 @@ function ( MARLINMT_ADD_TEST test_name )
     set_target_properties( ${test_name} PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/tests" )
   endif()
 
+  if ( ${ARG_NO_TEST} )
+    return()
+  endif()
+
   set ( cmd ${ARG_COMMAND} )
   if ( "${cmd}" STREQUAL "" )
     if( ${ARG_BUILD_EXEC} )
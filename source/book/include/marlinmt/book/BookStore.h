@@ -5,7 +5,6 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -24,6 +23,7 @@
 #include "marlinmt/book/Flags.h"
 #include "marlinmt/book/MemLayout.h"
 #include "marlinmt/book/Selection.h"
+#include "marlinmt/book/ThreadSlot.h"
 #include "marlinmt/book/Types.h"
 
 namespace marlinmt {
@@ -41,16 +41,9 @@ namespace marlinmt {
       friend BookStore ;
       friend WeakEntry ;
 
-      using ThreadId_t = std::thread::id;
-      using IdMap_t = std::unordered_map< ThreadId_t, std::size_t > ;
-
       /// constructor
       explicit Handle( std::shared_ptr< const details::Entry > entry )
-        : _entry{std::move( entry )},
-          _mapping( std::make_unique< IdMap_t >() ) {}
-
-      /// maps outside id to internal id
-      std::size_t unmap( const ThreadId_t& id ) ;
+        : _entry{std::move( entry )} {}
 
     public:
       Handle()                            = default ;
@@ -61,15 +54,14 @@ namespace marlinmt {
 
       ~Handle()                           = default ;
 
-      /// custom move (atomic is not movable)
-      Handle( Handle &&hnd ) noexcept ;
+      Handle( Handle && ) noexcept            = default ;
 
-      /// custom move (atomic is not movable)
-      Handle &operator=( Handle &&hnd ) noexcept ;
+      Handle &operator=( Handle && ) noexcept = default ;
 
       /**
        *  @brief get handle for Object. 
-       *  offers handle based on thread_id to avoid unused duplications.
+       *  offers handle based on the thread slot (see ThreadSlot),
+       *  to avoid unused duplications.
        */
       Handle< T > handle() ;
 
@@ -82,12 +74,6 @@ namespace marlinmt {
     private:
       /// reference to handled Entry.
       std::shared_ptr< const details::Entry > _entry{nullptr} ;
-      /// maps ids to Handle instances.
-      std::unique_ptr< IdMap_t > _mapping{} ;
-      /// count number of Handle instances.
-      std::atomic< std::size_t > _count{0} ;
-      /// shared mutex for serialisation when writing 
-      std::shared_mutex _mappingAccess{};
     } ;
 
     /**
@@ -183,6 +169,16 @@ namespace marlinmt {
           std::filesystem::path path,
           Args_t... ctor_p) ;
 
+      /**
+       *  @brief creates an Entry for parallel access.
+       *  Creates one object in Memory, modified with atomic operations.
+       *  No buffer and no merging.
+       */
+      template < class T, typename... Args_t >
+      std::shared_ptr<details::Entry> bookMultiAtomic(
+          std::filesystem::path path,
+          Args_t... ctor_p) ;
+
       /**
        *  @brief normalize and check path for internal usage. 
        *  @throw BookStoreException if path is no absolute path to a directory.
@@ -382,6 +378,23 @@ namespace marlinmt {
       return addEntry( entry, key ) ;
     }
 
+    //--------------------------------------------------------------------------
+    template < class T, typename... Args_t >
+    std::shared_ptr< details::Entry >
+    BookStore::bookMultiAtomic(
+        std::filesystem::path path,
+        Args_t...           ctor_p ) {
+      EntryKey key{std::type_index( typeid( T ) )} ;
+      key.path       = std::move(path) ;
+      key.mInstances = 1 ;
+      key.flags      = Flags::Book::MultiAtomic ;
+
+      auto entry = std::make_shared< EntryMultiAtomic< T > >( Context(
+        std::make_shared< SingleMemLayout< T, Args_t... > >( ctor_p... ) , 1 ) ) ;
+
+      return addEntry( entry, key ) ;
+    }
+
     //--------------------------------------------------------------------------
 
     template < class T >
@@ -411,23 +424,6 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
-    template < typename T >
-    std::size_t Handle< Entry< T > >::unmap( 
-        const Handle<Entry<T>>::ThreadId_t& id ) {
-      {
-        std::shared_lock lock(_mappingAccess);
-        auto itr = _mapping->find( id ) ;
-        if ( itr != _mapping->end() ) {
-          return itr->second;
-        }
-      }
-
-      std::unique_lock lock(_mappingAccess);
-      return _mapping->insert(std::make_pair( id, _count++ ) ).first->second;
-    }
-
-    //--------------------------------------------------------------------------
-    
     template< typename T >
     const T& Handle< Entry< T > >::merged() const {
       return _entry->handle<T>(0).merged();     
@@ -435,33 +431,9 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
-    template < typename T >
-    Handle< Entry< T > >::Handle( Handle &&hnd ) noexcept
-      : _entry( nullptr ), _mapping( nullptr ), _count( hnd._count.load() ) {
-      _entry   = hnd._entry ;
-      _mapping = std::move( hnd._mapping ) ;
-
-      hnd._entry.reset() ;
-    }
-
-    //--------------------------------------------------------------------------
-
-    template < typename T >
-    Handle< Entry< T > > &Handle< Entry< T > >::
-                            operator=( Handle<Entry<T>> &&hnd ) noexcept {
-      _entry   = hnd._entry ;
-      _mapping = std::move( hnd._mapping ) ;
-      _count       = hnd._count.load() ;
-
-      hnd._entry.reset() ;
-      return *this ;
-    }
-
-    //--------------------------------------------------------------------------
-
     template < typename T >
     Handle< T > Handle< Entry< T > >::handle() {
-      std::size_t id = unmap( std::this_thread::get_id() ) ;
+      std::size_t id = ThreadSlot::current() ;
       return _entry->handle< T >( id <  _entry->key().mInstances ? id : -1) ;
     }
 
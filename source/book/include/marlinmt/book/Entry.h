@@ -109,11 +109,40 @@ namespace marlinmt {
       Context _context ;
     } ;
 
+    /**
+     *  @brief entry for object to be used Multithreaded.
+     *  contain only one Instance, modified with atomic operations.
+     *  @note no buffer and no merge, but each modification is an atomic operation.
+     */
+    template < typename T >
+    class EntryMultiAtomic : public EntryBase {
+      friend BookStore ;
+
+      /// constructor
+      explicit EntryMultiAtomic( Context context )
+        : _context{std::move( context )} {}
+
+    public:
+      static constexpr Flag_t Flag = Flags::Book::MultiAtomic;
+      /// default constructor
+      EntryMultiAtomic() = default ;
+
+      /// Creates a new Handle for the object.
+      Handle< T > handle() {
+        return Handle( _context.mem, _context.mem->at< T >( 0 ) ) ;
+      }
+
+    private:
+      /// \see {EntrySingle::_context}
+      Context _context ;
+    } ;
+
     template<typename Type>
     using EntryTypes = std::tuple<
       EntrySingle<Type>,
       EntryMultiCopy<Type>,
-      EntryMultiShared<Type>
+      EntryMultiShared<Type>,
+      EntryMultiAtomic<Type>
     >;
 
     namespace details {
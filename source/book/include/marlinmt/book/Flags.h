@@ -119,6 +119,10 @@ namespace marlinmt {
         constexpr Flag_t MultiCopy( 1U << 2U ) ;
         /// store object in file at end of lifetime
         constexpr Flag_t Store( 1U << 3U ) ;
+        /// create one instance, filled concurrently with atomic bin updates.
+        /// Falls back to locked fills if the histogram config has no atomic
+        /// bins (see types::AtomicBins).
+        constexpr Flag_t MultiAtomic( 1U << 4U ) ;
       } // end namespace Book
 
     } // end namespace Flags
@@ -131,7 +135,8 @@ namespace marlinmt {
         constexpr Flag_t MemoryLayout (
           Flags::value(Flags::Book::Single)
           | Flags::value(Flags::Book::MultiShared)
-          | Flags::value(Flags::Book::MultiCopy)) ; 
+          | Flags::value(Flags::Book::MultiCopy)
+          | Flags::value(Flags::Book::MultiAtomic)) ; 
 
         /// Mask for Flags with store option
         constexpr Flag_t StoreOptions(
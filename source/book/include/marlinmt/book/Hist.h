@@ -47,6 +47,15 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
+    template < typename Config >
+    EntryData< types::HistT<Config>, Flags::value(Flags::Book::MultiAtomic) >
+    EntryDataBase< types::HistT<Config> >::multiAtomic() const {
+      return EntryData< types::HistT<Config>,
+                        Flags::value(Flags::Book::MultiAtomic) >( *this ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
     template<typename  Config>
     EntryData< types::HistT<Config>, 0 >::EntryData( 
         const typename types::HistT<Config>::AxisConfig_t &axis )
@@ -305,6 +314,29 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
+    template < typename Config >
+    EntryMultiAtomic< types::HistT<Config> >::EntryMultiAtomic(
+      Context context )
+      : _context{std::move(context)} {
+      types::prepareAtomic( *_context.mem->at< Type >( 0 ) ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template < typename Config >
+    Handle< types::HistT<Config> >
+    EntryMultiAtomic< types::HistT<Config> >::handle() {
+      auto hist = _context.mem->at< Type >( 0 ) ;
+      return Handle< Type >(
+        _context.mem,
+        hist,
+        hist,
+        Flags::Book::MultiAtomic,
+        []() {} ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
     template < typename Config >
     template < typename... Args_t, int d >
     std::enable_if_t< d == 1, std::shared_ptr<details::Entry> >
@@ -446,6 +478,52 @@ namespace marlinmt {
         *_data.axis(2) ) ;
     }
 
+    //--------------------------------------------------------------------------
+
+    template < typename Config >
+    template < typename... Args_t, int d >
+    std::enable_if_t< d == 1, std::shared_ptr<details::Entry> >
+    EntryData<types::HistT<Config>, Flags::value(Flags::Book::MultiAtomic)>
+      ::book( BookStore &store, const Args_t &... args ) const {
+      return store.bookMultiAtomic< Object_t,
+                                    const std::string_view &,
+                                    const typename types::HistT<Config>::AxisConfig_t & >(
+        args..., _data.title(), *_data.axis(0) ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template < typename Config >
+    template < typename... Args_t, int d >
+    std::enable_if_t< d == 2, std::shared_ptr<details::Entry> >
+    EntryData<types::HistT<Config>, Flags::value(Flags::Book::MultiAtomic)>
+      ::book( BookStore &store, const Args_t &... args ) const {
+      return store.bookMultiAtomic< Object_t,
+                                    const std::string_view &,
+                                    const typename types::HistT<Config>::AxisConfig_t &,
+                                    const typename types::HistT<Config>::AxisConfig_t & >(
+        args..., _data.title(), *_data.axis(0), *_data.axis(1) ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template < typename Config >
+    template < typename... Args_t, int d >
+    std::enable_if_t< d == 3, std::shared_ptr<details::Entry> >
+    EntryData<types::HistT<Config>, Flags::value(Flags::Book::MultiAtomic)>
+      ::book( BookStore &store, const Args_t &... args ) const {
+      return store.bookMultiAtomic< Object_t,
+                                    const std::string_view &,
+                                    const typename types::HistT<Config>::AxisConfig_t &,
+                                    const typename types::HistT<Config>::AxisConfig_t &,
+                                    const typename types::HistT<Config>::AxisConfig_t & >(
+        args...,
+        _data.title(),
+        *_data.axis(0),
+        *_data.axis(1),
+        *_data.axis(2) ) ;
+    }
+
     //--------------------------------------------------------------------------
     
     template < typename Config >
@@ -556,5 +634,30 @@ namespace marlinmt {
           pFirst, pLast, wFirst, wLast);
     }
 
+    //--------------------------------------------------------------------------
+
+    template < typename Config >
+    inline void EntryMultiAtomic<types::HistT<Config>>::fill(
+      const std::shared_ptr<void>& data,
+      const typename types::HistT<Config>::Point_t& x,
+      const typename types::HistT<Config>::Weight_t& w
+    ) {
+      static_cast<Type*>(data.get())->FillAtomic(x,w);
+    }
+
+    //--------------------------------------------------------------------------
+
+    template < typename Config >
+    inline void EntryMultiAtomic<types::HistT<Config>>::fillN(
+      const std::shared_ptr<void>& data,
+      const typename types::HistT<Config>::Point_t* pFirst,
+      const typename types::HistT<Config>::Point_t* pLast,
+      const typename types::HistT<Config>::Weight_t* wFirst,
+      const typename types::HistT<Config>::Weight_t* wLast
+    ) {
+      static_cast<Type*>(data.get())->FillNAtomic(
+          pFirst, pLast, wFirst, wLast);
+    }
+
   } // end namespace book
 } // end namespace marlinmt
@@ -271,5 +271,52 @@ namespace marlinmt {
       /// lock _fillers when extend memory 
       std::mutex _fillersExtend {};
     } ;
+
+    /// specialisation of EntryMultiAtomic for Histograms
+    template < typename Config>
+    class EntryMultiAtomic< types::HistT<Config>> : public EntryBase {
+
+      friend BookStore ;
+      friend Handle<types::HistT<Config>> ;
+
+    public:
+      /// Type of contained Histogram.
+      using Type = types::HistT<Config> ;
+      /// Point type for Hist
+      using Point_t = typename Type::Point_t ;
+      /// Weight type for Hist
+      using Weight_t = typename Type::Weight_t ;
+
+      /// Type Flag. Inherited from default EntryMultiAtomic.
+      static constexpr Flag_t Flag = EntryMultiAtomic<void>::Flag;
+
+    private:
+      /// add one entry with atomic bin updates.
+      static void fill(const std::shared_ptr<void>& data,
+          Point_t const& x,
+          Weight_t const& w);
+
+      /// add N entries with atomic bin updates.
+      static void fillN(const std::shared_ptr<void>& data,
+          Point_t const* pFirst, Point_t const* pLast,
+          Weight_t const* wFirst, Weight_t const* wLast);
+
+    public:
+      /// constructor. Prepare the histogram for atomic filling.
+      explicit EntryMultiAtomic( Context context ) ;
+
+      /// default constructor. Constructs invalid Entry.
+      EntryMultiAtomic() = default ;
+
+      /**
+       *  @brief creates a new Handle.
+       *  @note handles share the histogram, without buffer: nothing to merge.
+       */
+      Handle< Type > handle() ;
+
+    private:
+      /// \see {EntrySingle::_context}
+      Context _context ;
+    } ;
   } // end namespace book
 } // end namespace marlinmt
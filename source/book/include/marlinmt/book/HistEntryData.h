@@ -218,5 +218,46 @@ namespace marlinmt {
       const std::size_t _n;
     } ;
 
+    /**
+     *  @brief  EntryData for objects in MultiAtomic mode
+     */
+    template < typename Config>
+    class EntryData< types::HistT<Config>, Flags::value( Flags::Book::MultiAtomic ) > {
+      using Object_t = types::HistT<Config>;
+      friend EntryDataBase< Object_t > ;
+      friend BookStore ;
+      static constexpr int D = Object_t::Dimension;
+
+      explicit EntryData(
+        const EntryDataBase< Object_t > &data )
+        : _data{data} {}
+
+      /**
+       *  @brief book Histogram in MultiAtomic Mode. Only available for 1D Hist.
+       *  @param store to where book Histogram.
+       */
+      template < typename... Args_t, int d = D >
+      std::enable_if_t< d == 1, std::shared_ptr< details::Entry > >
+      book( BookStore &store, const Args_t &... args ) const ;
+
+      /**
+       *  @brief book Histogram in MultiAtomic Mode. Only available for 2D Hist.
+       *  @param store to where book Histogram.
+       */
+      template < typename... Args_t, int d = D >
+      std::enable_if_t< d == 2, std::shared_ptr< details::Entry > >
+      book( BookStore &store, const Args_t &... args ) const ;
+
+      /**
+       *  @brief book Histogram in MultiAtomic Mode. Only available for 3D Hist.
+       *  @param store to where book Histogram.
+       */
+      template < typename... Args_t, int d = D >
+      std::enable_if_t< d == 3, std::shared_ptr< details::Entry > >
+      book( BookStore &store, const Args_t &... args ) const ;
+
+      const EntryDataBase< Object_t > &_data ;
+    } ;
+
   } // end namespace book
 } // end namespace marlinmt
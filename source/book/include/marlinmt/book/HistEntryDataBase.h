@@ -46,6 +46,14 @@ namespace marlinmt {
       [[nodiscard]] EntryData< Type, Flags::value( Flags::Book::MultiShared ) >
       multiShared( std::size_t n = 0) const ;
 
+      /**
+       *  @brief construct EntryData for multi atomic booking.
+       *  The bins are updated atomically only if the histogram config
+       *  supports it (see types::AtomicBins), else the fills are locked.
+       */
+      [[nodiscard]] EntryData< Type, Flags::value( Flags::Book::MultiAtomic ) >
+      multiAtomic() const ;
+
     protected:
 
       /**
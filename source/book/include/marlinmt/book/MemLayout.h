@@ -59,6 +59,8 @@ namespace marlinmt {
 
     /**
      *  @brief MemLayout for mutable object instances.
+     *  Instances are constructed on first access, so that each one is
+     *  allocated by the thread using it (first touch on its memory node).
      *  @tparam T stored Object Type
      *  @tparam MERGE function(to, from) which merge to instances of Object
      */
@@ -79,11 +81,7 @@ namespace marlinmt {
         : _objects{num_instances, nullptr},
           _ctor_p{
             std::make_unique< typename decltype( _ctor_p )::element_type >(
-              args... )} {
-        for ( std::shared_ptr< T > &pObj : _objects ) {
-          pObj = std::make_shared< T >( args... ) ;
-        }
-      }
+              args... )} {}
 
       SharedMemLayout( const SharedMemLayout & )                = default ;
       SharedMemLayout &operator=( const SharedMemLayout & )     = default ;
@@ -93,23 +91,27 @@ namespace marlinmt {
 
     private:
       /// Get Resource for Instance. Lazy operation.
+      /// @attention one instance must be accessed by one thread only
       [[nodiscard]] std::shared_ptr< void >
       impAt( std::size_t idx ) const override final {
-        return _objects[idx] ;
+        std::shared_ptr< T > &pObj = _objects.at( idx ) ;
+        if ( !pObj ) {
+          pObj = std::make_shared< T >( std::make_from_tuple< T >( *_ctor_p ) ) ;
+        }
+        return pObj ;
       }
 
       [[nodiscard]] std::shared_ptr< void > impMerged() override final {
         _mergedObj
           = std::make_shared< T >( std::make_from_tuple< T >( *_ctor_p ) ) ;
-        for ( std::shared_ptr< T > &pObj : _objects ) {
-          if ( pObj ) {
-            ( *MERGE )( _mergedObj, pObj ) ;
-          }
+        // instances never accessed are merged in their initial state
+        for ( std::size_t idx = 0 ; idx < _objects.size() ; ++idx ) {
+          ( *MERGE )( _mergedObj, std::static_pointer_cast< T >( impAt( idx ) ) ) ;
         }
         return _mergedObj ;
       }
 
-      std::vector< std::shared_ptr< T > >
+      mutable std::vector< std::shared_ptr< T > >
                            _objects; 
       std::shared_ptr< T > _mergedObj{nullptr} ;
       std::unique_ptr<
@@ -0,0 +1,508 @@
+#pragma once
+
+// -- std includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// -- MarlinBook includes
+#include "marlinmt/book/Types.h"
+
+namespace marlinmt {
+  namespace book {
+    namespace native {
+
+      /**
+       *  @brief compute the bins of coordinates on a regular axis.
+       *  Bin 0 is the underflow, nbins + 1 the overflow. NaN goes to the underflow.
+       *  Vectorised with AVX2 (runtime dispatch) or NEON when available.
+       *  @param x first coordinate
+       *  @param n number of coordinates
+       *  @param min lower axis limit
+       *  @param scale bins per unit: nbins / (max - min)
+       *  @param nbins number of bins, without underflow and overflow
+       *  @param bins output of size n
+       */
+      void regularBins(
+        const double *x, std::size_t n,
+        double min, double scale, double nbins,
+        std::int32_t *bins);
+
+      /// check if the AVX2 or NEON path of regularBins is used.
+      [[nodiscard]]
+      bool simdBinning();
+
+      /**
+       *  @brief add value to target with a relaxed atomic operation.
+       *  Integers use fetch_add, floating points a compare and swap loop.
+       */
+      template<typename T>
+      void atomicAdd(T& target, T value) {
+#if defined(__cpp_lib_atomic_ref)
+        std::atomic_ref<T> ref(target);
+        if constexpr (std::is_integral_v<T>) {
+          ref.fetch_add(value, std::memory_order_relaxed);
+        } else {
+          T expected = ref.load(std::memory_order_relaxed);
+          while(!ref.compare_exchange_weak(expected, expected + value,
+                std::memory_order_relaxed)) {}
+        }
+#else
+        if constexpr (std::is_integral_v<T>) {
+          __atomic_fetch_add(&target, value, __ATOMIC_RELAXED);
+        } else {
+          T expected{};
+          __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+          T desired{};
+          do {
+            desired = expected + value;
+          } while(!__atomic_compare_exchange(&target, &expected, &desired,
+                true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+        }
+#endif
+      }
+
+      /**
+       *  @brief histogram axis, with regular or irregular bins.
+       */
+      template<typename Precision_t>
+      class Axis {
+      public:
+        Axis() = default;
+
+        /// create from the book axis description.
+        explicit Axis(const types::AxisConfig<Precision_t>& config)
+          : _title(config.title()),
+            _bins{config.bins()},
+            _min{static_cast<double>(config.min())},
+            _max{static_cast<double>(config.max())} {
+          if(_bins == 0
+            || _bins > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max() - 2)) {
+            MARLIN_BOOK_THROW("invalid number of bins for axis: " + _title);
+          }
+          if(!config.isRegular()) {
+            const auto& borders = config.iregularBorder();
+            _borders.assign(borders.begin(), borders.end());
+            if(!std::is_sorted(_borders.begin(), _borders.end())) {
+              MARLIN_BOOK_THROW("unsorted bin borders for axis: " + _title);
+            }
+          } else if(!(_max > _min)) {
+            MARLIN_BOOK_THROW("invalid range for axis: " + _title);
+          }
+          _scale = static_cast<double>(_bins) / (_max - _min);
+        }
+
+        /// get axis title.
+        [[nodiscard]]
+        const std::string& title() const { return _title; }
+
+        /// get number of bins, without underflow and overflow.
+        [[nodiscard]]
+        std::size_t bins() const { return _bins; }
+
+        /// get number of bins, with underflow and overflow.
+        [[nodiscard]]
+        std::size_t size() const { return _bins + 2; }
+
+        /// get lower bound.
+        [[nodiscard]]
+        double min() const { return _min; }
+
+        /// get upper bound.
+        [[nodiscard]]
+        double max() const { return _max; }
+
+        /// check if bins are equal sized.
+        [[nodiscard]]
+        bool isRegular() const { return _borders.empty(); }
+
+        /// get bin borders of an irregular axis, empty for regular axis.
+        [[nodiscard]]
+        const std::vector<double>& borders() const { return _borders; }
+
+        /// check if both axes have the same binning.
+        [[nodiscard]]
+        bool sameBinning(const Axis& other) const {
+          return _bins == other._bins && _min == other._min
+            && _max == other._max && _borders == other._borders;
+        }
+
+        /**
+         *  @brief get bin of a coordinate.
+         *  Regular axis: branchless, clamped to underflow/overflow.
+         *  @return 0 for underflow, bins() + 1 for overflow
+         */
+        [[nodiscard]]
+        std::size_t bin(Precision_t x) const {
+          if(!isRegular()) {
+            return irregularBin(static_cast<double>(x));
+          }
+          const double t = (static_cast<double>(x) - _min) * _scale;
+          // operands order: NaN ends in underflow
+          const double c = std::min(static_cast<double>(_bins), std::max(-1., t));
+          return static_cast<std::size_t>(c + 1.);
+        }
+
+        /// get bins of n coordinates. \see regularBins
+        void bins(const Precision_t *x, std::size_t n, std::int32_t *out) const {
+          if constexpr (std::is_same_v<Precision_t, double>) {
+            if(isRegular()) {
+              regularBins(x, n, _min, _scale, static_cast<double>(_bins), out);
+              return;
+            }
+          }
+          for(std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::int32_t>(bin(x[i]));
+          }
+        }
+
+      private:
+        std::size_t irregularBin(double x) const {
+          if(x != x) {
+            return 0;
+          }
+          return static_cast<std::size_t>(
+            std::upper_bound(_borders.begin(), _borders.end(), x) - _borders.begin());
+        }
+
+        std::string _title{};
+        std::size_t _bins{0};
+        double _min{0};
+        double _max{0};
+        double _scale{0};
+        std::vector<double> _borders{};
+      };
+
+      /**
+       *  @brief ROOT free histogram.
+       *  Bins are stored contiguously, including underflow and overflow,
+       *  the first axis running fastest (same global bin numbering as ROOT 6).
+       *  The sum of squared weights is only stored after the first non-unit weight.
+       */
+      template<typename W, std::size_t Dim, typename P = double>
+      class Hist {
+      public:
+        /// type used for bin weight
+        using Weight_t = W;
+        /// type used for bin borders
+        using Precision_t = P;
+        /// type used for Entry Points
+        using Point_t = std::array<Precision_t, Dim>;
+        /// dimension of the histogram
+        static constexpr std::size_t Dimension = Dim;
+        /// axis type
+        using Axis_t = Axis<Precision_t>;
+        /// points handled at once by FillN
+        static constexpr std::size_t BlockSize = 256;
+
+        Hist() = default;
+
+        /// create histogram with given axes.
+        Hist(const std::string_view& title, const std::array<Axis_t, Dim>& axes)
+          : _title(title),
+            _axes(axes) {
+          std::size_t size = 1;
+          for(std::size_t d = 0; d < Dim; ++d) {
+            _strides[d] = size;
+            size *= _axes[d].size();
+          }
+          _content.assign(size, Weight_t{0});
+        }
+
+        /// get histogram title.
+        [[nodiscard]]
+        const std::string& title() const { return _title; }
+
+        /// get axis of dimension d.
+        [[nodiscard]]
+        const Axis_t& axis(std::size_t d) const { return _axes[d]; }
+
+        /// get number of global bins, including underflow and overflow.
+        [[nodiscard]]
+        std::size_t size() const { return _content.size(); }
+
+        /// get number of filled points.
+        [[nodiscard]]
+        std::size_t entries() const { return _entries; }
+
+        /// get global bin of a point.
+        [[nodiscard]]
+        std::size_t bin(const Point_t& p) const {
+          std::size_t global = 0;
+          for(std::size_t d = 0; d < Dim; ++d) {
+            global += _axes[d].bin(p[d]) * _strides[d];
+          }
+          return global;
+        }
+
+        /// get global bin from the bin of each axis.
+        [[nodiscard]]
+        std::size_t bin(const std::array<std::size_t, Dim>& bins) const {
+          std::size_t global = 0;
+          for(std::size_t d = 0; d < Dim; ++d) {
+            global += bins[d] * _strides[d];
+          }
+          return global;
+        }
+
+        /// get content of a global bin.
+        [[nodiscard]]
+        Weight_t binContent(std::size_t global) const { return _content[global]; }
+
+        /// get sum of squared weights of a global bin.
+        [[nodiscard]]
+        double binSumw2(std::size_t global) const {
+          return hasSumw2() ? _sumw2[global] : static_cast<double>(_content[global]);
+        }
+
+        /// get all bin contents.
+        [[nodiscard]]
+        const std::vector<Weight_t>& content() const { return _content; }
+
+        /// check if sum of squared weights is stored.
+        [[nodiscard]]
+        bool hasSumw2() const { return !_sumw2.empty(); }
+
+        /// store sum of squared weights, the unit weights filled before are kept.
+        void enableSumw2() {
+          if(hasSumw2()) {
+            return;
+          }
+          _sumw2.resize(_content.size());
+          std::transform(_content.begin(), _content.end(), _sumw2.begin(),
+            [](Weight_t w) { return static_cast<double>(w); });
+        }
+
+        /// add one weighted point.
+        void fill(const Point_t& p, Weight_t w) {
+          const std::size_t global = bin(p);
+          if(w != Weight_t{1} && !hasSumw2()) {
+            enableSumw2();
+          }
+          _content[global] += w;
+          if(hasSumw2()) {
+            _sumw2[global] += static_cast<double>(w) * static_cast<double>(w);
+          }
+          ++_entries;
+        }
+
+        /**
+         *  @brief add n points.
+         *  The bins are computed for a block of points at once, axis by axis,
+         *  before accumulating the block.
+         *  @param weights weight of each point, nullptr for unit weights
+         */
+        void fillN(const Point_t *points, const Weight_t *weights, std::size_t n) {
+          if(weights != nullptr && !hasSumw2()
+            && std::any_of(weights, weights + n, [](Weight_t w){ return w != Weight_t{1}; })) {
+            enableSumw2();
+          }
+          std::array<std::size_t, BlockSize> global{};
+          for(std::size_t start = 0; start < n; start += BlockSize) {
+            const std::size_t m = std::min(BlockSize, n - start);
+            blockBins(points + start, m, global.data());
+            accumulate(global.data(), weights == nullptr ? nullptr : weights + start, m);
+          }
+          _entries += n;
+        }
+
+        /**
+         *  @brief store sum of squared weights and prepare the concurrent
+         *  filling with fillAtomic.
+         *  @note the storage can't grow during a concurrent fill.
+         */
+        void prepareAtomic() { enableSumw2(); }
+
+        /**
+         *  @brief add one weighted point with atomic bin updates.
+         *  Can be called concurrently with other atomic fills,
+         *  after prepareAtomic.
+         */
+        void fillAtomic(const Point_t& p, Weight_t w) {
+          const std::size_t global = bin(p);
+          atomicAdd(_content[global], w);
+          if(hasSumw2()) {
+            atomicAdd(_sumw2[global], static_cast<double>(w) * static_cast<double>(w));
+          }
+          atomicAdd(_entries, std::size_t{1});
+        }
+
+        /**
+         *  @brief add n weighted points with atomic bin updates.
+         *  \see fillN, fillAtomic
+         */
+        void fillNAtomic(const Point_t *points, const Weight_t *weights, std::size_t n) {
+          std::array<std::size_t, BlockSize> global{};
+          for(std::size_t start = 0; start < n; start += BlockSize) {
+            const std::size_t m = std::min(BlockSize, n - start);
+            blockBins(points + start, m, global.data());
+            for(std::size_t i = 0; i < m; ++i) {
+              const Weight_t w = weights[start + i];
+              atomicAdd(_content[global[i]], w);
+              if(hasSumw2()) {
+                atomicAdd(_sumw2[global[i]], static_cast<double>(w) * static_cast<double>(w));
+              }
+            }
+          }
+          atomicAdd(_entries, n);
+        }
+
+        /// check if both histograms have the same binning.
+        [[nodiscard]]
+        bool sameBinning(const Hist& other) const {
+          for(std::size_t d = 0; d < Dim; ++d) {
+            if(!_axes[d].sameBinning(other._axes[d])) {
+              return false;
+            }
+          }
+          return true;
+        }
+
+        /// add bin contents of other histogram.
+        void add(const Hist& other) {
+          if(!sameBinning(other)) {
+            MARLIN_BOOK_THROW("can't add histograms with different binning: " + _title);
+          }
+          if(other.hasSumw2() && !hasSumw2()) {
+            enableSumw2();
+          }
+          if(hasSumw2()) {
+            for(std::size_t i = 0; i < _sumw2.size(); ++i) {
+              _sumw2[i] += other.binSumw2(i);
+            }
+          }
+          for(std::size_t i = 0; i < _content.size(); ++i) {
+            _content[i] += other._content[i];
+          }
+          _entries += other._entries;
+        }
+
+      private:
+        /// compute global bins of m points, axis by axis.
+        void blockBins(const Point_t *block, std::size_t m, std::size_t *global) const {
+          std::array<std::int32_t, BlockSize> bins{};
+          std::array<Precision_t, BlockSize> coords{};
+          for(std::size_t d = 0; d < Dim; ++d) {
+            for(std::size_t i = 0; i < m; ++i) {
+              coords[i] = block[i][d];
+            }
+            _axes[d].bins(coords.data(), m, bins.data());
+            if(d == 0) {
+              for(std::size_t i = 0; i < m; ++i) {
+                global[i] = static_cast<std::size_t>(bins[i]);
+              }
+            } else {
+              for(std::size_t i = 0; i < m; ++i) {
+                global[i] += static_cast<std::size_t>(bins[i]) * _strides[d];
+              }
+            }
+          }
+        }
+
+        void accumulate(const std::size_t *global, const Weight_t *weights, std::size_t m) {
+          if(weights == nullptr) {
+            for(std::size_t i = 0; i < m; ++i) {
+              _content[global[i]] += Weight_t{1};
+            }
+            if(hasSumw2()) {
+              for(std::size_t i = 0; i < m; ++i) {
+                _sumw2[global[i]] += 1.;
+              }
+            }
+            return;
+          }
+          for(std::size_t i = 0; i < m; ++i) {
+            _content[global[i]] += weights[i];
+          }
+          if(hasSumw2()) {
+            for(std::size_t i = 0; i < m; ++i) {
+              const auto w = static_cast<double>(weights[i]);
+              _sumw2[global[i]] += w * w;
+            }
+          }
+        }
+
+        std::string _title{};
+        std::array<Axis_t, Dim> _axes{};
+        std::array<std::size_t, Dim> _strides{};
+        std::vector<Weight_t> _content{};
+        std::vector<double> _sumw2{};
+        std::size_t _entries{0};
+      };
+
+      /**
+       *  @brief shares one histogram between ConcurrentFiller.
+       */
+      template<typename Hist_t>
+      class ConcurrentFillManager {
+      public:
+        explicit ConcurrentFillManager(Hist_t& hist) : _hist{&hist} {}
+
+        /// add buffered points to the histogram.
+        void fillN(
+          const typename Hist_t::Point_t *points,
+          const typename Hist_t::Weight_t *weights,
+          std::size_t n) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _hist->fillN(points, weights, n);
+        }
+
+      private:
+        Hist_t *_hist;
+        std::mutex _mutex{};
+      };
+
+      /**
+       *  @brief buffers points of one thread, and fill them at once
+       *  in the shared histogram.
+       */
+      template<typename Hist_t, std::size_t BufferSize>
+      class ConcurrentFiller {
+      public:
+        using Point_t = typename Hist_t::Point_t;
+        using Weight_t = typename Hist_t::Weight_t;
+
+        explicit ConcurrentFiller(ConcurrentFillManager<Hist_t>& manager)
+          : _manager{&manager} {
+          _points.reserve(BufferSize);
+          _weights.reserve(BufferSize);
+        }
+        ConcurrentFiller(const ConcurrentFiller&) = delete;
+        ConcurrentFiller& operator=(const ConcurrentFiller&) = delete;
+        ~ConcurrentFiller() { flush(); }
+
+        /// buffer one weighted point.
+        void fill(const Point_t& p, Weight_t w) {
+          _points.push_back(p);
+          _weights.push_back(w);
+          if(_points.size() >= BufferSize) {
+            flush();
+          }
+        }
+
+        /// fill buffered points in the histogram.
+        void flush() {
+          if(_points.empty()) {
+            return;
+          }
+          _manager->fillN(_points.data(), _weights.data(), _points.size());
+          _points.clear();
+          _weights.clear();
+        }
+
+      private:
+        ConcurrentFillManager<Hist_t> *_manager;
+        std::vector<Point_t> _points{};
+        std::vector<Weight_t> _weights{};
+      };
+
+    } // end namespace native
+  } // end namespace book
+} // end namespace marlinmt
@@ -0,0 +1,47 @@
+#pragma once
+
+// -- std includes
+#include <cstddef>
+
+namespace marlinmt {
+  namespace book {
+
+    /**
+     *  @brief Dense index of the calling thread.
+     *  Used to select the object instance of multi copy entries.
+     *  A thread gets the lowest free slot on its first call to current()
+     *  and gives it back when it exits. The slot is then cached in a
+     *  thread_local, so that later calls take no lock.
+     */
+    class ThreadSlot {
+    public:
+      /// value of a slot not assigned yet
+      static constexpr std::size_t Unassigned = static_cast< std::size_t >( -1 ) ;
+
+      ThreadSlot() = delete ;
+
+      /**
+       *  @brief get the slot of the calling thread. Assigned on first call.
+       */
+      [[nodiscard]] static std::size_t current() {
+        if ( _slot == Unassigned ) {
+          _slot = acquire() ;
+        }
+        return _slot ;
+      }
+
+      /**
+       *  @brief number of slots currently assigned to running threads.
+       */
+      [[nodiscard]] static std::size_t assigned() ;
+
+    private:
+      /// take the lowest free slot, given back on thread exit
+      static std::size_t acquire() ;
+
+      /// slot of the calling thread
+      inline static thread_local std::size_t _slot{Unassigned} ;
+    } ;
+
+  } // end namespace book
+} // end namespace marlinmt
@@ -2,6 +2,7 @@
 
 // -- std includes
 #include <array>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -62,10 +63,10 @@ namespace marlinmt {
                     Itr begin, Itr end) 
 
           : _title(title),
-            _bins{(end - begin) - 1},
-            _iregularBorder(begin, end),
-            _min{_iregularBorder.front()},
-            _max{_iregularBorder.back()}
+            _bins{static_cast<std::size_t>((end - begin) - 1)},
+            _iregularBorder(std::in_place, begin, end),
+            _min{_iregularBorder->front()},
+            _max{_iregularBorder->back()}
         {}
 
         /**
@@ -78,7 +79,7 @@ namespace marlinmt {
          */
         template<typename Itr>
         explicit AxisConfig( Itr begin, Itr end ) 
-          : AxisConfig<Itr>( "", begin, end ){}
+          : AxisConfig( "", begin, end ){}
 
         /**
          *  @brief Axis with irregular borders.
@@ -117,14 +118,16 @@ namespace marlinmt {
          *  @return vector of irregular borers, or empty vector if bins equal sized. 
          */
         const std::vector<Precision_t>& iregularBorder() const {
-          return _iregularBorder.value_or(std::vector<Precision_t>{});
+          static const std::vector<Precision_t> regular{};
+          return _iregularBorder.has_value() ? *_iregularBorder : regular;
         }
       private:
         std::string _title;
         std::size_t _bins;
+        // before _min and _max: used to initialise them for irregular axis
+        std::optional<std::vector<Precision_t>> _iregularBorder{std::nullopt};
         Precision_t _min;
         Precision_t _max;
-        std::optional<std::vector<Precision_t>> _iregularBorder{std::nullopt};
       };
 
 
@@ -160,6 +163,13 @@ namespace marlinmt {
           const std::shared_ptr<HistT<Config>>& to,
           const std::shared_ptr<HistT<Config>>& from);
 
+      /**
+       *  @brief prepare histogram to be filled concurrently with
+       *  HistT::FillAtomic. Called once before any fill.
+       */
+      template<typename Config>
+      void prepareAtomic(HistT<Config>& hist);
+
       template<typename>
       class HistConcurrentFiller;
 
@@ -176,6 +186,7 @@ namespace marlinmt {
         const typename Config::Impl_t& impl() const { return _impl; }
         friend HistT<Config>& add<Config>(HistT<Config>&,const HistT<Config>&);
         friend void add<Config>(const std::shared_ptr<HistT<Config>>&,const std::shared_ptr<HistT<Config>>&);
+        friend void prepareAtomic<Config>(HistT<Config>&);
         friend class HistConcurrentFillManager<Config>;
 
       public:
@@ -255,6 +266,19 @@ namespace marlinmt {
          */
         void FillN(const Point_t *first, const Point_t *last);
 
+        /**
+         *  @brief add one weighted point to histogram, with atomic bin updates.
+         *  Can be called concurrently, after prepareAtomic.
+         */
+        void FillAtomic(const Point_t& point, const Weight_t& weight);
+
+        /**
+         *  @brief add multiple weighted points to histogram, with atomic bin updates.
+         *  \see FillN, FillAtomic
+         */
+        void FillNAtomic(const Point_t *pFirst, const Point_t *pLast,
+                  const Weight_t *wFirst, const Weight_t *wLast);
+
         /**
          *  @brief get read access to actual implementation. 
          */
@@ -9,6 +9,9 @@
 namespace marlinmt {
   namespace book {
     namespace types {
+
+      /// Whether the MultiAtomic fills update the bins with atomic operations
+      constexpr bool AtomicBins = false ;
       
       template<typename Config>
       HistT<Config>& add(HistT<Config>& to, const HistT<Config>& from) {
@@ -48,6 +51,16 @@ namespace marlinmt {
       template< typename Config >
       void HistT<Config>::FillN(const Point_t *first, const Point_t *last){}
 
+      template< typename Config >
+      void HistT<Config>::FillAtomic(const Point_t& p, const Weight_t& w){}
+
+      template< typename Config >
+      void HistT<Config>::FillNAtomic(const Point_t *pFirst, const Point_t *pLast,
+                const Weight_t *wFirst, const Weight_t *wLast){}
+
+      template<typename Config>
+      void prepareAtomic(HistT<Config>& hist) {}
+
       template< typename Config >
       HistConcurrentFillManager<Config>::HistConcurrentFillManager(HistT<Config>& hist) {}
 
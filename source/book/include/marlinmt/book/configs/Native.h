@@ -0,0 +1,333 @@
+#ifndef MARLINMT_BOOK_CONFIG
+#define MARLINMT_BOOK_CONFIG
+#else
+#error No mutiple binding of MarlinConfig.
+#endif
+
+#include "marlinmt/book/configs/Base.h"
+
+// -- std includes
+#include <algorithm>
+#include <cmath>
+
+// -- native histogram include
+#include "marlinmt/book/NativeHist.h"
+
+// -- ROOT includes, only to write histograms
+#if defined(MARLINMT_BOOK_NATIVE_ROOT)
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#endif
+
+namespace marlinmt {
+  namespace book {
+    namespace types {
+
+#ifndef MARLIN_HIST_FILLER_BUFFER_SIZE
+# define MARLIN_HIST_FILLER_BUFFER_SIZE 1024
+#endif
+      /**
+       *  @brief Buffer size for Histograms used in Shared mode.
+       *  - larger →  less synchronisation points
+       *  - larger →  more memory consumption.
+       *  @note can set with the CMAKE  Variable \cod
+       * {MARLIN_HIST_FILLER_BUFFER_SIZE}
+       */
+      constexpr std::size_t HistogramFillerBufferSize
+        = MARLIN_HIST_FILLER_BUFFER_SIZE ;
+
+      /**
+       *  @brief Whether the MultiAtomic fills update the bins with atomic
+       *  operations. True: the native bins are filled lock-free.
+       */
+      constexpr bool AtomicBins = true ;
+
+#define HistConfig_Native(Alias, Weight, Dim) \
+      template<>\
+      struct HistConfig<double, Weight, Dim> {\
+        using Weight_t = Weight;\
+        using Precision_t = double;\
+        using Impl_t = native::Hist<Weight, Dim>;\
+        using ConcurrentFiller_t \
+          = native::ConcurrentFiller<Impl_t, HistogramFillerBufferSize>;\
+        using ConcurrentManager_t \
+          = native::ConcurrentFillManager<Impl_t>;\
+        static constexpr std::size_t Dimension = static_cast<std::size_t>(Dim);\
+      };\
+      using Alias = HistT<HistConfig<double, Weight, (Dim)>>
+
+      HistConfig_Native(H1F, float, 1);
+      HistConfig_Native(H1D, double, 1);
+      HistConfig_Native(H1I, int, 1);
+      HistConfig_Native(H2F, float, 2);
+      HistConfig_Native(H2D, double, 2);
+      HistConfig_Native(H2I, int, 2);
+      HistConfig_Native(H3F, float, 3);
+      HistConfig_Native(H3D, double, 3);
+      HistConfig_Native(H3I, int, 3);
+
+
+      template<typename Config>
+      HistT<Config>::HistT(
+          const std::string_view& title,
+          const AxisConfig<typename Config::Precision_t>& axis)
+        : _impl(title, {typename Config::Impl_t::Axis_t(axis)})
+      {
+        static_assert(Dimension == 1);
+      }
+
+      template<typename Config>
+      HistT<Config>::HistT(
+          const std::string_view& title,
+          const AxisConfig<typename Config::Precision_t>& axisA,
+          const AxisConfig<typename Config::Precision_t>& axisB)
+        : _impl(
+            title,
+            {typename Config::Impl_t::Axis_t(axisA),
+             typename Config::Impl_t::Axis_t(axisB)})
+      {
+        static_assert(Dimension == 2);
+      }
+
+      template<typename Config>
+      HistT<Config>::HistT(
+          const std::string_view& title,
+          const AxisConfig<typename Config::Precision_t>& axisA,
+          const AxisConfig<typename Config::Precision_t>& axisB,
+          const AxisConfig<typename Config::Precision_t>& axisC)
+        : _impl(
+            title,
+            {typename Config::Impl_t::Axis_t(axisA),
+             typename Config::Impl_t::Axis_t(axisB),
+             typename Config::Impl_t::Axis_t(axisC)})
+      {
+        static_assert(Dimension == 3);
+      }
+
+      template<typename Config>
+      void HistT<Config>::Fill(
+          const typename HistT<Config>::Point_t& p,
+          const typename HistT<Config>::Weight_t& w) {
+        _impl.fill(p, w);
+      }
+
+      template<typename Config>
+      void HistT<Config>::FillN(
+        const typename HistT<Config>::Point_t* pFirst,
+        const typename HistT<Config>::Point_t* pLast,
+        const typename HistT<Config>::Weight_t* wFirst,
+        const typename HistT<Config>::Weight_t* wLast
+        ) {
+        // the points without weight are ignored, as for the per-point loop.
+        const auto n = std::min(pLast - pFirst, wLast - wFirst);
+        if (n <= 0) {
+          return;
+        }
+        _impl.fillN(pFirst, wFirst, static_cast<std::size_t>(n));
+      }
+
+      template<typename Config>
+      void HistT<Config>::FillN(
+        const typename HistT<Config>::Point_t* first,
+        const typename HistT<Config>::Point_t* last ) {
+        if (last <= first) {
+          return;
+        }
+        _impl.fillN(first, nullptr, static_cast<std::size_t>(last - first));
+      }
+
+      template<typename Config>
+      void HistT<Config>::FillAtomic(
+          const typename HistT<Config>::Point_t& p,
+          const typename HistT<Config>::Weight_t& w) {
+        _impl.fillAtomic(p, w);
+      }
+
+      template<typename Config>
+      void HistT<Config>::FillNAtomic(
+        const typename HistT<Config>::Point_t* pFirst,
+        const typename HistT<Config>::Point_t* pLast,
+        const typename HistT<Config>::Weight_t* wFirst,
+        const typename HistT<Config>::Weight_t* wLast
+        ) {
+        const auto n = std::min(pLast - pFirst, wLast - wFirst);
+        if (n <= 0) {
+          return;
+        }
+        _impl.fillNAtomic(pFirst, wFirst, static_cast<std::size_t>(n));
+      }
+
+      template<typename Config>
+      void prepareAtomic(HistT<Config>& hist) {
+        hist.impl().prepareAtomic();
+      }
+
+      template<typename Config>
+      HistT<Config>& add(HistT<Config>& to, const HistT<Config>& from) {
+        to.impl().add(from.impl());
+        return to;
+      }
+
+      template<typename Config>
+      void add(
+          const std::shared_ptr<HistT<Config>>& to,
+          const std::shared_ptr<HistT<Config>>& from) {
+        to->impl().add(from->impl());
+      }
+
+      template<typename Config>
+      HistConcurrentFillManager<Config>::HistConcurrentFillManager(
+          HistT<Config>& hist)
+        : _impl(hist.impl()){}
+
+      template<typename Config>
+      HistConcurrentFiller<Config>::HistConcurrentFiller(
+          HistConcurrentFillManager<Config>& manager
+          ) : _impl(manager.impl()){}
+
+      template<typename Config>
+      void HistConcurrentFiller<Config>::Fill(
+          const typename HistT<Config>::Point_t& p,
+          const typename HistT<Config>::Weight_t& w) {
+        _impl.fill(p, w);
+      }
+
+      template<typename Config>
+      void HistConcurrentFiller<Config>::FillN(
+        const typename HistT<Config>::Point_t* pFirst,
+        const typename HistT<Config>::Point_t* pLast,
+        const typename HistT<Config>::Weight_t* wFirst,
+        const typename HistT<Config>::Weight_t* wLast
+        ) {
+        auto p = pFirst;
+        auto w = wFirst;
+        for(;p != pLast && w != wLast; ++p,++w) {
+          _impl.fill(*p, *w);
+        }
+      }
+
+      template<typename Config>
+      void HistConcurrentFiller<Config>::FillN(
+        const typename HistT<Config>::Point_t* first,
+        const typename HistT<Config>::Point_t* last ) {
+        for(auto p = first; p != last; ++p) {
+          _impl.fill(*p, typename Config::Weight_t{1});
+        }
+      }
+
+      template<typename Config>
+      void HistConcurrentFiller<Config>::Flush() {
+        _impl.flush();
+      }
+
+#if defined(MARLINMT_BOOK_NATIVE_ROOT)
+      namespace details {
+
+        /// ROOT 6 histogram type for weight and dimension.
+        template<typename Weight_t, std::size_t Dim>
+        struct Root6Type;
+        template<> struct Root6Type<float, 1> { using type = TH1F; };
+        template<> struct Root6Type<double, 1> { using type = TH1D; };
+        template<> struct Root6Type<int, 1> { using type = TH1I; };
+        template<> struct Root6Type<float, 2> { using type = TH2F; };
+        template<> struct Root6Type<double, 2> { using type = TH2D; };
+        template<> struct Root6Type<int, 2> { using type = TH2I; };
+        template<> struct Root6Type<float, 3> { using type = TH3F; };
+        template<> struct Root6Type<double, 3> { using type = TH3D; };
+        template<> struct Root6Type<int, 3> { using type = TH3I; };
+
+        /// bin borders of an axis, computed for regular axis.
+        template<typename Axis_t>
+        std::vector<double> borders(const Axis_t& axis) {
+          if(!axis.isRegular()) {
+            return axis.borders();
+          }
+          std::vector<double> result(axis.bins() + 1);
+          const double width = (axis.max() - axis.min()) / static_cast<double>(axis.bins());
+          for(std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = axis.min() + width * static_cast<double>(i);
+          }
+          result.back() = axis.max();
+          return result;
+        }
+
+        /// create empty ROOT 6 histogram with same binning.
+        template<typename Root_t, typename Impl_t>
+        Root_t makeRoot6(const char *name, const Impl_t& hist) {
+          constexpr std::size_t Dim = Impl_t::Dimension;
+          const char *title = hist.title().c_str();
+          bool regular = true;
+          for(std::size_t d = 0; d < Dim; ++d) {
+            regular = regular && hist.axis(d).isRegular();
+          }
+          const auto &x = hist.axis(0);
+          if constexpr (Dim == 1) {
+            if(regular) {
+              return Root_t(name, title, static_cast<int>(x.bins()), x.min(), x.max());
+            }
+            return Root_t(name, title, static_cast<int>(x.bins()), borders(x).data());
+          } else if constexpr (Dim == 2) {
+            const auto &y = hist.axis(1);
+            if(regular) {
+              return Root_t(name, title,
+                static_cast<int>(x.bins()), x.min(), x.max(),
+                static_cast<int>(y.bins()), y.min(), y.max());
+            }
+            return Root_t(name, title,
+              static_cast<int>(x.bins()), borders(x).data(),
+              static_cast<int>(y.bins()), borders(y).data());
+          } else {
+            const auto &y = hist.axis(1);
+            const auto &z = hist.axis(2);
+            if(regular) {
+              return Root_t(name, title,
+                static_cast<int>(x.bins()), x.min(), x.max(),
+                static_cast<int>(y.bins()), y.min(), y.max(),
+                static_cast<int>(z.bins()), z.min(), z.max());
+            }
+            return Root_t(name, title,
+              static_cast<int>(x.bins()), borders(x).data(),
+              static_cast<int>(y.bins()), borders(y).data(),
+              static_cast<int>(z.bins()), borders(z).data());
+          }
+        }
+
+      } // end namespace details
+
+      template<typename Config>
+      auto toRoot6(const HistT<Config>& hist, const std::string_view& name) {
+        using Root_t = typename details::Root6Type<
+          typename Config::Weight_t, Config::Dimension>::type;
+        const auto &impl = hist.get();
+        Root_t result = details::makeRoot6<Root_t>(std::string(name).c_str(), impl);
+        // written by the StoreWriter, not owned by the current directory
+        result.SetDirectory(nullptr);
+        TAxis *axes[] = {result.GetXaxis(), result.GetYaxis(), result.GetZaxis()};
+        for(std::size_t d = 0; d < Config::Dimension; ++d) {
+          axes[d]->SetTitle(impl.axis(d).title().c_str());
+        }
+        if(impl.hasSumw2()) {
+          result.Sumw2();
+        }
+        for(std::size_t i = 0; i < impl.size(); ++i) {
+          const auto bin = static_cast<int>(i);
+          result.SetBinContent(bin, static_cast<double>(impl.binContent(i)));
+          if(impl.hasSumw2()) {
+            result.SetBinError(bin, std::sqrt(impl.binSumw2(i)));
+          }
+        }
+        result.ResetStats();
+        result.SetEntries(static_cast<double>(impl.entries()));
+        return result;
+      }
+#else
+      template<typename Config>
+      auto toRoot6(const HistT<Config>& hist, const std::string_view& name) {
+        return nullptr;
+      }
+#endif
+
+    } // end namespace types
+  } // end namespace book
+} // end namespace marlinmt
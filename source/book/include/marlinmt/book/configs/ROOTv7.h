@@ -6,6 +6,12 @@
 
 #include "marlinmt/book/configs/Base.h"
 
+// -- std includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+
 // -- ROOT includes
 #include "RVersion.h"
 
@@ -43,6 +49,15 @@ namespace marlinmt {
       constexpr std::size_t HistogramFillerBufferSize
         = MARLIN_HIST_FILLER_BUFFER_SIZE ;
 
+      /**
+       *  @brief Whether the MultiAtomic fills update the bins with atomic
+       *  operations. False: RHist has no atomic bin update, the MultiAtomic
+       *  fills fall back to a lock (see atomicFillMutex) and serialise all
+       *  the threads filling the same histogram. Prefer MultiCopy or
+       *  MultiShared with this config.
+       */
+      constexpr bool AtomicBins = false ;
+
 #define HistConfig_ROOT(Alias, Impl, Weight, Dim) \
       template<>\
       struct HistConfig<double, Weight, Dim> {\
@@ -141,7 +156,7 @@ namespace marlinmt {
       void HistT<Config>::Fill(
           const typename HistT<Config>::Point_t& p,
           const typename HistT<Config>::Weight_t& w) {
-        _impl.Fill(p);
+        _impl.Fill(p, w);
         static_assert(std::is_same_v<typename Config::Precision_t, double>);
       }
 
@@ -152,12 +167,14 @@ namespace marlinmt {
         const typename HistT<Config>::Weight_t* wFirst,
         const typename HistT<Config>::Weight_t* wLast
         ) {
-        // _impl.FillN({pFirst, pLast}, {wFirst, wLast});
-        auto p = pFirst;
-        auto w = wFirst;
-        for(;p != pLast && w != wLast; ++p,++w) {
-          this->Fill(*p, *w);
+        // one bulk call: ROOT finds the bin of each point and accumulates
+        // without going through the Fill interface for each point.
+        // The points without weight are ignored, as for the per-point loop.
+        const auto n = std::min(pLast - pFirst, wLast - wFirst);
+        if (n <= 0) {
+          return;
         }
+        _impl.FillN({pFirst, pFirst + n}, {wFirst, wFirst + n});
         static_assert(std::is_same_v<typename Config::Precision_t, double>);
       }
 
@@ -169,6 +186,44 @@ namespace marlinmt {
         static_assert(std::is_same_v<typename Config::Precision_t, double>);
       }
 
+      /**
+       *  @brief lock stripe of a histogram for FillAtomic.
+       *  RHist has no atomic bin update: the MultiAtomic layout falls back
+       *  to locking, the atomic fills of one histogram are serialised by one
+       *  of a fixed set of mutexes (see AtomicBins).
+       */
+      inline std::mutex& atomicFillMutex(const void* hist) {
+        static std::array<std::mutex, 64> mutexes{};
+        const auto address = reinterpret_cast<std::uintptr_t>(hist);
+        return mutexes[(address / 64) % mutexes.size()];
+      }
+
+      template<typename Config>
+      void HistT<Config>::FillAtomic(
+          const typename HistT<Config>::Point_t& p,
+          const typename HistT<Config>::Weight_t& w) {
+        std::lock_guard<std::mutex> lock(atomicFillMutex(&_impl));
+        _impl.Fill(p, w);
+      }
+
+      template<typename Config>
+      void HistT<Config>::FillNAtomic(
+        const typename HistT<Config>::Point_t* pFirst,
+        const typename HistT<Config>::Point_t* pLast,
+        const typename HistT<Config>::Weight_t* wFirst,
+        const typename HistT<Config>::Weight_t* wLast
+        ) {
+        const auto n = std::min(pLast - pFirst, wLast - wFirst);
+        if (n <= 0) {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(atomicFillMutex(&_impl));
+        _impl.FillN({pFirst, pFirst + n}, {wFirst, wFirst + n});
+      }
+
+      template<typename Config>
+      void prepareAtomic(HistT<Config>& /*hist*/) {}
+
       template<typename Config>
       HistT<Config>& add(HistT<Config>& to, const HistT<Config>& from) {
         ROOT::Experimental::Add(to.impl(), from.impl());
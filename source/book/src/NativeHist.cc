@@ -0,0 +1,114 @@
+#include "marlinmt/book/NativeHist.h"
+
+// -- std includes
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+# define MARLINMT_BOOK_NATIVE_AVX2 1
+# include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+# define MARLINMT_BOOK_NATIVE_NEON 1
+# include <arm_neon.h>
+#endif
+
+namespace marlinmt {
+  namespace book {
+    namespace native {
+
+      /// scalar version, also used for the tail of the vectorised ones.
+      static void regularBinsScalar(
+        const double *x, std::size_t n,
+        double min, double scale, double nbins,
+        std::int32_t *bins) {
+        for(std::size_t i = 0; i < n; ++i) {
+          const double t = (x[i] - min) * scale;
+          const double c = std::min(nbins, std::max(-1., t));
+          bins[i] = static_cast<std::int32_t>(c + 1.);
+        }
+      }
+
+#if defined(MARLINMT_BOOK_NATIVE_AVX2)
+      __attribute__((target("avx2")))
+      static void regularBinsAVX2(
+        const double *x, std::size_t n,
+        double min, double scale, double nbins,
+        std::int32_t *bins) {
+        const __m256d vmin = _mm256_set1_pd(min);
+        const __m256d vscale = _mm256_set1_pd(scale);
+        const __m256d vlow = _mm256_set1_pd(-1.);
+        const __m256d vhigh = _mm256_set1_pd(nbins);
+        const __m256d vone = _mm256_set1_pd(1.);
+        std::size_t i = 0;
+        for(; i + 4 <= n; i += 4) {
+          __m256d t = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(x + i), vmin), vscale);
+          // returns the second operand for NaN: underflow
+          t = _mm256_max_pd(t, vlow);
+          t = _mm256_min_pd(t, vhigh);
+          t = _mm256_add_pd(t, vone);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(bins + i), _mm256_cvttpd_epi32(t));
+        }
+        regularBinsScalar(x + i, n - i, min, scale, nbins, bins + i);
+      }
+
+      static bool hasAVX2() {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+      }
+#endif
+
+#if defined(MARLINMT_BOOK_NATIVE_NEON)
+      static void regularBinsNEON(
+        const double *x, std::size_t n,
+        double min, double scale, double nbins,
+        std::int32_t *bins) {
+        const float64x2_t vmin = vdupq_n_f64(min);
+        const float64x2_t vscale = vdupq_n_f64(scale);
+        const float64x2_t vlow = vdupq_n_f64(-1.);
+        const float64x2_t vhigh = vdupq_n_f64(nbins);
+        const float64x2_t vone = vdupq_n_f64(1.);
+        std::size_t i = 0;
+        for(; i + 2 <= n; i += 2) {
+          float64x2_t t = vmulq_f64(vsubq_f64(vld1q_f64(x + i), vmin), vscale);
+          // maxnm returns the number for NaN: underflow
+          t = vmaxnmq_f64(t, vlow);
+          t = vminq_f64(t, vhigh);
+          t = vaddq_f64(t, vone);
+          vst1_s32(bins + i, vmovn_s64(vcvtq_s64_f64(t)));
+        }
+        regularBinsScalar(x + i, n - i, min, scale, nbins, bins + i);
+      }
+#endif
+
+      //--------------------------------------------------------------------------
+
+      void regularBins(
+        const double *x, std::size_t n,
+        double min, double scale, double nbins,
+        std::int32_t *bins) {
+#if defined(MARLINMT_BOOK_NATIVE_AVX2)
+        if(hasAVX2()) {
+          regularBinsAVX2(x, n, min, scale, nbins, bins);
+          return;
+        }
+#elif defined(MARLINMT_BOOK_NATIVE_NEON)
+        regularBinsNEON(x, n, min, scale, nbins, bins);
+        return;
+#endif
+        regularBinsScalar(x, n, min, scale, nbins, bins);
+      }
+
+      //--------------------------------------------------------------------------
+
+      bool simdBinning() {
+#if defined(MARLINMT_BOOK_NATIVE_AVX2)
+        return hasAVX2();
+#elif defined(MARLINMT_BOOK_NATIVE_NEON)
+        return true;
+#else
+        return false;
+#endif
+      }
+
+    } // end namespace native
+  } // end namespace book
+} // end namespace marlinmt
@@ -0,0 +1,64 @@
+#include "marlinmt/book/ThreadSlot.h"
+
+// -- std includes
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace marlinmt {
+  namespace book {
+
+    namespace {
+      /// slots in use, shared by all threads
+      struct SlotRegistry {
+        std::mutex        mutex{} ;
+        std::vector<bool> used{} ;
+      } ;
+
+      SlotRegistry &registry() {
+        static SlotRegistry reg{} ;
+        return reg ;
+      }
+
+      /// gives the slot of a thread back on thread exit
+      struct SlotRelease {
+        std::size_t slot{ThreadSlot::Unassigned} ;
+        ~SlotRelease() {
+          auto &reg = registry() ;
+          std::lock_guard lock( reg.mutex ) ;
+          reg.used[slot] = false ;
+        }
+      } ;
+    } // end anonymous namespace
+
+    //--------------------------------------------------------------------------
+
+    std::size_t ThreadSlot::acquire() {
+      auto &reg = registry() ;
+      std::size_t slot = 0 ;
+      {
+        std::lock_guard lock( reg.mutex ) ;
+        auto itr = std::find( reg.used.begin(), reg.used.end(), false ) ;
+        slot = static_cast< std::size_t >( itr - reg.used.begin() ) ;
+        if ( itr == reg.used.end() ) {
+          reg.used.push_back( true ) ;
+        } else {
+          *itr = true ;
+        }
+      }
+      static thread_local SlotRelease release{} ;
+      release.slot = slot ;
+      return slot ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::size_t ThreadSlot::assigned() {
+      auto &reg = registry() ;
+      std::lock_guard lock( reg.mutex ) ;
+      return static_cast< std::size_t >(
+        std::count( reg.used.begin(), reg.used.end(), true ) ) ;
+    }
+
+  } // end namespace book
+} // end namespace marlinmt
@@ -6,7 +6,11 @@
 #include <vector>
 
 // -- MarlinBook includes
+#if defined(MARLINMT_BOOK_NATIVE_ROOT)
+#include "marlinmt/book/configs/Native.h"
+#else
 #include "marlinmt/book/configs/ROOTv7.h"
+#endif
 #include "marlinmt/book/Entry.h"
 #include "marlinmt/book/Handle.h"
 #include "marlinmt/book/Hist.h"
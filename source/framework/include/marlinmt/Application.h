@@ -9,6 +9,9 @@
 #include <marlinmt/BookStoreManager.h>
 #include <marlinmt/Configuration.h>
 #include <marlinmt/CmdLineParser.h>
+#include <marlinmt/EventStorePool.h>
+#include <marlinmt/CompiledConditions.h>
+#include <marlinmt/ProcessorTiming.h>
 
 namespace marlinmt {
 
@@ -17,6 +20,10 @@ namespace marlinmt {
   class RunHeader ;
   class EventStore ;
 
+  namespace concurrency {
+    class ReadAheadBuffer ;
+  }
+
   /**
    *  @brief  Application class
    *  Base application interface for running a Marlin application.
@@ -30,10 +37,11 @@ namespace marlinmt {
     using EventList = std::vector<std::shared_ptr<EventStore>> ;
     using DataSource = std::shared_ptr<DataSourcePlugin> ;
     using ConditionsMap = std::map<std::string, std::string> ;
+    using ReadAheadBuffer = std::unique_ptr<concurrency::ReadAheadBuffer> ;
 
   public:
-    Application() = default ;
-    ~Application() = default ;
+    Application() ;
+    ~Application() ;
 
   public:
     /**
@@ -87,6 +95,12 @@ namespace marlinmt {
      */
     Logger createLogger( const std::string &name ) const ;
 
+    /**
+     *  @brief  Get the asynchronous logger for the event processing lines.
+     *  Returns nullptr if asynchronous logging is disabled
+     */
+    std::shared_ptr<AsyncLogger> asyncLogger() const ;
+
     /**
      *  @brief  Get the geometry manager
      */
@@ -102,6 +116,17 @@ namespace marlinmt {
      */
     RandomSeedManager &randomSeedManager() ;
 
+    /**
+     *  @brief  Get how the schedulers time the processor calls
+     */
+    TimingMode processorTimingMode() const ;
+
+    /**
+     *  @brief  Get the fraction of timed processor calls (1/sampling)
+     *  in sampled timing mode
+     */
+    unsigned int processorTimingSampling() const ;
+
     /**
      *  @brief Get book store manager
      */
@@ -118,6 +143,16 @@ namespace marlinmt {
      */
     const Configuration &configuration() const ;
 
+    /**
+     *  @brief  Attach the event extensions needed by the processors (random seeds,
+     *  runtime conditions). The reader thread only forwards the raw events: the
+     *  scheduler calls this function in a worker thread as the first step of the
+     *  event processing, before any processor runs. Thread safe
+     *
+     *  @param  event the event to prepare
+     */
+    void prepareEvent( EventStore &event ) const ;
+
   private:    
     /**
      *  @brief  Callback function to process an event received from the data source
@@ -139,6 +174,24 @@ namespace marlinmt {
      *  @param  events the list of finished events
      */
     void processFinishedEvents( const EventList &events ) const ;
+
+    /**
+     *  @brief  Give the finished events back to the event store pool
+     *
+     *  @param  events the list of finished events (cleared)
+     */
+    void recycleFinishedEvents( EventList &events ) ;
+
+    /**
+     *  @brief  Read the data source in the reader thread and dispatch
+     *  the records from the read-ahead buffer to the scheduler
+     */
+    void dispatchReadAhead() ;
+
+    /**
+     *  @brief  Print the read-ahead stage statistics
+     */
+    void printReadAheadSummary() const ;
     
     /**
      *  @brief  Dump an example configuation
@@ -154,6 +207,10 @@ namespace marlinmt {
     GeometryManager            _geometryMgr {} ;
     /// The random seed manager
     RandomSeedManager          _randomSeedMgr {} ;
+    /// How the schedulers time the processor calls
+    TimingMode                 _timingMode {TimingMode::Full} ;
+    /// The fraction of timed processor calls in sampled timing mode
+    unsigned int               _timingSampling {100} ;
     /// The logger manager
     LoggerManager              _loggerMgr {} ;
     /// Managed data object shared between threads.
@@ -164,8 +221,14 @@ namespace marlinmt {
     Scheduler                  _scheduler {nullptr} ;
     /// The data source plugin
     DataSource                 _dataSource {nullptr} ;
+    /// The read-ahead buffer, if enabled
+    ReadAheadBuffer            _readAhead {nullptr} ;
     /// Initial processor runtime conditions from steering file
     ConditionsMap              _conditions {} ;
+    /// The processor runtime conditions, compiled once for all events
+    std::shared_ptr<const CompiledConditions> _compiledConditions {nullptr} ;
+    /// The pool of event stores recycled after processing
+    EventStorePool             _eventStorePool {} ;
   };
 
 } // end namespace marlinmt
@@ -0,0 +1,450 @@
+#ifndef MARLINMT_ASYNCLOGGER_h
+#define MARLINMT_ASYNCLOGGER_h 1
+
+// -- std headers
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <ostream>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <condition_variable>
+
+// -- marlinmt headers
+#include <marlinmt/concurrency/CacheLine.h>
+
+namespace marlinmt {
+
+  namespace detail {
+
+    /**
+     *  @brief  AsyncLogRecord struct
+     *  A log line as stored in the per-thread rings. The message arguments
+     *  are captured by value in the record storage and only formatted
+     *  by the drainer thread
+     */
+    struct AsyncLogRecord {
+      /// The size of the storage for the captured arguments
+      static constexpr std::size_t StorageSize = 192 ;
+      /// Format the captured arguments in the stream (if not null) and destroy them
+      using FormatFunction = void (*)( void *storage, std::ostream *out ) ;
+      /// The record kind
+      enum class Kind : unsigned char {
+        Line,        ///< A log line
+        EventEnd     ///< The end of the lines of an event (event flush mode)
+      };
+
+      ///< The record time (unit: ns since the logger creation)
+      std::int64_t                 _time {0} ;
+      ///< The record kind
+      Kind                         _kind {Kind::Line} ;
+      ///< The log level name
+      const char                  *_level {nullptr} ;
+      ///< The channel name (owned by the logger)
+      const std::string           *_channel {nullptr} ;
+      ///< The event id the record belongs to (0: none)
+      std::size_t                  _event {0} ;
+      ///< The function formatting the captured arguments
+      FormatFunction               _format {nullptr} ;
+      ///< The captured arguments
+      alignas(std::max_align_t) unsigned char _storage [StorageSize] ;
+    };
+
+    //--------------------------------------------------------------------------
+
+    /**
+     *  @brief  AsyncLogRing class
+     *  Fixed size single producer / single consumer ring of log records.
+     *  The producer is the thread owning the ring, the consumer the drainer thread
+     */
+    class AsyncLogRing {
+    public:
+      AsyncLogRing() = delete ;
+      AsyncLogRing(const AsyncLogRing &) = delete ;
+      AsyncLogRing& operator=(const AsyncLogRing &) = delete ;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  size the ring size, rounded up to a power of 2
+       */
+      AsyncLogRing( std::size_t size ) ;
+
+      /**
+       *  @brief  Get the next free record. Yields while the ring is full.
+       *  Returns nullptr if the ring is full and the logger is stopped.
+       *  Producer side only
+       *
+       *  @param  stopped whether the logger is stopped
+       */
+      AsyncLogRecord *acquire( const std::atomic<bool> &stopped ) ;
+
+      /**
+       *  @brief  Publish the record obtained with acquire(). Producer side only
+       */
+      void commit() {
+        _head.store( _head.load( std::memory_order_relaxed ) + 1, std::memory_order_release ) ;
+      }
+
+      /**
+       *  @brief  Move the published records to the output vector. Consumer side only
+       *
+       *  @param  records the output records
+       */
+      void drain( std::vector<AsyncLogRecord*> &records ) ;
+
+      /**
+       *  @brief  Release the records moved by the last call to drain(). Consumer side only
+       */
+      void release() ;
+
+      /**
+       *  @brief  Get the number of times the producer found the ring full
+       */
+      std::size_t fullWaits() const {
+        return _fullWaits.load( std::memory_order_relaxed ) ;
+      }
+
+    private:
+      ///< The ring records
+      std::vector<AsyncLogRecord>                                     _records ;
+      ///< The index mask (size - 1)
+      const std::size_t                                               _mask ;
+      ///< The next record to write. Written by the producer only
+      alignas(concurrency::CacheLineSize) std::atomic<std::size_t>    _head {0} ;
+      ///< The last tail value read by the producer
+      std::size_t                                                     _cachedTail {0} ;
+      ///< The number of times the producer found the ring full
+      std::atomic<std::size_t>                                        _fullWaits {0} ;
+      ///< The next record to read. Written by the consumer only
+      alignas(concurrency::CacheLineSize) std::atomic<std::size_t>    _tail {0} ;
+      ///< The end of the records moved by the last call to drain()
+      std::size_t                                                     _drained {0} ;
+    };
+
+    //--------------------------------------------------------------------------
+
+    /// The type used to capture a log line argument: its decayed type, except
+    /// for character strings that are not owned (pointers, string views) which
+    /// are copied in a std::string
+    template <typename T, typename D = std::decay_t<T>>
+    using AsyncLogCapture = std::conditional_t<
+      std::is_same_v<D, const char*> or std::is_same_v<D, char*> or std::is_same_v<D, std::string_view>,
+      std::string, D> ;
+
+    //--------------------------------------------------------------------------
+
+    /// Format the captured arguments tuple in the stream and destroy it
+    template <typename Tuple>
+    void formatLogTuple( void *storage, std::ostream *out ) {
+      auto args = static_cast<Tuple*>( storage ) ;
+      if( nullptr != out ) {
+        std::apply( [out]( const auto &...arg ){ ( static_cast<void>( (*out) << arg ), ... ) ; }, *args ) ;
+      }
+      args->~Tuple() ;
+    }
+
+  } // end namespace detail
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  /**
+   *  @brief  AsyncLogger class
+   *  Asynchronous logging backend for the lines written on the event hot path.
+   *
+   *  Each writing thread owns a lock-free ring of fixed size records. Writing a
+   *  line only captures its arguments by value in the next record of the ring:
+   *  the formatting and the output are done by a background drainer thread,
+   *  which periodically collects the records of all the rings, orders them by
+   *  time and writes them to the console or to a file. When a ring is full, the
+   *  writing thread yields until the drainer has made room.
+   *
+   *  The arguments are captured by value with their decayed type. Character
+   *  strings passed as pointers or string views are copied in a std::string,
+   *  so temporary strings can be written safely. A new line is appended to each
+   *  line. In event flush mode, the lines written while an event is set as the
+   *  current event of the thread (see setCurrentEvent()) are buffered and written
+   *  together when flushEvent() is called for this event.
+   */
+  class AsyncLogger {
+  public:
+    using Record = detail::AsyncLogRecord ;
+    using Ring = detail::AsyncLogRing ;
+
+    /**
+     *  @brief  FlushMode enumerator
+     */
+    enum class FlushMode {
+      Line,      ///< Write the lines as they are drained
+      Event      ///< Write the lines of an event together on flushEvent()
+    };
+
+    /**
+     *  @brief  Channel class
+     *  A named handle to write lines in the logger, with its own log level
+     */
+    class Channel {
+    public:
+      Channel() = default ;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  logger the logger to write to
+       *  @param  name the channel name (owned by the logger)
+       *  @param  level the channel log level
+       */
+      Channel( AsyncLogger *logger, const std::string *name, const std::string &level ) ;
+
+      /**
+       *  @brief  Set the channel log level (e.g "MESSAGE", "DEBUG5")
+       *
+       *  @param  level the log level name
+       */
+      void setLevel( const std::string &level ) ;
+
+      /**
+       *  @brief  Whether the channel is attached to a logger
+       */
+      bool valid() const {
+        return ( nullptr != _logger ) ;
+      }
+
+      /**
+       *  @brief  Whether a line at the given level would be written
+       *
+       *  @param  level the log level name
+       */
+      bool enabled( const char *level ) const {
+        return ( nullptr != _logger ) and ( levelRank( level ) >= _threshold ) ;
+      }
+
+      /**
+       *  @brief  Write a line if the level is enabled
+       *
+       *  @param  level the log level name (must outlive the logger, e.g a string literal)
+       *  @param  args the line content
+       */
+      template <typename ...Args>
+      void log( const char *level, Args &&...args ) const {
+        if( enabled( level ) ) {
+          _logger->push( Record::Kind::Line, level, _name, std::forward<Args>(args)... ) ;
+        }
+      }
+
+    private:
+      ///< The logger to write to
+      AsyncLogger              *_logger {nullptr} ;
+      ///< The channel name
+      const std::string        *_name {nullptr} ;
+      ///< The minimum level rank written
+      unsigned int              _threshold {0} ;
+    };
+
+  public:
+    AsyncLogger() = delete ;
+    AsyncLogger(const AsyncLogger &) = delete ;
+    AsyncLogger& operator=(const AsyncLogger &) = delete ;
+
+    /**
+     *  @brief  Constructor. Write to an output stream
+     *
+     *  @param  out the output stream (must outlive the logger)
+     *  @param  mode the flush mode
+     *  @param  ringSize the number of records in each thread ring
+     *  @param  drainPeriod the period of the drainer thread (unit: ms)
+     */
+    AsyncLogger( std::ostream &out, FlushMode mode = FlushMode::Line, std::size_t ringSize = 1024, unsigned int drainPeriod = 5 ) ;
+
+    /**
+     *  @brief  Constructor. Write to a file
+     *
+     *  @param  filename the output file name
+     *  @param  mode the flush mode
+     *  @param  ringSize the number of records in each thread ring
+     *  @param  drainPeriod the period of the drainer thread (unit: ms)
+     */
+    AsyncLogger( const std::string &filename, FlushMode mode = FlushMode::Line, std::size_t ringSize = 1024, unsigned int drainPeriod = 5 ) ;
+
+    /**
+     *  @brief  Destructor. Stop the drainer thread
+     */
+    ~AsyncLogger() ;
+
+    /**
+     *  @brief  Create a channel
+     *
+     *  @param  name the channel name
+     *  @param  level the channel log level
+     */
+    Channel channel( const std::string &name, const std::string &level = "MESSAGE" ) ;
+
+    /**
+     *  @brief  Set the event the lines written by the calling thread belong to.
+     *  Only used in event flush mode. Use 0 for no event
+     *
+     *  @param  id the event id
+     */
+    static void setCurrentEvent( std::size_t id ) ;
+
+    /**
+     *  @brief  Write the buffered lines of an event (event flush mode).
+     *  All the lines of the event must have been written before the call
+     *
+     *  @param  id the event id
+     */
+    void flushEvent( std::size_t id ) ;
+
+    /**
+     *  @brief  Write all the remaining lines and stop the drainer thread.
+     *  No line must be written after this call
+     */
+    void stop() ;
+
+    /**
+     *  @brief  Get the flush mode
+     */
+    FlushMode flushMode() const ;
+
+    /**
+     *  @brief  Get the number of lines written so far
+     */
+    std::size_t nLines() const ;
+
+    /**
+     *  @brief  Get the number of times a writing thread found its ring full
+     */
+    std::size_t fullWaits() const ;
+
+    /**
+     *  @brief  Get the rank of a log level name (DEBUG < MESSAGE < WARNING < ERROR < SILENT)
+     *
+     *  @param  level the log level name
+     */
+    static unsigned int levelRank( const char *level ) ;
+
+    /**
+     *  @brief  Convert a string ("line" or "event") to a flush mode. Throws on unknown mode
+     *
+     *  @param  mode the flush mode name
+     */
+    static FlushMode flushModeFromString( const std::string &mode ) ;
+
+  private:
+    /**
+     *  @brief  Capture a record in the ring of the calling thread
+     */
+    template <typename ...Args>
+    void push( Record::Kind kind, const char *level, const std::string *channel, Args &&...args ) ;
+
+    /**
+     *  @brief  Get the ring of the calling thread, created on first call
+     */
+    Ring &threadRing() ;
+
+    /**
+     *  @brief  Get the current event of the calling thread
+     */
+    static std::size_t currentEvent() ;
+
+    /**
+     *  @brief  Get the current record time
+     */
+    std::int64_t now() const {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _start ).count() ;
+    }
+
+    /**
+     *  @brief  Start the drainer thread
+     */
+    void start() ;
+
+    /**
+     *  @brief  Collect and write the records of all the rings. Drainer side only
+     */
+    void drain() ;
+
+  private:
+    ///< A unique id for this logger, to identify the thread rings
+    const std::size_t                           _id ;
+    ///< The output file, if writing to a file
+    std::unique_ptr<std::ofstream>              _file {nullptr} ;
+    ///< The output stream
+    std::ostream                               &_out ;
+    ///< The flush mode
+    const FlushMode                             _flushMode ;
+    ///< The number of records in each ring
+    const std::size_t                           _ringSize ;
+    ///< The drainer thread period
+    const std::chrono::milliseconds             _drainPeriod ;
+    ///< The logger creation time
+    const std::chrono::steady_clock::time_point _start {std::chrono::steady_clock::now()} ;
+    ///< The thread rings
+    std::vector<std::unique_ptr<Ring>>          _rings {} ;
+    ///< The channel names, with stable addresses
+    std::deque<std::string>                     _channelNames {} ;
+    ///< The synchronization mutex for the rings and names creation
+    mutable std::mutex                          _mutex {} ;
+    ///< The drainer thread
+    std::thread                                 _drainer {} ;
+    ///< The drainer thread wake up condition
+    std::condition_variable                     _drainCondition {} ;
+    ///< Whether the logger is stopped
+    std::atomic<bool>                           _stopped {false} ;
+    ///< The number of lines written
+    std::atomic<std::size_t>                    _nLines {0} ;
+    ///< The number of records dropped after stop()
+    std::atomic<std::size_t>                    _nDropped {0} ;
+    ///< The records collected by the last drain (drainer side)
+    std::vector<Record*>                        _batch {} ;
+    ///< The event ends collected by the previous drain (drainer side)
+    std::vector<std::size_t>                    _eventEnds {} ;
+    ///< The buffered lines per event in event flush mode (drainer side)
+    std::unordered_map<std::size_t, std::string> _eventLines {} ;
+  };
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  template <typename ...Args>
+  inline void AsyncLogger::push( Record::Kind kind, const char *level, const std::string *channel, Args &&...args ) {
+    auto &ring = threadRing() ;
+    auto record = ring.acquire( _stopped ) ;
+    if( nullptr == record ) {
+      _nDropped.fetch_add( 1, std::memory_order_relaxed ) ;
+      return ;
+    }
+    record->_time = now() ;
+    record->_kind = kind ;
+    record->_level = level ;
+    record->_channel = channel ;
+    record->_event = ( FlushMode::Event == _flushMode ) ? currentEvent() : 0 ;
+    using Tuple = std::tuple<detail::AsyncLogCapture<Args>...> ;
+    if constexpr ( sizeof(Tuple) <= Record::StorageSize and alignof(Tuple) <= alignof(std::max_align_t) ) {
+      new ( record->_storage ) Tuple( std::forward<Args>(args)... ) ;
+      record->_format = &detail::formatLogTuple<Tuple> ;
+    }
+    else {
+      // too large to be captured: format now
+      std::ostringstream ss ;
+      ( static_cast<void>( ss << args ), ... ) ;
+      new ( record->_storage ) std::tuple<std::string>( ss.str() ) ;
+      record->_format = &detail::formatLogTuple<std::tuple<std::string>> ;
+    }
+    ring.commit() ;
+  }
+
+} // end namespace marlinmt
+
+#endif
@@ -36,6 +36,21 @@ namespace marlinmt {
     
     /// Initialize the book store manager
     void initialize() override ;
+
+    /**
+     *  @brief  Set the number of threads that may fill the histograms, i.e the number of
+     *  instances of the multi copy histograms booked from now on. Each of these threads
+     *  holds a book store thread slot (see book::ThreadSlot) and needs its own instance.
+     *  Defaults to the number of worker threads plus the main thread
+     *
+     *  @param  nthreads the number of threads
+     */
+    void setNumberOfThreads( std::size_t nthreads ) ;
+
+    /**
+     *  @brief  Get the number of threads that may fill the histograms
+     */
+    std::size_t numberOfThreads() const ;
     
     /**
      *  @brief  Book  a histogram 1D, float type
@@ -109,10 +124,12 @@ namespace marlinmt {
     /// Output file name to store objects
     StringParameter                      _outputFile {*this, "OutputFile", "The output file name for storage", "MarlinMT_"+details::convert<int>::to_string(::getpid())+".root"} ;
     /// Output file name to store objects
-    StringParameter                      _defaultMemLayout {*this, "DefaultMemoryLayout", "The memory layout for objects", "Default"} ;
+    StringParameter                      _defaultMemLayout {*this, "DefaultMemoryLayout", "The memory layout for objects (share, copy, atomic or default). The atomic layout is lock-free with the native histograms only", "Default"} ;
     /// default flag, used if flag == BookFlags::Default. 
     /// Default is shared, store. Change is steering file with: store::DefaultMemoryLayout and store::StoreByDefault.
     BookFlag_t                           _defaultFlag { 0 } ;
+    /// The number of threads that may fill the histograms
+    std::size_t                          _nThreads { 1 } ;
   };
 
   
@@ -0,0 +1,271 @@
+#ifndef MARLINMT_COMPILEDCONDITIONS_h
+#define MARLINMT_COMPILEDCONDITIONS_h 1
+
+// -- std headers
+#include <map>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <unordered_map>
+
+namespace marlinmt {
+
+  /**
+   *  @brief  CompiledConditions class
+   *  Processor runtime conditions compiled once into small boolean programs.
+   *
+   *  The condition expressions use the LogicalExpressions syntax and semantics
+   *  ([!,(,&&,||,)], evaluated from left to right without operator precedence).
+   *  Each value name used in the expressions (processor return values) gets a
+   *  slot index. The per-event state is a Values object holding one bit per
+   *  slot, so that checking a condition runs a few stack operations on bits
+   *  instead of re-parsing the expression strings.
+   *  A CompiledConditions object is read-only after construction and can be
+   *  shared by all events and threads.
+   */
+  class CompiledConditions {
+  public:
+    using Index = std::size_t ;
+    using ConditionsMap = std::map<std::string, std::string> ;
+    static constexpr Index npos = std::numeric_limits<Index>::max() ;
+    /// The maximum evaluation stack depth of a condition
+    static constexpr std::size_t MaxStackDepth = 64 ;
+
+    /**
+     *  @brief  Values class
+     *  The processor return values of an event, one bit per value slot.
+     *  Setting and reading values is thread safe
+     */
+    class Values {
+    public:
+      Values() = default ;
+      Values(const Values &) = delete ;
+      Values &operator=(const Values &) = delete ;
+      Values(Values &&) = default ;
+      Values &operator=(Values &&) = default ;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  nvalues the number of value slots
+       */
+      Values( std::size_t nvalues ) ;
+
+      /**
+       *  @brief  Set the value at the given slot
+       *
+       *  @param  index the value slot
+       *  @param  value the value to set
+       */
+      void set( Index index, bool value ) ;
+
+      /**
+       *  @brief  Whether the value at the given slot has been set
+       *
+       *  @param  index the value slot
+       */
+      bool isSet( Index index ) const ;
+
+      /**
+       *  @brief  Get the value at the given slot
+       *
+       *  @param  index the value slot
+       */
+      bool get( Index index ) const ;
+
+      /**
+       *  @brief  Unset all values
+       */
+      void clear() ;
+
+      /**
+       *  @brief  Get the number of value slots
+       */
+      std::size_t size() const ;
+
+    private:
+      using Words = std::vector<std::atomic<std::uint64_t>> ;
+      /// The number of value slots
+      std::size_t      _size {0} ;
+      /// The value bits
+      Words            _values {} ;
+      /// The bits of the values that have been set
+      Words            _isSet {} ;
+    };
+
+    /**
+     *  @brief  ValueSlots class
+     *  The value slots of one processor: its return value, named as the
+     *  processor, and its named return values "<processor>.<name>".
+     *  Resolved once for a CompiledConditions object, so that setting a
+     *  return value doesn't hash or build the value name on each event.
+     *  Thread safe, as a processor may run in several threads
+     */
+    class ValueSlots {
+    public:
+      ValueSlots() = default ;
+      ValueSlots(const ValueSlots &) = delete ;
+      ValueSlots &operator=(const ValueSlots &) = delete ;
+
+      /**
+       *  @brief  Resolve the slots of the processor, if not yet done for these conditions.
+       *  The processor must not be used with different conditions concurrently
+       *
+       *  @param  conds the compiled conditions
+       *  @param  processorName the processor name
+       */
+      void resolve( const CompiledConditions &conds, const std::string &processorName ) ;
+
+      /**
+       *  @brief  Get the slot of the processor return value, npos if not used in any condition
+       */
+      Index index() const ;
+
+      /**
+       *  @brief  Get the slot of the named processor return value, npos if not used in any condition
+       *
+       *  @param  name the return value name, without the processor name
+       */
+      Index index( const std::string &name ) const ;
+
+    private:
+      using NamedIndices = std::vector<std::pair<std::string, Index>> ;
+      /// The compiled conditions the slots are resolved for, published to the other threads
+      std::atomic<const CompiledConditions*>  _resolved {nullptr} ;
+      /// The mutex serialising the resolution
+      std::mutex                              _mutex {} ;
+      /// The slot of the processor return value
+      Index                                   _index {npos} ;
+      /// The slots of the named return values used in the conditions
+      NamedIndices                            _namedIndices {} ;
+    };
+
+  private:
+    /**
+     *  @brief  OpCode enum
+     */
+    enum class OpCode : std::uint8_t {
+      PushTrue,
+      PushFalse,
+      PushValue,
+      Not,
+      And,
+      Or
+    };
+
+    /**
+     *  @brief  Instruction struct
+     */
+    struct Instruction {
+      ///< The operation
+      OpCode           _opcode {OpCode::PushTrue} ;
+      ///< The value slot (PushValue only)
+      Index            _index {0} ;
+    };
+
+    using Program = std::vector<Instruction> ;
+
+  public:
+    CompiledConditions() = default ;
+    ~CompiledConditions() = default ;
+    CompiledConditions(const CompiledConditions &) = delete ;
+    CompiledConditions &operator=(const CompiledConditions &) = delete ;
+
+    /**
+     *  @brief  Constructor. Compile all the conditions.
+     *  Throws ParseException if a condition can't be compiled
+     *
+     *  @param  conds the named conditions (from steering file)
+     */
+    CompiledConditions( const ConditionsMap &conds ) ;
+
+    /**
+     *  @brief  Get the index of the named condition, npos if no such condition
+     *
+     *  @param  name the condition name
+     */
+    Index conditionIndex( const std::string &name ) const ;
+
+    /**
+     *  @brief  Get the slot of the named value, npos if the value
+     *  is not used in any condition
+     *
+     *  @param  name the value name
+     */
+    Index valueIndex( const std::string &name ) const ;
+
+    /**
+     *  @brief  Get the number of value slots
+     */
+    std::size_t nValues() const ;
+
+    /**
+     *  @brief  Get the number of conditions
+     */
+    std::size_t nConditions() const ;
+
+    /**
+     *  @brief  Evaluate a condition. A condition index of npos evaluates to true.
+     *  Throws ParseException if the condition reads a value that has not been set
+     *
+     *  @param  index the condition index
+     *  @param  values the processor return values of the event
+     */
+    bool evaluate( Index index, const Values &values ) const ;
+
+    /**
+     *  @brief  Whether a condition is known to be false: all the values it reads
+     *  are set and it evaluates to false. A condition index of npos is never false.
+     *  Unlike evaluate(), doesn't throw on values that have not been set
+     *
+     *  @param  index the condition index
+     *  @param  values the processor return values of the event
+     */
+    bool isFalse( Index index, const Values &values ) const ;
+
+  private:
+    /**
+     *  @brief  Evaluate a condition. Stop on the first value not set
+     *
+     *  @param  index the condition index (not npos)
+     *  @param  values the processor return values of the event
+     *  @param  unset set to the slot of the first value not set, npos if all values are set
+     */
+    bool run( Index index, const Values &values, Index &unset ) const ;
+
+    /**
+     *  @brief  Compile an expression and append the instructions to the program
+     *
+     *  @param  expression the expression to compile
+     *  @param  program the program to append to
+     *  @param  depth the current nesting depth
+     */
+    void compile( const std::string &expression, Program &program, std::size_t depth ) ;
+
+    /**
+     *  @brief  Append the instructions for a single named value
+     *
+     *  @param  name the value name
+     *  @param  isNot whether the value is negated
+     *  @param  program the program to append to
+     */
+    void compileValue( const std::string &name, bool isNot, Program &program ) ;
+
+  private:
+    /// The compiled conditions
+    std::vector<Program>                     _programs {} ;
+    /// The value names, indexed by slot
+    std::vector<std::string>                 _valueNames {} ;
+    /// The condition name to condition index map
+    std::unordered_map<std::string, Index>   _conditionIndices {} ;
+    /// The value name to slot map
+    std::unordered_map<std::string, Index>   _valueIndices {} ;
+  };
+
+}
+
+#endif
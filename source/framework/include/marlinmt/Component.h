@@ -5,8 +5,36 @@
 
 // -- marlinmt headers
 #include <marlinmt/Logging.h>
+#include <marlinmt/AsyncLogger.h>
 #include <marlinmt/Parameter.h>
 
+/**
+ *  Log a message with specific log level in a component, only if it would be written.
+ *  The stream operands are not evaluated otherwise, and the statement is removed
+ *  at compile time for the log levels below MARLINMT_MIN_LOG_LEVEL.
+ *  Usage:
+ *  @code{.cpp}
+ *  MARLINMT_LOG( *this, DEBUG ) << "Expensive: " << compute() << std::endl ;
+ *  @endcode
+ */
+#define MARLINMT_LOG( component, LEVEL ) \
+  if( not (component).template isLogged<marlinmt::loglevel::LEVEL>() ) {} \
+  else (component).template log<marlinmt::loglevel::LEVEL>()
+
+/**
+ *  Log a line with specific log level in a component, only if it would be written.
+ *  The line is written through the asynchronous logger if enabled, else through
+ *  the component logger. Use it on the event hot path. The arguments are not
+ *  evaluated if the line is not written. A new line is appended.
+ *  Usage:
+ *  @code{.cpp}
+ *  MARLINMT_LOG_LINE( *this, DEBUG, "Processing event ", event->uid() ) ;
+ *  @endcode
+ */
+#define MARLINMT_LOG_LINE( component, LEVEL, ... ) \
+  if( not (component).template isLogged<marlinmt::loglevel::LEVEL>() ) {} \
+  else (component).template logLine<marlinmt::loglevel::LEVEL>( __VA_ARGS__ )
+
 namespace marlinmt {
   
   class Application ;
@@ -93,6 +121,61 @@ namespace marlinmt {
     inline Logging::StreamType log() const {
       return _logger->log<T>() ;
     }
+
+    /**
+     *  @brief  Whether a message with specific log level would be written.
+     *  Always false for the log levels below MARLINMT_MIN_LOG_LEVEL, so that
+     *  the compiler removes the statements depending on it
+     */
+    template <class T>
+    inline bool isLogged() const {
+      if constexpr ( loglevel::compiled<T> ) {
+        return ( loglevel::rank<T>::value >= _logRank ) ;
+      }
+      else {
+        return false ;
+      }
+    }
+
+    /**
+     *  @brief  Log a message with specific log level, only if it would be written.
+     *  The function receives the stream object and is not called otherwise.
+     *  Usage:
+     *  @code{.cpp}
+     *  logLazy<DEBUG>( [&]( auto &out ){ out << "Expensive: " << compute() << std::endl ; } ) ;
+     *  @endcode
+     *  See also the MARLINMT_LOG macro
+     */
+    template <class T, typename F>
+    inline void logLazy( F &&function ) const {
+      if( isLogged<T>() ) {
+        auto stream = log<T>() ;
+        function( stream ) ;
+      }
+    }
+    
+    /**
+     *  @brief  Log a line with specific log level, only if it would be written.
+     *  The line is written through the asynchronous logger if enabled in the
+     *  application (the arguments are formatted by the logger thread), else
+     *  through the component logger. A new line is appended.
+     *  See also the MARLINMT_LOG_LINE macro
+     *
+     *  @param  args the line content
+     */
+    template <class T, typename ...Args>
+    inline void logLine( Args &&...args ) const {
+      if( not isLogged<T>() ) {
+        return ;
+      }
+      if( _asyncChannel.valid() ) {
+        _asyncChannel.log( loglevel::rank<T>::name, std::forward<Args>(args)... ) ;
+      }
+      else {
+        auto stream = log<T>() ;
+        ( stream << ... << args ) << std::endl ;
+      }
+    }
     
     /// Shortcut for log<DEBUG>()
     Logging::StreamType debug() const ;
@@ -173,6 +256,10 @@ namespace marlinmt {
     LoggerPtr                _logger {nullptr} ;
     /// The verbosity level of the logger (parameter)
     StringParameter          _verbosity { *this, "Verbosity", "The component verbosity level", "MESSAGE" } ;
+    /// The rank of the logger verbosity level (see loglevel::rank)
+    unsigned int             _logRank {loglevel::rank<MESSAGE>::value} ;
+    /// The asynchronous logger channel (not valid if asynchronous logging is disabled)
+    AsyncLogger::Channel     _asyncChannel {} ;
   };
   
   //--------------------------------------------------------------------------
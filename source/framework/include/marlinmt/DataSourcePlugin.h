@@ -14,6 +14,7 @@ namespace marlinmt {
 
   class Application ;
   class EventStore ;
+  class EventStorePool ;
   class RunHeader ;
 
   /**
@@ -27,6 +28,8 @@ namespace marlinmt {
     using RunHeaderFunction = std::function<void(std::shared_ptr<RunHeader>)> ;
 
   public:
+    DataSourcePlugin(const DataSourcePlugin &) = delete ;
+    DataSourcePlugin& operator=(const DataSourcePlugin &) = delete ;
     virtual ~DataSourcePlugin() = default ;
 
     /**
@@ -75,7 +78,28 @@ namespace marlinmt {
      */
     void onRunHeaderRead( RunHeaderFunction func ) ;
 
+    /**
+     *  @brief  Get the number of records to read in advance in a
+     *  dedicated reader thread. 0 means the read-ahead stage is disabled
+     */
+    unsigned int readAheadSize() const ;
+
+    /**
+     *  @brief  Set the pool from which createEventStore() gets the event stores.
+     *  If not set, a new event store is allocated for each event
+     *
+     *  @param  pool the event store pool (not owned)
+     */
+    void setEventStorePool( EventStorePool *pool ) ;
+
   protected:
+    /**
+     *  @brief  Get a new event store to fill with the next event.
+     *  Daughter classes should use this method instead of allocating
+     *  the event store themselves
+     */
+    std::shared_ptr<EventStore> createEventStore() ;
+
     /**
      *  @brief  Must be called by daughter classes in readStream()
      *  to process an event in the framework
@@ -98,12 +122,16 @@ namespace marlinmt {
   protected:
     ///< The data source description
     std::string              _description {"No description"} ;
+    ///< The read-ahead buffer size
+    UIntParameter            _readAheadSize {*this, "ReadAheadSize", "The number of records read in advance by a dedicated reader thread (0: read in the main thread)", 0} ;
 
   private:
     ///< The callback function on event read
     EventFunction            _onEventRead {nullptr} ;
     ///< The callback function on run header read
     RunHeaderFunction        _onRunHeaderRead {nullptr} ;
+    ///< The event store pool
+    EventStorePool          *_eventStorePool {nullptr} ;
   };
 
 }
@@ -3,26 +3,32 @@
 
 // -- marlinmt headers
 #include <marlinmt/RandomSeedManager.h>
-#include <marlinmt/LogicalExpressions.h>
+#include <marlinmt/CompiledConditions.h>
 #include <marlinmt/Extensions.h>
+#include <marlinmt/RunContext.h>
 
 // -- std headers
 #include <memory>
 #include <thread>
+#include <mutex>
 #include <string>
 
 namespace marlinmt {
 
   class Processor ;
+  class RunHeader ;
 
   /**
    *  @brief  ProcessorConditionsExtension class
-   *  Event extension providing access to processor runtime conditions (LogicalExpressions)
+   *  Event extension providing access to processor runtime conditions.
+   *  The conditions are compiled once and shared by all events (see CompiledConditions),
+   *  the extension only holds the processor return values of the event.
+   *  Thread safe, as processors of the same event may run concurrently (see DAGScheduler)
    */
   class ProcessorConditionsExtension {
   public:
-    using Conditions = std::shared_ptr<LogicalExpressions> ;
-    using ConditionsMap = std::map<std::string, std::string> ;
+    using Conditions = std::shared_ptr<const CompiledConditions> ;
+    using Index = CompiledConditions::Index ;
 
   public:
     ~ProcessorConditionsExtension() = default ;
@@ -34,9 +40,16 @@ namespace marlinmt {
     /**
      *  @brief  Constructor
      *
-     *  @param  conds the initial runtime condition of the event (from steering file)
+     *  @param  conds the compiled runtime conditions (from steering file)
      */
-    ProcessorConditionsExtension( const ConditionsMap &conds ) ;
+    ProcessorConditionsExtension( Conditions conds ) ;
+
+    /**
+     *  @brief  Reset the extension for a new event (see Extensions::recyclable())
+     *
+     *  @param  conds the compiled runtime conditions (from steering file)
+     */
+    void reset( Conditions conds ) ;
 
     /**
      *  @brief  Set the runtime condition of the processor
@@ -62,9 +75,31 @@ namespace marlinmt {
      */
     bool check( const std::string &name ) const ;
 
+    /**
+     *  @brief  Check whether the runtime condition is true
+     *
+     *  @param  index the condition index (see CompiledConditions::conditionIndex())
+     */
+    bool check( Index index ) const ;
+
+    /**
+     *  @brief  Whether the runtime condition is known to be false with the
+     *  values set so far (see CompiledConditions::isFalse())
+     *
+     *  @param  index the condition index (see CompiledConditions::conditionIndex())
+     */
+    bool isFalse( Index index ) const ;
+
+    /**
+     *  @brief  Get the compiled runtime conditions
+     */
+    const Conditions &conditions() const ;
+
   private:
-    /// The runtime conditions
-    Conditions     _runtimeConditions {std::make_shared<LogicalExpressions>()} ;
+    /// The compiled runtime conditions
+    Conditions                    _conditions {nullptr} ;
+    /// The processor return values of the event
+    CompiledConditions::Values    _values {} ;
   };
 
   //--------------------------------------------------------------------------
@@ -72,11 +107,14 @@ namespace marlinmt {
 
   /**
    *  @brief  RandomSeedExtension class
-   *  Event extension providing access to random seeds
+   *  Event extension providing access to random seeds.
+   *  Only the event seed is stored, the processor seeds are computed
+   *  on request (see RandomSeedManager)
    */
   class RandomSeedExtension {
   public:
-    using RandomSeedMap = std::unique_ptr<RandomSeedManager::RandomSeedMap> ;
+    using EventSeed = RandomSeedManager::EventSeed ;
+    using EntryKey = RandomSeedManager::EntryKey ;
     using RandomSeedType = RandomSeedManager::SeedType ;
 
   public:
@@ -89,20 +127,79 @@ namespace marlinmt {
     /**
      *  @brief  Constructor
      *
-     *  @param  seeds the random seed set for the current event
+     *  @param  evtSeed the seed of the current event (see RandomSeedManager::eventSeed())
      */
-    RandomSeedExtension( RandomSeedMap seeds ) ;
+    RandomSeedExtension( EventSeed evtSeed ) ;
 
     /**
-     *  @brief  Get the random seed for a given processor
+     *  @brief  Reset the extension for a new event (see Extensions::recyclable())
      *
-     *  @param  processor the processor pointer
+     *  @param  evtSeed the seed of the current event (see RandomSeedManager::eventSeed())
+     */
+    void reset( EventSeed evtSeed ) ;
+
+    /**
+     *  @brief  Get the random seed for a given entry key
+     *
+     *  @param  key the entry key (see RandomSeedManager::addEntry())
+     */
+    RandomSeedType randomSeed( EntryKey key ) const ;
+
+  private:
+    /// The seed of the current event
+    EventSeed             _eventSeed {0} ;
+  };
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  /**
+   *  @brief  RunContextExtension class
+   *  Event extension providing the run epoch in which the event was read
+   *  and the corresponding run header. See RunContext
+   */
+  class RunContextExtension {
+  public:
+    using Epoch = RunContext::Epoch ;
+
+  public:
+    ~RunContextExtension() = default ;
+    RunContextExtension() = delete ;
+    RunContextExtension(const RunContextExtension&) = delete ;
+    RunContextExtension& operator=(const RunContextExtension&) = delete ;
+
+  public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  epoch the run epoch of the event
+     *  @param  rhdr the run header of the event (nullptr if none)
+     */
+    RunContextExtension( Epoch epoch, std::shared_ptr<RunHeader> rhdr ) ;
+
+    /**
+     *  @brief  Reset the extension for a new event (see Extensions::recyclable())
+     *
+     *  @param  epoch the run epoch of the event
+     *  @param  rhdr the run header of the event (nullptr if none)
+     */
+    void reset( Epoch epoch, std::shared_ptr<RunHeader> rhdr ) ;
+
+    /**
+     *  @brief  Get the run epoch of the event
+     */
+    Epoch epoch() const ;
+
+    /**
+     *  @brief  Get the run header of the event (nullptr if none)
      */
-    RandomSeedType randomSeed( const Processor *const processor ) const ;
+    std::shared_ptr<RunHeader> runHeader() const ;
 
   private:
-    /// The random seed map for the current event
-    RandomSeedMap         _randomSeeds {nullptr} ;
+    /// The run epoch of the event
+    Epoch                         _epoch {0} ;
+    /// The run header of the event
+    std::shared_ptr<RunHeader>    _runHeader {nullptr} ;
   };
 
   //--------------------------------------------------------------------------
@@ -113,6 +210,7 @@ namespace marlinmt {
     struct ProcessorConditions {} ;
     struct RandomSeed {} ;
     struct IsFirstEvent {} ;
+    struct RunEpoch {} ;
   }
 
 }
@@ -4,12 +4,15 @@
 #include <string>
 #include <memory>
 #include <typeindex>
+#include <atomic>
 
 // -- marlinmt headers
 #include <marlinmt/Extensions.h>
 
 namespace marlinmt {
 
+  class Processor ;
+
   /**
    *  @brief  EventStore class.
    *          Provide an interface to a user defined event object.
@@ -20,8 +23,8 @@ namespace marlinmt {
     ~EventStore() = default ;
     EventStore(const EventStore &) = delete ;
     EventStore &operator=(const EventStore &) = delete ;
-    EventStore(EventStore &&) = default ;
-    EventStore &operator=(EventStore &&) = default ;
+    EventStore(EventStore &&) = delete ;
+    EventStore &operator=(EventStore &&) = delete ;
 
     /**
      *  @brief  Set the event unique id
@@ -90,6 +93,35 @@ namespace marlinmt {
      */
     void reset() ;
 
+    /**
+     *  @brief  Flag the event as skipped. The sequence running the
+     *          event stops after the current processor. See
+     *          ProcessorApi::skipCurrentEvent().
+     *          Thread safe: processors of the same event may run
+     *          concurrently (see DAGScheduler)
+     *
+     *  @param  proc the processor requesting the skip. The first one is kept
+     */
+    void skip( const Processor *const proc = nullptr ) ;
+
+    /**
+     *  @brief  Whether the event has been flagged as skipped
+     */
+    bool skipped() const ;
+
+    /**
+     *  @brief  Get the processor that first requested to skip the event
+     */
+    const Processor *skippedBy() const ;
+
+    /**
+     *  @brief  Reset the store for a new event: reset the unique id,
+     *          the skip flag, the event pointer and remove the
+     *          non-recyclable extensions.
+     *          See EventStorePool
+     */
+    void recycle() ;
+
     /**
      *  @brief  Access the event extensions
      */
@@ -107,6 +139,10 @@ namespace marlinmt {
     std::shared_ptr<void>       _event {nullptr} ;
     /// The event implementtion type
     std::type_index             _eventType {typeid(nullptr)} ;
+    /// Whether a processor requested to skip the event
+    std::atomic<bool>           _skipped {false} ;
+    /// The processor that first requested to skip the event
+    std::atomic<const Processor*>  _skippedBy {nullptr} ;
     /// The event extensions
     Extensions                  _extensions {} ;
   };
@@ -192,6 +228,36 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  inline void EventStore::skip( const Processor *const proc ) {
+    const Processor *none {nullptr} ;
+    _skippedBy.compare_exchange_strong( none, proc ) ;
+    _skipped.store( true ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline bool EventStore::skipped() const {
+    return _skipped.load() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline const Processor *EventStore::skippedBy() const {
+    return _skippedBy.load() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline void EventStore::recycle() {
+    _uid = 0 ;
+    _skipped.store( false ) ;
+    _skippedBy.store( nullptr ) ;
+    reset() ;
+    _extensions.recycle() ;
+  }
+
+  //--------------------------------------------------------------------------
+
   inline Extensions &EventStore::extensions() {
     return _extensions ;
   }
@@ -0,0 +1,85 @@
+#ifndef MARLINMT_EVENTSTOREPOOL_h
+#define MARLINMT_EVENTSTOREPOOL_h 1
+
+// -- std headers
+#include <memory>
+#include <vector>
+#include <mutex>
+
+namespace marlinmt {
+
+  class EventStore ;
+
+  /**
+   *  @brief  EventStorePool class
+   *  Recycling pool of event stores.
+   *
+   *  The data source acquires a store per event. The application gives the
+   *  finished events back with release(). A released store is reset (event
+   *  pointer and non-recyclable extensions removed) and kept for the next
+   *  acquire(), so that neither the store, its shared pointer control block
+   *  nor its recyclable extensions are allocated again.
+   *  A store still referenced somewhere else at release time is not recycled.
+   *  Thread safe: the data source may run in the read-ahead thread.
+   */
+  class EventStorePool {
+  public:
+    using StorePtr = std::shared_ptr<EventStore> ;
+    using StoreList = std::vector<StorePtr> ;
+
+  public:
+    EventStorePool(const EventStorePool &) = delete ;
+    EventStorePool& operator=(const EventStorePool &) = delete ;
+    ~EventStorePool() = default ;
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  maxSize the maximum number of stores kept in the pool
+     */
+    EventStorePool( std::size_t maxSize = 256 ) ;
+
+    /**
+     *  @brief  Get a store from the pool or allocate a new one if the pool is empty
+     */
+    StorePtr acquire() ;
+
+    /**
+     *  @brief  Give back a finished event store to the pool.
+     *  The store is recycled only if the caller holds the last reference
+     *
+     *  @param  store the event store to release
+     */
+    void release( StorePtr &&store ) ;
+
+    /**
+     *  @brief  Get the number of stores allocated by acquire()
+     */
+    std::size_t nAllocated() const ;
+
+    /**
+     *  @brief  Get the number of stores recycled by acquire()
+     */
+    std::size_t nRecycled() const ;
+
+    /**
+     *  @brief  Get the number of stores currently available in the pool
+     */
+    std::size_t size() const ;
+
+  private:
+    /// The maximum number of stores kept in the pool
+    const std::size_t         _maxSize ;
+    /// The free stores
+    StoreList                 _stores {} ;
+    /// The number of stores allocated
+    std::size_t               _nAllocated {0} ;
+    /// The number of stores recycled
+    std::size_t               _nRecycled {0} ;
+    /// The mutex protecting the pool
+    mutable std::mutex        _mutex {} ;
+  };
+
+}
+
+#endif
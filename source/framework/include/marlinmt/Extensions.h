@@ -2,7 +2,9 @@
 
 // -- std headers
 #include <memory>
-#include <map>
+#include <array>
+#include <optional>
+#include <string>
 #include <typeindex>
 
 // -- marlinmt headers
@@ -15,6 +17,8 @@ namespace marlinmt {
     Extension() = delete ;
     Extension( const Extension & ) = delete ;
     Extension &operator =( const Extension & ) = delete ;
+    Extension( Extension && ) = default ;
+    Extension &operator =( Extension && ) = default ;
     ~Extension() = default ;
 
   public:
@@ -67,10 +71,30 @@ namespace marlinmt {
   /**
    *  @brief  Extensions class.
    *          Provide an interface to a user defined event object.
+   *
+   *  Each key type gets a dense slot index on first use (see slotIndex()),
+   *  shared by all Extensions objects. The extensions are stored in a small
+   *  fixed array indexed by slot, so that a lookup is a single indexed load.
+   *  At most MaxSlots key types can be used in a program.
+   *  Extensions created with recyclable() survive a call to recycle() and are
+   *  reset in place the next time recyclable() is called for the same key, so
+   *  that a recycled event store (see EventStorePool) doesn't allocate them again.
    */
   class Extensions {
   public:
-    using ExtensionMap = std::map<std::size_t, std::shared_ptr<Extension>> ;
+    /// The maximum number of extension key types
+    static constexpr std::size_t MaxSlots = 16 ;
+
+    /**
+     *  @brief  Slot struct. An extension slot
+     */
+    struct Slot {
+      ///< Whether the extension is kept by recycle()
+      bool                       _recyclable {false} ;
+      ///< The extension, if any
+      std::optional<Extension>   _extension {} ;
+    };
+    using SlotArray = std::array<Slot, MaxSlots> ;
 
   public:
     Extensions() = default ;
@@ -80,67 +104,142 @@ namespace marlinmt {
     Extensions(Extensions &&) = default ;
     Extensions &operator=(Extensions &&) = default ;
 
+    /**
+     *  @brief  Get the slot index of the key type K.
+     *  The index is assigned on the first call for this key type
+     */
+    template <typename K>
+    static inline std::size_t slotIndex() {
+      static const std::size_t index = nextSlotIndex( typeid(K).name() ) ;
+      return index ;
+    }
+
     template <typename K>
     inline bool exits() const {
-      return ( _extensions.find( std::type_index(typeid(K)).hash_code() ) != _extensions.end() ) ;
+      return _slots[ slotIndex<K>() ]._extension.has_value() ;
     }
 
     template <typename K, typename T>
     inline void add( T *ptr, bool isOwned = true ) {
-      std::type_index typeidx( typeid(K) ) ;
-      auto iter = _extensions.find( typeidx.hash_code() ) ;
-      if( iter != _extensions.end() ) {
-        MARLINMT_THROW( "Extension of type " + std::string(typeidx.name()) + " already present" ) ;
+      auto &slot = _slots[ slotIndex<K>() ] ;
+      if( slot._extension.has_value() ) {
+        MARLINMT_THROW( "Extension of type " + std::string(typeid(K).name()) + " already present" ) ;
       }
-      auto ext = std::make_shared<Extension>( ptr, isOwned ) ;
-      _extensions.insert( { typeidx.hash_code(), ext } ) ;
+      slot._extension.emplace( ptr, isOwned ) ;
+      slot._recyclable = false ;
+      ++ _size ;
     }
 
     template <typename K, typename T, typename ...Args>
     inline T* create( bool isOwned, Args ...args ) {
-      std::type_index typeidx( typeid(K) ) ;
-      auto iter = _extensions.find( typeidx.hash_code() ) ;
-      if( iter != _extensions.end() ) {
-        MARLINMT_THROW( "Extension of type " + std::string(typeidx.name()) + " already present" ) ;
+      auto &slot = _slots[ slotIndex<K>() ] ;
+      if( slot._extension.has_value() ) {
+        MARLINMT_THROW( "Extension of type " + std::string(typeid(K).name()) + " already present" ) ;
       }
-      auto ext = std::make_shared<Extension>( new T( args... ), isOwned ) ;
-      _extensions.insert( { typeidx.hash_code(), ext } ) ;
-      return ext->template object<T>() ;
+      auto ptr = new T( args... ) ;
+      slot._extension.emplace( ptr, isOwned ) ;
+      slot._recyclable = false ;
+      ++ _size ;
+      return ptr ;
+    }
+
+    /**
+     *  @brief  Create a recyclable extension, or reset the existing one.
+     *  If a recyclable extension of key type K is present, its reset() method
+     *  is called with the arguments, else a new T is constructed with them.
+     *  T must provide a reset() method taking the constructor arguments
+     *
+     *  @param  args the constructor/reset arguments
+     */
+    template <typename K, typename T, typename ...Args>
+    inline T* recyclable( Args &&...args ) {
+      auto &slot = _slots[ slotIndex<K>() ] ;
+      if( slot._extension.has_value() ) {
+        if( not slot._recyclable or slot._extension->type() != std::type_index(typeid(T)) ) {
+          MARLINMT_THROW( "Extension of type " + std::string(typeid(K).name()) + " already present" ) ;
+        }
+        auto ptr = slot._extension->template object<T>() ;
+        ptr->reset( std::forward<Args>(args)... ) ;
+        return ptr ;
+      }
+      auto ptr = new T( std::forward<Args>(args)... ) ;
+      slot._extension.emplace( ptr, true ) ;
+      slot._recyclable = true ;
+      ++ _size ;
+      return ptr ;
     }
 
     template <typename K, typename T>
     inline T *get() {
-      std::type_index typeidx( typeid(K) ) ;
-      auto iter = _extensions.find( typeidx.hash_code() ) ;
-      if( iter == _extensions.end() ) {
-        MARLINMT_THROW( "Extension of type " + std::string(typeidx.name()) + " doesn't exists" ) ;
+      auto &slot = _slots[ slotIndex<K>() ] ;
+      if( not slot._extension.has_value() ) {
+        MARLINMT_THROW( "Extension of type " + std::string(typeid(K).name()) + " doesn't exists" ) ;
       }
-      return iter->second->object<T>() ;
+      return slot._extension->template object<T>() ;
     }
 
     template <typename K, typename T>
     inline const T *get() const {
-      std::type_index typeidx( typeid(K) ) ;
-      auto iter = _extensions.find( typeidx.hash_code() ) ;
-      if( iter == _extensions.end() ) {
-        MARLINMT_THROW( "Extension of type " + std::string(typeidx.name()) + " doesn't exists" ) ;
+      auto &slot = _slots[ slotIndex<K>() ] ;
+      if( not slot._extension.has_value() ) {
+        MARLINMT_THROW( "Extension of type " + std::string(typeid(K).name()) + " doesn't exists" ) ;
       }
-      return iter->second->object<T>() ;
+      return slot._extension->template object<T>() ;
     }
 
     template <typename K>
     inline void remove() {
-      std::type_index typeidx( typeid(K) ) ;
-      auto iter = _extensions.find( typeidx.hash_code() ) ;
-      if( iter == _extensions.end() ) {
-        MARLINMT_THROW( "Extension of type " + std::string(typeidx.name()) + " doesn't exists" ) ;
+      auto &slot = _slots[ slotIndex<K>() ] ;
+      if( not slot._extension.has_value() ) {
+        MARLINMT_THROW( "Extension of type " + std::string(typeid(K).name()) + " doesn't exists" ) ;
       }
-      _extensions.erase( iter ) ;
+      slot._extension.reset() ;
+      -- _size ;
     }
 
+    /**
+     *  @brief  Remove all extensions except the recyclable ones
+     */
+    inline void recycle() {
+      for( auto &slot : _slots ) {
+        if( slot._extension.has_value() and not slot._recyclable ) {
+          slot._extension.reset() ;
+          -- _size ;
+        }
+      }
+    }
+
+    /**
+     *  @brief  Remove all extensions
+     */
+    inline void clear() {
+      for( auto &slot : _slots ) {
+        slot._extension.reset() ;
+      }
+      _size = 0 ;
+    }
+
+    /**
+     *  @brief  Get the number of extensions
+     */
+    inline std::size_t size() const {
+      return _size ;
+    }
+
+  private:
+    /**
+     *  @brief  Assign the next free slot index.
+     *  Throws if more than MaxSlots key types are used
+     *
+     *  @param  keyName the key type name, for error reporting
+     */
+    static std::size_t nextSlotIndex( const char *keyName ) ;
+
   private:
-    /// The extension map
-    ExtensionMap         _extensions {} ;
+    /// The extension slots, indexed by key type
+    SlotArray            _slots {} ;
+    /// The number of extensions
+    std::size_t          _size {0} ;
   };
 
 }
@@ -47,7 +47,8 @@ namespace marlinmt {
     virtual void processRunHeader( std::shared_ptr<RunHeader> rhdr ) = 0 ;
 
     /**
-     *  @brief  Push a new event to the scheduler for processing
+     *  @brief  Push a new event to the scheduler for processing.
+     *  Blocks until the scheduler can accept the event
      *
      *  @param  event the event to push
      */
@@ -64,6 +65,10 @@ namespace marlinmt {
      *  @brief  Get the number of free event slots
      */
     virtual std::size_t freeSlots() const = 0 ;
+
+  protected:
+    /// The scheduler type, read by the application to create the scheduler
+    StringParameter          _schedulerType {*this, "SchedulerType", "The scheduler type: Simple, PEP or DAG (default: Simple if nthreads=1, PEP otherwise)", ""} ;
   };
 
 } // end namespace marlinmt
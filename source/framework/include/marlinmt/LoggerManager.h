@@ -3,10 +3,12 @@
 
 // -- std headers
 #include <string>
+#include <memory>
 
 // -- marlinmt headers
 #include <marlinmt/Exceptions.h>
 #include <marlinmt/Logging.h>
+#include <marlinmt/AsyncLogger.h>
 #include <marlinmt/Component.h>
 
 namespace marlinmt {
@@ -49,12 +51,24 @@ namespace marlinmt {
      *  @param  name the logger name
      */
     Logger createLogger( const std::string &name ) const ;
+
+    /**
+     *  @brief  Get the asynchronous logger, writing to the log file if any,
+     *  else to the console. Returns nullptr if asynchronous logging is disabled
+     */
+    std::shared_ptr<AsyncLogger> asyncLogger() const ;
     
   private:
     /// The name of the log file (optional)
     StringParameter         _logfile {*this, "Logfile", "The name of the log file", "" } ;
     /// Whether to use a colored console printout
     BoolParameter           _coloredConsole {*this, "ColoredConsole", "Whether to use a colored console printout", false } ;
+    /// Whether to write the event processing lines with the asynchronous logger
+    BoolParameter           _asyncLogging {*this, "AsyncLogging", "Whether to write the event processing lines with the asynchronous logger (to the console or to <Logfile>.async)", false } ;
+    /// The asynchronous logger flush mode
+    StringParameter         _asyncFlushMode {*this, "AsyncFlushMode", "The asynchronous logger flush mode (line or event)", "line" } ;
+    /// The asynchronous logger
+    std::shared_ptr<AsyncLogger> _asyncLogger {nullptr} ;
   };
 
 } // end namespace marlinmt
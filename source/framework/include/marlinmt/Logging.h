@@ -4,6 +4,14 @@
 // -- streamlog headers
 #include <streamlog/streamlog.h>
 
+// -- marlinmt headers
+#include <marlinmt/MarlinMTConfig.h>
+
+// The lowest log level compiled in. Set with the CMake option MARLINMT_MIN_LOG_LEVEL
+#ifndef MARLINMT_MIN_LOG_LEVEL
+#define MARLINMT_MIN_LOG_LEVEL DEBUG
+#endif
+
 namespace marlinmt {
   
   namespace loglevel {
@@ -54,6 +62,42 @@ namespace marlinmt {
     using  streamlog::ERROR8 ;
     using  streamlog::ERROR9 ;
     using  streamlog::SILENT ;
+
+    /**
+     *  @brief  rank struct
+     *  The compile time rank and name of a log level:
+     *  DEBUG[0-9] < MESSAGE[0-9] < WARNING[0-9] < ERROR[0-9] < SILENT
+     */
+    template <class T>
+    struct rank ;
+
+#define MARLINMT_LOG_LEVEL_RANKS( LEVEL, BASE ) \
+    template <> struct rank<LEVEL> { static constexpr unsigned int value = BASE ; static constexpr const char *name = #LEVEL ; } ; \
+    template <> struct rank<LEVEL##0> { static constexpr unsigned int value = BASE ; static constexpr const char *name = #LEVEL "0" ; } ; \
+    template <> struct rank<LEVEL##1> { static constexpr unsigned int value = BASE + 1 ; static constexpr const char *name = #LEVEL "1" ; } ; \
+    template <> struct rank<LEVEL##2> { static constexpr unsigned int value = BASE + 2 ; static constexpr const char *name = #LEVEL "2" ; } ; \
+    template <> struct rank<LEVEL##3> { static constexpr unsigned int value = BASE + 3 ; static constexpr const char *name = #LEVEL "3" ; } ; \
+    template <> struct rank<LEVEL##4> { static constexpr unsigned int value = BASE + 4 ; static constexpr const char *name = #LEVEL "4" ; } ; \
+    template <> struct rank<LEVEL##5> { static constexpr unsigned int value = BASE + 5 ; static constexpr const char *name = #LEVEL "5" ; } ; \
+    template <> struct rank<LEVEL##6> { static constexpr unsigned int value = BASE + 6 ; static constexpr const char *name = #LEVEL "6" ; } ; \
+    template <> struct rank<LEVEL##7> { static constexpr unsigned int value = BASE + 7 ; static constexpr const char *name = #LEVEL "7" ; } ; \
+    template <> struct rank<LEVEL##8> { static constexpr unsigned int value = BASE + 8 ; static constexpr const char *name = #LEVEL "8" ; } ; \
+    template <> struct rank<LEVEL##9> { static constexpr unsigned int value = BASE + 9 ; static constexpr const char *name = #LEVEL "9" ; } ;
+
+    MARLINMT_LOG_LEVEL_RANKS( DEBUG, 0 )
+    MARLINMT_LOG_LEVEL_RANKS( MESSAGE, 10 )
+    MARLINMT_LOG_LEVEL_RANKS( WARNING, 20 )
+    MARLINMT_LOG_LEVEL_RANKS( ERROR, 30 )
+    template <> struct rank<SILENT> { static constexpr unsigned int value = 40 ; static constexpr const char *name = "SILENT" ; } ;
+
+#undef MARLINMT_LOG_LEVEL_RANKS
+
+    /// The rank of the lowest log level compiled in
+    constexpr unsigned int minRank = rank<MARLINMT_MIN_LOG_LEVEL>::value ;
+
+    /// Whether a log level is compiled in. If not, the lazy logging statements are removed
+    template <class T>
+    constexpr bool compiled = ( rank<T>::value >= minRank ) ;
   }
   
   using namespace loglevel ;
@@ -86,6 +130,13 @@ namespace marlinmt {
      *  @brief  Get the global streamlog logger. Returns a reference
      */
     static DefaultLoggerType &globalLogger() ;
+
+    /**
+     *  @brief  Get the rank of a log level name, as loglevel::rank
+     *
+     *  @param  level the log level name
+     */
+    static unsigned int levelRank( const std::string &level ) ;
   };
 
 }
@@ -5,12 +5,16 @@
 #include <marlinmt/Component.h>
 #include <marlinmt/EventStore.h>
 #include <marlinmt/RunHeader.h>
+#include <marlinmt/RandomSeedManager.h>
+#include <marlinmt/CompiledConditions.h>
 #include <marlinmt/MarlinMTConfig.h>  // for Marlin version macros
 
 // -- std headers
 #include <map>
+#include <set>
 #include <string>
 #include <memory>
+#include <optional>
 #include <iostream>
 #include <sstream>
 
@@ -42,6 +46,7 @@ namespace marlinmt {
    */
   class Processor : public Component {
     friend class ProcessorApi ;
+    friend class ProcessorConditionsExtension ;
 
   private:
     // prevent users from making (default) copies of processors
@@ -57,10 +62,12 @@ namespace marlinmt {
      */
     enum class ERuntimeOption {
       eCritical,     /// Whether the processor has to be executed in a critical section
-      eClone         /// Whether the processor must be cloned in each thread worker
+      eClone,        /// Whether the processor must be cloned in each thread worker
+      eOrdered       /// Whether the processor must see the events in input order
     };
 
     using RuntimeOptions = std::map<ERuntimeOption, bool> ;
+    using CollectionNames = std::set<std::string> ;
 
   public:
     /**
@@ -104,6 +111,24 @@ namespace marlinmt {
      */
     std::optional<bool> runtimeOption( ERuntimeOption option ) const ;
 
+    /**
+     *  @brief  Get the names of the event collections read by the processor.
+     *  See ProcessorApi::declareInputCollection()
+     */
+    const CollectionNames &inputCollections() const ;
+
+    /**
+     *  @brief  Get the names of the event collections written by the processor.
+     *  See ProcessorApi::declareOutputCollection()
+     */
+    const CollectionNames &outputCollections() const ;
+
+    /**
+     *  @brief  Whether the processor may skip events.
+     *  True unless declared otherwise, see ProcessorApi::declareNoEventSkip()
+     */
+    bool canSkipEvents() const ;
+
   protected:
     /**
      *  @brief  Force the runtime option to a given boolean value.
@@ -121,6 +146,12 @@ namespace marlinmt {
      *  @code{cpp}
      *  forceRuntimeOption( RuntimeOption::Critical, true ) ;
      *  @endcode
+     *  Some processors, like output processors, must receive the events in
+     *  the order they were read. Such processors are never cloned and run in
+     *  a single commit thread in the input order. Do to so, call:
+     *  @code{cpp}
+     *  forceRuntimeOption( RuntimeOption::Ordered, true ) ;
+     *  @endcode
      *  If a runtime option is forced in the code and the steering file tries
      *  to overwrite it, an exception will be raised.
      *
@@ -140,6 +171,16 @@ namespace marlinmt {
   private:
     /// The user forced runtime options for parallel processing
     RuntimeOptions                     _forcedRuntimeOptions {} ;
+    /// The names of the event collections read by the processor
+    CollectionNames                    _inputCollections {} ;
+    /// The names of the event collections written by the processor
+    CollectionNames                    _outputCollections {} ;
+    /// Whether the processor may skip events
+    bool                               _canSkipEvents {true} ;
+    /// The random seed key, set by ProcessorApi::registerForRandomSeeds()
+    std::optional<RandomSeedManager::EntryKey> _randomSeedKey {} ;
+    /// The return value slots in the runtime conditions, see ProcessorConditionsExtension
+    mutable CompiledConditions::ValueSlots _valueSlots {} ;
   };
 
 } // end namespace marlinmt
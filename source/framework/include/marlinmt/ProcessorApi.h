@@ -392,6 +392,36 @@ namespace marlinmt {
      */
     static void registerForRandomSeeds( Processor *const proc ) ;
 
+    /**
+     *  @brief  Declare an event collection read by the processor.
+     *  Used by schedulers running processors of the same event concurrently
+     *  (see DAGScheduler) to build the processor dependency graph.
+     *  Must be called in Processor::init()
+     *
+     *  @param  proc the processor instance
+     *  @param  name the collection name
+     */
+    static void declareInputCollection( Processor *const proc, const std::string &name ) ;
+
+    /**
+     *  @brief  Declare an event collection written by the processor.
+     *  See declareInputCollection()
+     *
+     *  @param  proc the processor instance
+     *  @param  name the collection name
+     */
+    static void declareOutputCollection( Processor *const proc, const std::string &name ) ;
+
+    /**
+     *  @brief  Declare that the processor never skips events.
+     *  A processor that may skip events is a barrier for all the processors
+     *  after it in schedulers running processors of the same event
+     *  concurrently (see DAGScheduler). Must be called in Processor::init()
+     *
+     *  @param  proc the processor instance
+     */
+    static void declareNoEventSkip( Processor *const proc ) ;
+
     /**
      *  @brief  Get a random seed from the event.
      *  Your processor must have been registered beforehand using registerForRandomSeeds()
@@ -448,6 +478,19 @@ namespace marlinmt {
      */
     static void skipCurrentEvent( const Processor *const proc ) ;
 
+    /**
+     *  @brief  Notify the application to skip the current event processing
+     *  and go directly to the next event by skipping next processors in the sequence.
+     *  Unlike the overload above, this one doesn't throw: it flags the event and
+     *  the sequence stops after the calling processor. The processor must return
+     *  from processEvent() after this call. Prefer this version in filter processors
+     *  skipping many events, as exception unwinding serializes the worker threads
+     *
+     *  @param  proc the processor instance initiating the call
+     *  @param  event the event to skip
+     */
+    static void skipCurrentEvent( const Processor *const proc, EventStore *event ) ;
+
     /**
      *  @brief  Abort program execution properly
      *
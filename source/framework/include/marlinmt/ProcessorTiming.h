@@ -0,0 +1,97 @@
+#ifndef MARLINMT_PROCESSORTIMING_h
+#define MARLINMT_PROCESSORTIMING_h 1
+
+// -- std headers
+#include <string>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// -- marlinmt headers
+#include <marlinmt/Utils.h>
+
+namespace marlinmt {
+
+  /**
+   *  @brief  TimingMode enumerator
+   *  How the processor calls are timed by the sequences
+   */
+  enum class TimingMode {
+    Full,       ///< Time every call with the steady clock
+    Sampled,    ///< Time one call in N per processor with the steady clock
+    Fast        ///< Time every call with the fast clock (see fastclock)
+  };
+
+  /**
+   *  @brief  Convert a string ("full", "sampled" or "fast") to a timing mode.
+   *  Throws on unknown mode
+   *
+   *  @param  mode the timing mode name
+   */
+  TimingMode timingModeFromString( const std::string &mode ) ;
+
+  /**
+   *  @brief  Convert a timing mode to its name
+   *
+   *  @param  mode the timing mode
+   */
+  std::string timingModeToString( TimingMode mode ) ;
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  /**
+   *  @brief  fastclock class
+   *  A cheaper clock than the steady clock for timing many short calls.
+   *  On x86 it reads the time stamp counter, calibrated once against the
+   *  steady clock on first use. Elsewhere it reads CLOCK_MONOTONIC_COARSE,
+   *  which has a resolution of a few ms: single short calls then mostly
+   *  read 0 but the sums over many calls remain unbiased
+   */
+  class fastclock {
+  public:
+    using ticks_type = std::uint64_t ;
+
+  public:
+    // static API only
+    fastclock() = delete ;
+    ~fastclock() = delete ;
+
+  public:
+    /**
+     *  @brief  Get the current tick count
+     */
+    static ticks_type now() {
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc() ;
+#else
+      timespec ts ;
+      clock_gettime( CLOCK_MONOTONIC_COARSE, &ts ) ;
+      return static_cast<ticks_type>( ts.tv_sec ) * 1000000000ull + ts.tv_nsec ;
+#endif
+    }
+
+    /**
+     *  @brief  Get the duration of one tick (unit: seconds).
+     *  The first call performs the calibration (about 20 ms)
+     */
+    static double secondsPerTick() ;
+
+    /**
+     *  @brief  Get the time difference between two tick counts (unit: seconds)
+     *
+     *  @param  older the oldest tick count
+     *  @param  ealier the earliest tick count
+     */
+    static clock::duration_rep time_difference( ticks_type older, ticks_type ealier ) {
+      return static_cast<clock::duration_rep>( static_cast<double>( ealier - older ) * secondsPerTick() ) ;
+    }
+  };
+
+} // end namespace marlinmt
+
+#endif
@@ -2,18 +2,26 @@
 #define MARLINMT_RANDOMSEEDMANAGER_h 1
 
 // -- std headers
-#include <map>
-#include <random>
-#include <memory>
+#include <ctime>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <cstdint>
 #include <functional>
 #include <unordered_set>
 
 namespace marlinmt {
 
-  class EventStore ;
-
   /**
    *  @brief  RandomSeedManager class
+   *  Counter-based random seed generation.
+   *
+   *  The seed of an entry (processor) for an event is a SplitMix64 hash of the
+   *  global seed, the event unique id and a key derived from the entry name.
+   *  No state is stored per event: the seeds are computed on request in the
+   *  thread asking for them (see RandomSeedExtension). The seeds only depend on
+   *  the global seed, the event uid and the entry name, so they are reproducible
+   *  whatever the number of threads and whether processors are cloned or not.
    */
   class RandomSeedManager {
   public:
@@ -28,9 +36,8 @@ namespace marlinmt {
     typedef const void *                                        HashArgument ;
     typedef std::size_t                                         HashResult ;
     typedef std::unordered_set<HashResult>                      EntryList ;
-    typedef std::map<HashResult, SeedType>                      RandomSeedMap ;
-    typedef std::mt19937                                        RandomGenerator ;
-    typedef std::uniform_int_distribution<SeedType>             RandomDistribution ;
+    typedef std::uint64_t                                       EntryKey ;
+    typedef std::uint64_t                                       EventSeed ;
     // constants
     static const SeedType MinSeed = 0 ;
     static const SeedType MaxSeed = std::numeric_limits<SeedType>::max() ;
@@ -44,43 +51,57 @@ namespace marlinmt {
     RandomSeedManager( SeedType globalSeed = static_cast<unsigned int>(time(nullptr)) ) ;
 
     /**
-     *  @brief  Add an entry to the random seed manager
+     *  @brief  Set the global seed. Must be called before processing events
+     *
+     *  @param  globalSeed the global seed
+     */
+    void setGlobalSeed( SeedType globalSeed ) ;
+
+    /**
+     *  @brief  Get the global seed
+     */
+    SeedType globalSeed() const ;
+
+    /**
+     *  @brief  Add an entry to the random seed manager. Thread safe.
+     *  Throws if the entry is already registered. Entries with the same
+     *  name (e.g. processor clones) get the same key, thus the same seeds
      *
-     *  @param  entry a hash ideintifying the entry
+     *  @param  arg the entry instance
+     *  @param  name the entry name
      */
-    void addEntry( HashResult entry ) ;
+    EntryKey addEntry( HashArgument arg, const std::string &name ) ;
 
     /**
-     *  @brief  Add an entry to the random seed manager
+     *  @brief  Compute the seed of an event, from which the entry seeds are derived
      *
-     *  @param  entry a hash ideintifying the entry
+     *  @param  uid the event unique id
      */
-    void addEntry( HashArgument arg ) ;
+    EventSeed eventSeed( std::size_t uid ) const ;
 
     /**
-     *  @brief  Generate a random seed map.
-     *  Mainly used by the whiteboard to get random seeds
-     *  which are local for a given event context
+     *  @brief  Compute the random seed of an entry for an event
      *
-     *  @param  evt the event source
+     *  @param  evtSeed the event seed (see eventSeed())
+     *  @param  key the entry key (see addEntry())
      */
-    std::unique_ptr<RandomSeedMap> generateRandomSeeds( const EventStore * const evt ) ;
+    static SeedType randomSeed( EventSeed evtSeed, EntryKey key ) ;
 
   private:
     /**
-     *  @brief  Get a new random number from the internal generator
+     *  @brief  The SplitMix64 mixing function
+     *
+     *  @param  value the value to mix
      */
-    SeedType getRandom() ;
+    static std::uint64_t splitmix( std::uint64_t value ) ;
 
   private:
-    /// The global random seed, if set
+    /// The global random seed
     SeedType                _globalSeed {0} ;
-    /// The entry list
+    /// The registered entry instances
     EntryList               _entryList {} ;
-    /// The random generator engine
-    RandomGenerator         _generator {_globalSeed} ;
-    /// The random number distribution
-    RandomDistribution      _rdmDistribution {MinSeed, MaxSeed} ;
+    /// The mutex protecting the entry list
+    std::mutex              _mutex {} ;
   };
 
 } // end namespace marlinmt
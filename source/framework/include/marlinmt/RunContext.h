@@ -0,0 +1,108 @@
+#ifndef MARLINMT_RUNCONTEXT_h
+#define MARLINMT_RUNCONTEXT_h 1
+
+// -- std headers
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+// -- marlinmt headers
+#include <marlinmt/Utils.h>
+
+namespace marlinmt {
+
+  class RunHeader ;
+
+  /**
+   *  @brief  RunContext class
+   *  Keeps track of the run headers read by the application as a list of
+   *  epochs. Each new run header opens a new epoch. Epoch 0 is the epoch
+   *  before the first run header.
+   *
+   *  Events are tagged with the epoch in which they were read (see
+   *  RunContextExtension). Processor sequences apply the pending run headers
+   *  to their processors before processing the first event of a new epoch,
+   *  instead of draining the whole thread pool at each run boundary.
+   *  Processors shared between sequences need a barrier: they can only
+   *  switch epoch once all events of the previous epochs are finished.
+   *  The RunContext keeps the number of in-flight events per epoch for this
+   *  purpose. All methods are thread safe.
+   */
+  class RunContext {
+  public:
+    using Epoch = std::size_t ;
+    using RunHeaderList = std::vector<std::shared_ptr<RunHeader>> ;
+    using EpochCounterMap = std::map<Epoch, std::size_t> ;
+
+  public:
+    RunContext() = default ;
+    ~RunContext() = default ;
+    RunContext(const RunContext &) = delete ;
+    RunContext &operator=(const RunContext &) = delete ;
+
+    /**
+     *  @brief  Add a new run header, opening a new epoch.
+     *  Returns the new epoch number
+     *
+     *  @param  rhdr the run header
+     */
+    Epoch addRunHeader( std::shared_ptr<RunHeader> rhdr ) ;
+
+    /**
+     *  @brief  Get the current (latest) epoch
+     */
+    Epoch currentEpoch() const ;
+
+    /**
+     *  @brief  Get the run header that opened the given epoch.
+     *  Returns nullptr for epoch 0
+     *
+     *  @param  epoch the epoch number
+     */
+    std::shared_ptr<RunHeader> runHeader( Epoch epoch ) const ;
+
+    /**
+     *  @brief  Notify that an event of the given epoch entered processing
+     *
+     *  @param  epoch the event epoch
+     */
+    void eventStarted( Epoch epoch ) ;
+
+    /**
+     *  @brief  Notify that an event of the given epoch has been processed
+     *
+     *  @param  epoch the event epoch
+     */
+    void eventFinished( Epoch epoch ) ;
+
+    /**
+     *  @brief  Block until all events of the epochs older than the given
+     *  epoch are finished
+     *
+     *  @param  epoch the epoch to reach
+     */
+    void waitPreviousEpochs( Epoch epoch ) ;
+
+    /**
+     *  @brief  Get the total time spent in waitPreviousEpochs() (unit seconds)
+     */
+    clock::duration_rep barrierTime() const ;
+
+  private:
+    ///< The synchronization mutex
+    mutable std::mutex                _mutex {} ;
+    ///< The condition variable notified when an epoch gets empty
+    std::condition_variable           _conditionVariable {} ;
+    ///< The list of run headers. Epoch N maps to index N-1
+    RunHeaderList                     _runHeaders {} ;
+    ///< The number of in-flight events per epoch
+    EpochCounterMap                   _inFlightEvents {} ;
+    ///< The total time spent waiting for older epochs
+    clock::duration_rep               _barrierTime {0} ;
+  };
+
+} // end namespace marlinmt
+
+#endif
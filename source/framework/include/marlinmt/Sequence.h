@@ -7,12 +7,19 @@
 #include <memory>
 #include <map>
 #include <mutex>
+#include <atomic>
 #include <utility> // pair
 #include <ctime>
+#include <optional>
+#include <cstdint>
 
 // -- marlinmt headers
 #include <marlinmt/Logging.h>
 #include <marlinmt/Utils.h>
+#include <marlinmt/RunContext.h>
+#include <marlinmt/CompiledConditions.h>
+#include <marlinmt/ProcessorTiming.h>
+#include <marlinmt/concurrency/CacheLine.h>
 
 namespace marlinmt {
 
@@ -22,6 +29,7 @@ namespace marlinmt {
   class EventStore ;
   class RunHeader ;
   class ConfigSection ;
+  class ProcessorConditionsExtension ;
 
   //--------------------------------------------------------------------------
   //--------------------------------------------------------------------------
@@ -47,8 +55,9 @@ namespace marlinmt {
      *
      *  @param  proc a pointer on a processor
      *  @param  lock the mutex instance to use
+     *  @param  shared whether the item is shared by multiple sequences
      */
-    SequenceItem( std::shared_ptr<Processor> proc, std::shared_ptr<std::mutex> lock ) ;
+    SequenceItem( std::shared_ptr<Processor> proc, std::shared_ptr<std::mutex> lock, bool shared = false ) ;
 
     /**
      *  @brief  Process the run header
@@ -57,6 +66,20 @@ namespace marlinmt {
      */
     void processRunHeader( std::shared_ptr<RunHeader> rhdr ) ;
 
+    /**
+     *  @brief  Apply the pending run headers of the run context up to the given
+     *  epoch. Shared items first wait for all events of older epochs to finish.
+     *
+     *  @param  context the run context
+     *  @param  epoch the epoch to reach
+     */
+    void updateRunEpoch( RunContext &context, RunContext::Epoch epoch ) ;
+
+    /**
+     *  @brief  Get the total time spent in updateRunEpoch() processing run headers
+     */
+    clock::duration_rep runHeaderClock() const ;
+
     /**
      *  @brief  Call Processor::processEvent. Lock if the mutex has been initialized.
      *  Call time is returned in a pair as :
@@ -67,6 +90,21 @@ namespace marlinmt {
      */
     clock::pair processEvent( std::shared_ptr<EventStore> event ) ;
 
+    /**
+     *  @brief  Same as processEvent() but timed with the fast clock (see fastclock)
+     *
+     *  @param  event the event to process
+     */
+    clock::pair processEventFast( std::shared_ptr<EventStore> event ) ;
+
+    /**
+     *  @brief  Call Processor::processEvent without timing the call.
+     *  Lock if the mutex has been initialized
+     *
+     *  @param  event the event to process
+     */
+    void processEventUntimed( std::shared_ptr<EventStore> event ) ;
+
     /**
      *  @brief  Call Processor::modifyEvent. Lock if the mutex has been initialized
      *  Call time is returned in a pair as :
@@ -87,11 +125,29 @@ namespace marlinmt {
      */
     const std::string &name() const ;
 
+    /**
+     *  @brief  Whether the processor is called in a critical section
+     */
+    bool critical() const ;
+
+    /**
+     *  @brief  Whether the item is shared by multiple sequences
+     */
+    bool shared() const ;
+
   private:
     ///< The processor instance
     std::shared_ptr<Processor>     _processor {nullptr} ;
     ///< The mutex instance
     std::shared_ptr<std::mutex>    _mutex {nullptr} ;
+    ///< Whether the item is shared by multiple sequences
+    bool                           _shared {false} ;
+    ///< The run epoch of the processor
+    std::atomic<RunContext::Epoch> _runEpoch {0} ;
+    ///< The mutex protecting run epoch updates of shared items
+    std::mutex                     _runEpochMutex {} ;
+    ///< The time spent processing run headers in updateRunEpoch()
+    clock::duration_rep            _runHeaderClock {0} ;
   };
 
   //--------------------------------------------------------------------------
@@ -108,6 +164,30 @@ namespace marlinmt {
     clock::duration_rep   _procClock {0.} ;
     /// The event counter
     int                   _counter {0} ;
+    /// The number of timed events (less than _counter in sampled timing mode)
+    int                   _timed {0} ;
+
+    /**
+     *  @brief  Get the factor scaling the clocks of the timed events to all events
+     */
+    double timedScale() const {
+      return ( _timed > 0 ) ? static_cast<double>( _counter ) / _timed : 0. ;
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  /**
+   *  @brief  ItemStatistics struct
+   *  Per item statistics of a sequence. Each entry fills its own cache line
+   *  so that the statistics of sequences run by different threads never share one
+   */
+  struct alignas(concurrency::CacheLineSize) ItemStatistics {
+    /// The clock measurements of the item
+    ClockMeasure          _clock {} ;
+    /// The number of events skipped by the item
+    int                   _skipped {0} ;
   };
 
   //--------------------------------------------------------------------------
@@ -130,15 +210,21 @@ namespace marlinmt {
     using Container = std::vector<std::shared_ptr<SequenceItem>> ;
     using Index = Container::size_type ;
     using SizeType = Container::size_type ;
-    using ClockMeasureMap = std::map<std::string, ClockMeasure> ;
-    using SkippedEventMap = std::map<std::string, int> ;
+    using Statistics = std::vector<ItemStatistics> ;
 
   public:
-    Sequence() = default ;
+    Sequence() = delete ;
     ~Sequence() = default ;
     Sequence &operator=(const Sequence &) = delete ;
     Sequence(const Sequence &) = delete ;
 
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  runContext the run context shared by all sequences
+     */
+    Sequence( std::shared_ptr<RunContext> runContext ) ;
+
   public:
     /**
      *  @brief  Create a sequence item. The item is not added.
@@ -146,8 +232,9 @@ namespace marlinmt {
      *
      *  @param  processor a processor pointer
      *  @param  lock the lock to use on processEvent/modifyEvent calls
+     *  @param  shared whether the item is shared by multiple sequences
      */
-    std::shared_ptr<SequenceItem> createItem( std::shared_ptr<Processor> processor, std::shared_ptr<std::mutex> lock ) const ;
+    std::shared_ptr<SequenceItem> createItem( std::shared_ptr<Processor> processor, std::shared_ptr<std::mutex> lock, bool shared = false ) const ;
 
     /**
      *  @brief  Add an item to the sequence
@@ -176,34 +263,127 @@ namespace marlinmt {
     void processRunHeader( std::shared_ptr<RunHeader> rhdr ) ;
 
     /**
-     *  @brief  Process the event. Call processEvent() for each item in the sequence
+     *  @brief  Process the event. Call processEvent() for each item in the sequence.
+     *  If the event carries a run epoch (see RunContextExtension), the pending
+     *  run headers are applied to each item before processing the event.
+     *  The items whose condition is known to be false with the processor return
+     *  values set so far are not iterated over. Returns false if a processor
+     *  requested to skip the event or if the conditions of all the remaining
+     *  items of the sequence are false (early release, the event is finished)
      *
      *  @param  event the event to process
      */
-    void processEvent( std::shared_ptr<EventStore> event ) ;
+    bool processEvent( std::shared_ptr<EventStore> event ) ;
+
+    /**
+     *  @brief  Process the event with the items in the range [begin, end) only.
+     *  The items before begin must have been run and the items after end must
+     *  be run afterwards, in order. See processEvent() for details
+     *
+     *  @param  event the event to process
+     *  @param  begin the index of the first item to run
+     *  @param  end the index after the last item to run
+     */
+    bool processEvent( std::shared_ptr<EventStore> event, Index begin, Index end ) ;
+
+    /**
+     *  @brief  Process the event with a single item of the sequence.
+     *  Check the processor condition and update the clock measurements.
+     *  Returns false if the processor requested to skip the event.
+     *  No early release as the items may run out of order (see DAGScheduler)
+     *
+     *  @param  event the event to process
+     *  @param  index the index of the item to run
+     */
+    bool processEvent( std::shared_ptr<EventStore> event, Index index ) ;
+
+    /**
+     *  @brief  Set how the processor calls are timed
+     *
+     *  @param  mode the timing mode
+     *  @param  sampling the fraction of timed calls is 1/sampling in sampled mode
+     */
+    void setTiming( TimingMode mode, unsigned int sampling ) ;
 
     /**
-     *  @brief  Generate a clock measure summary of all items
+     *  @brief  Generate a clock measure summary of all items.
+     *  In sampled timing mode, the clocks are scaled to all events
      */
     ClockMeasure clockMeasureSummary() const ;
 
     /**
-     *  @brief  Get all the clock measurements of the sequence
+     *  @brief  Get the total application and processor times of all items (unit: seconds).
+     *  Unlike clockMeasureSummary(), can be called while another thread processes events
      */
-    const ClockMeasureMap &clockMeasures() const ;
+    clock::pair clockTotals() const ;
 
     /**
-     *  @brief  Get all the skipped events of the sequence
+     *  @brief  Get the number of events released early, as no remaining item could run
      */
-    const SkippedEventMap &skippedEvents() const ;
+    std::size_t releasedEvents() const ;
+
+    /**
+     *  @brief  Get the statistics of the item at the specified index
+     *
+     *  @param  index the item index
+     */
+    const ItemStatistics &statistics( Index index ) const ;
 
   private:
+    /**
+     *  @brief  Look up the condition index of each item in the compiled conditions
+     *
+     *  @param  conditions the compiled runtime conditions
+     */
+    void resolveConditions( const std::shared_ptr<const CompiledConditions> &conditions ) ;
+
+    /**
+     *  @brief  Process the event with the items in the range [begin, end)
+     *
+     *  @param  event the event to process
+     *  @param  begin the index of the first item to run
+     *  @param  end the index after the last item to run
+     *  @param  earlyRelease whether to finish the event if no item after end can run
+     */
+    bool processItems( const std::shared_ptr<EventStore> &event, Index begin, Index end, bool earlyRelease ) ;
+
+    /**
+     *  @brief  Get the index of the next item from index whose condition is not known
+     *  to be false, or limit if none before limit
+     *
+     *  @param  extension the processor conditions of the event
+     *  @param  index the index of the first item to check
+     *  @param  limit the index to stop at
+     */
+    Index nextItem( const ProcessorConditionsExtension &extension, Index index, Index limit ) const ;
+
+  private:
+    ///< The run context shared by all sequences
+    std::shared_ptr<RunContext>     _runContext {nullptr} ;
     ///< The sequence items (processor list)
     Container                       _items {} ;
-    ///< The processor clock measurements
-    ClockMeasureMap                 _clockMeasures {} ;
-    ///< The map of skipped events
-    SkippedEventMap                 _skipEventMap {} ;
+    ///< The item statistics, indexed as the items
+    Statistics                      _statistics {} ;
+    ///< The compiled conditions the item condition indices refer to
+    std::shared_ptr<const CompiledConditions>  _conditions {nullptr} ;
+    ///< The condition index of each item
+    std::vector<CompiledConditions::Index>     _conditionIndices {} ;
+    ///< The index of the next item without condition from each index, the items always run
+    std::vector<Index>              _nextUnconditioned {} ;
+    ///< The compiled conditions the indices are resolved for, published to the other threads
+    std::atomic<const CompiledConditions*>  _resolvedConditions {nullptr} ;
+    ///< The mutex serialising the resolution of the condition indices
+    std::mutex                      _conditionsMutex {} ;
+    ///< The number of events released early
+    std::size_t                     _nReleased {0} ;
+    ///< How the processor calls are timed
+    TimingMode                      _timingMode {TimingMode::Full} ;
+    ///< The fraction of timed calls is 1/_timingSampling in sampled mode
+    unsigned int                    _timingSampling {1} ;
+    ///< The total application time of all items (unit: ns)
+    std::atomic<std::uint64_t>      _appClockTotal {0} ;
+    ///< The total processor time of all items (unit: ns)
+    std::atomic<std::uint64_t>      _procClockTotal {0} ;
   };
 
   //--------------------------------------------------------------------------
@@ -255,7 +435,8 @@ namespace marlinmt {
      *  The processor is added to each sequence. Depending on
      *  the parameter "ProcessorClone" and the processor forced
      *  runtime policy, the processor is either cloned for each
-     *  sequence or shared by all sequences
+     *  sequence or shared by all sequences. Processors flagged as
+     *  ordered (parameter "ProcessorOrdered") are always shared
      *
      *  @param  parameters the processor input parameters
      */
@@ -266,6 +447,21 @@ namespace marlinmt {
      */
     SizeType size() const ;
 
+    /**
+     *  @brief  Get the index of the first ordered processor in the sequences.
+     *  Equal to the number of processors if no processor is ordered.
+     *  In a parallel scheduler, the items from this index must run in a single
+     *  thread in the input order, using the commit sequence
+     */
+    Sequence::Index commitIndex() const ;
+
+    /**
+     *  @brief  Get the commit sequence. It holds the same items as the first
+     *  sequence with its own statistics. Only the items from commitIndex()
+     *  must be run with this sequence
+     */
+    std::shared_ptr<Sequence> commitSequence() const ;
+
     /**
      *  @brief  Call Processor::baseInit(app) for all processors
      *
@@ -273,6 +469,25 @@ namespace marlinmt {
      */
     void init( Application *app ) ;
 
+    /**
+     *  @brief  Call Processor::baseInit(app) for the processors shared by
+     *  multiple sequences only. The processors owned by a single sequence
+     *  (clones) must then be set up with initSequence()
+     *
+     *  @param  app the application in which the processors run
+     */
+    void initShared( Application *app ) ;
+
+    /**
+     *  @brief  Call Processor::baseInit(app) for the processors owned by
+     *  the given sequence only. Call it from the thread running the sequence
+     *  for the per-thread data to be allocated on the memory node of this thread
+     *
+     *  @param  app the application in which the processors run
+     *  @param  index the sequence index
+     */
+    void initSequence( Application *app, Index index ) ;
+
     /**
      *  @brief  Process the run header. Call processRunHeader() for each item in the sequence
      *
@@ -280,11 +495,36 @@ namespace marlinmt {
      */
     void processRunHeader( std::shared_ptr<RunHeader> rhdr ) ;
 
+    /**
+     *  @brief  Get the run context shared by all sequences
+     */
+    RunContext &runContext() ;
+
+    /**
+     *  @brief  Apply all pending run headers of the run context to all processors.
+     *  Must be called when no event is in flight
+     */
+    void updateRunEpoch() ;
+
+    /**
+     *  @brief  Get the total time spent by all processors on
+     *  run headers applied from the run context
+     */
+    clock::duration_rep runHeaderClock() const ;
+
     /**
      *  @brief  Call Processor::end() for all processors
      */
     void end() ;
 
+    /**
+     *  @brief  Set how the processor calls are timed in all sequences
+     *
+     *  @param  mode the timing mode
+     *  @param  sampling the fraction of timed calls is 1/sampling in sampled mode
+     */
+    void setTiming( TimingMode mode, unsigned int sampling ) ;
+
     /**
      *  @brief  Print statistics at end of application
      *
@@ -293,10 +533,20 @@ namespace marlinmt {
     void printStatistics( Logging::Logger logger ) const ;
 
   private:
+    ///< The run context shared by all sequences
+    std::shared_ptr<RunContext> _runContext {std::make_shared<RunContext>()} ;
     ///< The list of sequences
     Sequences                  _sequences {} ;
     ///< A unique list of sequence items
     SequenceItemList           _uniqueItems {} ;
+    ///< The sequence running the ordered part in the commit thread
+    std::shared_ptr<Sequence>  _commitSequence {nullptr} ;
+    ///< The index of the first ordered processor
+    std::optional<Sequence::Index> _commitIndex {} ;
+    ///< How the processor calls are timed
+    TimingMode                 _timingMode {TimingMode::Full} ;
+    ///< The fraction of timed calls is 1/_timingSampling in sampled mode
+    unsigned int               _timingSampling {1} ;
   };
 
 } // end namespace marlinmt
@@ -0,0 +1,23 @@
+#ifndef MARLINMT_CONCURRENCY_CACHELINE_h
+#define MARLINMT_CONCURRENCY_CACHELINE_h 1
+
+// -- std headers
+#include <cstddef>
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    /**
+     *  @brief  The assumed size of a cache line, in bytes.
+     *  Used to align data accessed concurrently by different threads
+     *  and avoid false sharing. 64 bytes is the cache line size of all
+     *  x86_64 and most aarch64 processors.
+     */
+    constexpr std::size_t CacheLineSize = 64 ;
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
+
+#endif
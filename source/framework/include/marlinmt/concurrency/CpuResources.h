@@ -0,0 +1,87 @@
+#ifndef MARLINMT_CONCURRENCY_CPURESOURCES_h
+#define MARLINMT_CONCURRENCY_CPURESOURCES_h 1
+
+// -- std headers
+#include <optional>
+#include <vector>
+#include <string>
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    /**
+     *  @brief  AffinityPolicy enumerator
+     *  How worker threads are pinned on CPUs
+     */
+    enum class AffinityPolicy {
+      None,       ///< No pinning, the OS places the threads
+      Compact,    ///< Fill the CPUs of a NUMA node before using the next node
+      Scatter,    ///< Distribute the workers round-robin over the NUMA nodes
+      List        ///< Use an explicit CPU list
+    };
+
+    /**
+     *  @brief  Convert a string ("none", "compact", "scatter" or "list")
+     *  to an affinity policy. Throws on unknown policy
+     *
+     *  @param  policy the policy name
+     */
+    AffinityPolicy affinityPolicyFromString( const std::string &policy ) ;
+
+    /**
+     *  @brief  Get the CPU limit set on the process cgroup, in number of CPUs.
+     *  The process cgroup is read from /proc/self/cgroup. The limit is the lowest
+     *  one set on this cgroup and its parents, from the cgroup v2 "cpu.max" files
+     *  or the cgroup v1 "cpu.cfs_quota_us" and "cpu.cfs_period_us" files. Returns
+     *  an empty optional if no limit is set or if the cgroup files can't be read
+     *  (e.g not on linux)
+     *
+     *  @param  procCgroup the file listing the process cgroups
+     *  @param  cgroupRoot the cgroup file system mount point
+     */
+    std::optional<double> cgroupCpuLimit( const std::string &procCgroup = "/proc/self/cgroup", const std::string &cgroupRoot = "/sys/fs/cgroup" ) ;
+
+    /**
+     *  @brief  Get the number of CPUs the process can use: the allowed CPUs,
+     *  bounded by the cgroup CPU limit rounded up. Never 0
+     */
+    unsigned int availableCpus() ;
+
+    /**
+     *  @brief  Get the list of CPUs the process is allowed to run on.
+     *  Falls back to [0, hardware concurrency) if the affinity mask is not available
+     */
+    std::vector<unsigned int> allowedCpus() ;
+
+    /**
+     *  @brief  Get the NUMA node of a CPU. Returns 0 if unknown (single node machines, not on linux)
+     *
+     *  @param  cpu the CPU id
+     */
+    unsigned int cpuNode( unsigned int cpu ) ;
+
+    /**
+     *  @brief  Compute the CPU of each worker for the given policy. Returns an
+     *  empty list for AffinityPolicy::None. Workers are assigned the CPUs modulo
+     *  the number of CPUs if there are more workers than CPUs
+     *
+     *  @param  policy the affinity policy
+     *  @param  nworkers the number of workers
+     *  @param  cpuList the explicit CPU list (AffinityPolicy::List only)
+     */
+    std::vector<unsigned int> workerCpus( AffinityPolicy policy, std::size_t nworkers, const std::vector<unsigned int> &cpuList = {} ) ;
+
+    /**
+     *  @brief  Pin the calling thread on a CPU. Returns false if
+     *  the CPU affinity can't be set (e.g not on linux)
+     *
+     *  @param  cpu the CPU id
+     */
+    bool pinCurrentThread( unsigned int cpu ) ;
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
+
+#endif
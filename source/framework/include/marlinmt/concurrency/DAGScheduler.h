@@ -0,0 +1,210 @@
+#ifndef MARLINMT_CONCURRENCY_DAGSCHEDULER_h
+#define MARLINMT_CONCURRENCY_DAGSCHEDULER_h 1
+
+// -- marlinmt headers
+#include <marlinmt/IScheduler.h>
+#include <marlinmt/Logging.h>
+#include <marlinmt/Utils.h>
+#include <marlinmt/concurrency/RingQueue.h>
+#include <marlinmt/concurrency/WorkStealingPool.h>
+
+// -- std headers
+#include <set>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace marlinmt {
+
+  class SuperSequence ;
+
+  namespace concurrency {
+
+    /**
+     *  @brief  DAGScheduler class
+     *  Data-dependency scheduler. Implements both inter-event and intra-event
+     *  parallel processing.
+     *
+     *  At startup, a directed acyclic graph (DAG) of processors is built from
+     *  the event collections each processor reads and writes. These are declared
+     *  in the processor code (see ProcessorApi::declareInputCollection() and
+     *  ProcessorApi::declareOutputCollection()) or in the steering file using
+     *  the processor parameters "ProcessorInputs" and "ProcessorOutputs".
+     *  A processor depends on a previous processor (in the execute section order) if :
+     *   - it reads a collection written by the previous processor
+     *   - it writes a collection read or written by the previous processor
+     *   - one of the two processors doesn't declare any collection
+     *   - it has a runtime condition (other than "true")
+     *   - the previous processor may skip events
+     *
+     *  A processor may skip events unless declared otherwise in the code (see
+     *  ProcessorApi::declareNoEventSkip()) or in the steering file using the
+     *  processor parameter "ProcessorSkipsEvents". A processor that may skip
+     *  events is thus a barrier: the processors after it only see the events
+     *  it kept.
+     *
+     *  Processors without dependency run concurrently on the same event, using
+     *  a work-stealing thread pool. Up to "MaxEventsInFlight" events are processed
+     *  at the same time. The worker N of the pool always uses the processor
+     *  instances of the sequence N, so cloned processors are never called
+     *  concurrently. Processors running concurrently on the same event must be
+     *  able to read the event while another processor adds a collection in it,
+     *  else they must be declared critical.
+     *
+     *  If a processor skips the event, the processors after it are not called.
+     *  Run headers are processed once all in-flight events are finished.
+     */
+    class DAGScheduler : public IScheduler {
+    public:
+      using Index = std::size_t ;
+      using EventList = std::vector<std::shared_ptr<EventStore>> ;
+
+    private:
+      /**
+       *  @brief  Node struct
+       *  A processor node in the processor graph
+       */
+      struct Node {
+        ///< The processor name
+        std::string               _name {} ;
+        ///< The indices of the processors depending on this one
+        std::vector<Index>        _successors {} ;
+        ///< The number of processors this one depends on
+        unsigned int              _nPredecessors {0} ;
+      };
+
+      /**
+       *  @brief  EventState struct
+       *  The processing state of an event in flight
+       */
+      struct EventState {
+        ///< The event being processed
+        std::shared_ptr<EventStore>                     _event {nullptr} ;
+        ///< The number of unfinished predecessors per processor
+        std::unique_ptr<std::atomic<unsigned int>[]>    _nPendingPredecessors {nullptr} ;
+        ///< The number of processor tasks not finished yet
+        std::atomic<std::size_t>                        _nRemainingTasks {0} ;
+        ///< Whether a processor requested to skip the event
+        std::atomic<bool>                               _skipped {false} ;
+        ///< Whether an exception has been recorded
+        std::atomic<bool>                               _hasException {false} ;
+        ///< The first exception thrown while processing the event
+        std::exception_ptr                              _exception {nullptr} ;
+      };
+
+      using Graph = std::vector<Node> ;
+      using EventStatePtr = std::shared_ptr<EventState> ;
+      using CompletionQueue = RingQueue<EventStatePtr> ;
+
+    public:
+      /**
+       *  @brief  ProcessorDeclaration struct
+       *  The declarations of a processor the graph is built from
+       */
+      struct ProcessorDeclaration {
+        ///< The event collections read by the processor
+        std::set<std::string>     _inputs {} ;
+        ///< The event collections written by the processor
+        std::set<std::string>     _outputs {} ;
+        ///< Whether the processor has a runtime condition
+        bool                      _conditional {false} ;
+        ///< Whether the processor may skip events
+        bool                      _canSkipEvents {true} ;
+      };
+
+      /**
+       *  @brief  Compute the processor dependencies (see class description).
+       *  Returns, for each processor, the indices of the processors depending on it
+       *
+       *  @param  processors the processor declarations, in the execute section order
+       */
+      static std::vector<std::vector<Index>> dependencies( const std::vector<ProcessorDeclaration> &processors ) ;
+
+      /// Constructor
+      DAGScheduler() ;
+
+      // from IScheduler interface
+      void initialize() override ;
+      void end() override ;
+      void processRunHeader( std::shared_ptr<RunHeader> rhdr ) override ;
+      void pushEvent( std::shared_ptr<EventStore> event ) override ;
+      void popFinishedEvents( std::vector<std::shared_ptr<EventStore>> &events ) override ;
+      std::size_t freeSlots() const override ;
+
+    private:
+      void preConfigure() ;
+      void configureProcessors() ;
+      void configureGraph() ;
+      void configurePool() ;
+
+      /**
+       *  @brief  Run a processor on an event, then submit the
+       *  processors depending on it if they are ready
+       *
+       *  @param  state the event state
+       *  @param  index the processor index
+       *  @param  worker the index of the worker running the task
+       */
+      void runTask( const EventStatePtr &state, Index index, std::size_t worker ) ;
+
+      /**
+       *  @brief  Submit a processor task in the pool
+       *
+       *  @param  state the event state
+       *  @param  index the processor index
+       */
+      void submitTask( const EventStatePtr &state, Index index ) ;
+
+      /**
+       *  @brief  Called when all processors have processed the event
+       *
+       *  @param  state the event state
+       */
+      void finishEvent( const EventStatePtr &state ) ;
+
+      /**
+       *  @brief  Wait until the number of events in flight is below the given value
+       *
+       *  @param  maxInFlight the number of events in flight to wait for
+       */
+      void waitInFlight( std::size_t maxInFlight ) ;
+
+    private:
+      ///< The work-stealing thread pool
+      WorkStealingPool                 _pool {} ;
+      ///< The processor super sequence
+      std::shared_ptr<SuperSequence>   _superSequence {nullptr} ;
+      ///< The processor dependency graph
+      Graph                            _graph {} ;
+      ///< The processors without dependency
+      std::vector<Index>               _roots {} ;
+      ///< The queue of processed events, filled by the workers
+      CompletionQueue                  _completionQueue {} ;
+      ///< The maximum number of events in flight
+      std::size_t                      _maxInFlight {0} ;
+      ///< The number of events in flight (guarded by _mutex)
+      std::size_t                      _nInFlight {0} ;
+      ///< The synchronization mutex for events in flight
+      mutable std::mutex               _mutex {} ;
+      ///< The condition variable notified when an event is finished
+      std::condition_variable          _conditionVariable {} ;
+      ///< The start time
+      clock::time_point                _startTime {} ;
+      ///< The end time
+      clock::time_point                _endTime {} ;
+      ///< The total time spent on processing run headers
+      clock::duration_rep              _runHeaderTime {0} ;
+      ///< The total time spent waiting for a free event slot
+      clock::duration_rep              _pushWaitTime {0} ;
+      /// The maximum number of events processed concurrently
+      UIntParameter                    _maxEventsInFlight {*this, "MaxEventsInFlight", "The maximum number of events processed concurrently (default 2*nthreads)"} ;
+    };
+
+  }
+
+} // end namespace marlinmt
+
+#endif
@@ -4,11 +4,19 @@
 // -- marlinmt headers
 #include <marlinmt/IScheduler.h>
 #include <marlinmt/Logging.h>
+#include <marlinmt/AsyncLogger.h>
 #include <marlinmt/Utils.h>
 #include <marlinmt/concurrency/ThreadPool.h>
+#include <marlinmt/concurrency/RingQueue.h>
+#include <marlinmt/concurrency/ReorderBuffer.h>
+#include <marlinmt/concurrency/CpuResources.h>
 
 // -- std headers
 #include <unordered_set>
+#include <thread>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 
 namespace marlinmt {
 
@@ -17,6 +25,19 @@ namespace marlinmt {
 
   namespace concurrency {
 
+    /**
+     *  @brief  WorkerInput struct
+     *  Stores the input of a processor sequence call
+     */
+    struct WorkerInput {
+      ///< The input event
+      std::shared_ptr<EventStore>         _event {nullptr} ;
+      ///< The input sequence number of the event (see ReorderBuffer)
+      std::size_t                         _sequenceNumber {0} ;
+      ///< The index of the first processor to run
+      std::size_t                         _startIndex {0} ;
+    };
+
     /**
      *  @brief  WorkerOutput struct
      *  Stores the output of a processor sequence call
@@ -26,6 +47,8 @@ namespace marlinmt {
       std::shared_ptr<EventStore>         _event {nullptr} ;
       ///< An exception potential throw in the worker thread
       std::exception_ptr                  _exception {nullptr} ;
+      ///< Whether a processor requested to skip the event
+      bool                                _skipped {false} ;
     };
 
     //--------------------------------------------------------------------------
@@ -38,18 +61,58 @@ namespace marlinmt {
      *
      *  A set of N worker threads are allocated at startup within a thread pool.
      *  Every time a new event is pushed in the scheduler, the event is queued
-     *  in the thread pool for further processing. Note that this operation can
-     *  fail if the thread pool queue is full. Use freeSlots() to know how many
-     *  slots are free in the thread pool queue and avoid unexpected exceptions.
+     *  in the thread pool for further processing. If the thread pool queue is
+     *  full, the caller sleeps until a worker takes an event out of the queue.
+     *  The total time spent waiting is reported in the threading summary.
+     *  Finished events are pushed by the workers in a lock-free completion
+     *  queue, drained by popFinishedEvents() in the scheduler thread.
+     *
+     *  If some processors are flagged as ordered (see Processor::ERuntimeOption::eOrdered),
+     *  the workers only run the processors before the first ordered one. The
+     *  events are then restored in input order by a reorder buffer and a single
+     *  commit thread runs the rest of the sequence. Place the ordered processors
+     *  at the end of the execute section to keep the other processors parallel.
+     *  The reorder buffer size bounds the number of events between the reader
+     *  and the commit thread ("OrderedBufferSize").
+     *
+     *  Critical processors (see Processor::ERuntimeOption::eCritical) are
+     *  called in a critical section by the workers. If "CriticalStages" is set,
+     *  each critical processor runs instead in its own serial stage thread:
+     *  the worker hands the event over to the stage queue and takes another
+     *  event. Once processed by the stage, the event goes back to the thread
+     *  pool queue to run the next processors. A sequence with a heavy critical
+     *  processor is then pipelined instead of serialized. The number of events
+     *  in flight is bounded to EventQueueSize + nthreads.
+     *
+     *  If "ElasticWorkers" is set, the N workers and their sequences are still
+     *  created at startup, but only part of them are active: the others are
+     *  parked (see ThreadPool::setActiveWorkers()). A controller thread samples
+     *  the thread pool queue occupancy and decides every "ElasticInterval" ms
+     *  to activate or park one worker, within ["MinThreads", "MaxThreads"]:
+     *   - the number of workers is bounded by the CPUs available (cgroup quota)
+     *   - a worker is activated if the queue is mostly full (backlog) and the
+     *     lock time fraction is below "ElasticMaxLockFraction"
+     *   - a worker is parked if the lock time fraction is above this threshold
+     *     (contention) or if the queue is mostly empty with idle workers
+     *  Every scaling decision is logged.
+     *
+     *  The worker threads can be pinned on CPUs with "WorkerAffinity": "compact"
+     *  fills the NUMA nodes one after the other, "scatter" distributes the
+     *  workers over the nodes and "list" uses the CPUs of "WorkerCpus". With
+     *  an affinity policy, the cloned processors are set up in their worker
+     *  thread after pinning, so that their data are allocated on the worker
+     *  memory node. On single node machines, compact and scatter are equivalent.
      */
     class PEPScheduler : public IScheduler {
+      friend class ProcessorSequenceWorker ;
     public:
       using ConditionsMap = std::map<std::string, std::string> ;
-      using InputType = std::shared_ptr<EventStore> ;
+      using InputType = WorkerInput ;
       using OutputType = WorkerOutput ;
-      using WorkerPool = ThreadPool<InputType,OutputType> ;
+      using WorkerPool = ThreadPool<InputType,void> ;
+      using CompletionQueue = RingQueue<OutputType> ;
+      using CommitBuffer = ReorderBuffer<OutputType> ;
       using ProcessorSequence = std::shared_ptr<SuperSequence> ;
-      using PushResultList = std::vector<WorkerPool::PushResult> ;
       using EventList = std::vector<std::shared_ptr<EventStore>> ;
       using Clock = std::chrono::steady_clock ;
       using TimePoint = std::chrono::steady_clock::time_point ;
@@ -58,6 +121,9 @@ namespace marlinmt {
       /// Constructor
       PEPScheduler() ;
 
+      /// Destructor
+      ~PEPScheduler() ;
+
       // from IScheduler interface
       void initialize() override ;
       void end() override ;
@@ -70,26 +136,204 @@ namespace marlinmt {
       void preConfigure() ;
       void configureProcessors() ;
       void configurePool() ;
+      void configureCriticalStages() ;
+
+      /**
+       *  @brief  Initialize a worker. Called in the worker thread before processing
+       *
+       *  @param  index the worker index (also the processor sequence index)
+       */
+      void initializeWorker( std::size_t index ) ;
+
+      /**
+       *  @brief  StageInput struct
+       *  An event handed over to a critical stage
+       */
+      struct StageInput {
+        ///< The sequence of the worker that handed over the event
+        std::shared_ptr<Sequence>        _sequence {nullptr} ;
+        ///< The event input
+        InputType                        _input {} ;
+      };
+
+      /**
+       *  @brief  CriticalStage struct
+       *  A serial stage thread running a critical processor
+       */
+      struct CriticalStage {
+        ///< The index of the processor in the sequences
+        std::size_t                      _index {0} ;
+        ///< The stage thread
+        std::thread                      _thread {} ;
+        ///< The synchronization mutex
+        std::mutex                       _mutex {} ;
+        ///< The condition variable notified on push and stop
+        std::condition_variable          _conditionVariable {} ;
+        ///< The stage input queue
+        std::deque<StageInput>           _queue {} ;
+        ///< The stop flag
+        bool                             _stop {false} ;
+        ///< The number of events processed by the stage
+        std::size_t                      _nEvents {0} ;
+        ///< The sum of the queue sizes seen by the stage thread
+        std::size_t                      _occupancySum {0} ;
+        ///< The time spent processing events in the stage thread
+        clock::duration_rep              _busyTime {0} ;
+      };
+
+      /**
+       *  @brief  Run the processors of a sequence on an event, from the input
+       *  start index until the next critical stage or the ordered processors.
+       *  Called in the worker threads
+       *
+       *  @param  sequence the worker processor sequence
+       *  @param  input the event input
+       */
+      void runSequence( const std::shared_ptr<Sequence> &sequence, InputType &&input ) ;
+
+      /**
+       *  @brief  The critical stage thread function
+       *
+       *  @param  stage the critical stage to run
+       */
+      void runCriticalStage( CriticalStage &stage ) ;
+
+      /**
+       *  @brief  Forward an event for which the parallel part is over,
+       *  either to the reorder buffer or to the completion queue
+       *
+       *  @param  sequenceNumber the input sequence number of the event
+       *  @param  output the processing output
+       */
+      void forwardEvent( std::size_t sequenceNumber, OutputType &&output ) ;
+
+      /**
+       *  @brief  Push a fully processed event to the completion queue
+       *
+       *  @param  output the processing output
+       */
+      void finishEvent( OutputType &&output ) ;
+
+      /**
+       *  @brief  The commit thread function. Pop the events from the
+       *  reorder buffer in input order and run the ordered processors
+       */
+      void commitEvents() ;
+
+      /**
+       *  @brief  Configure the elastic worker mode and start the controller thread
+       */
+      void configureElasticWorkers() ;
+
+      /**
+       *  @brief  The elastic controller thread function. Sample the queue
+       *  occupancy and adapt the number of active workers at regular interval
+       */
+      void controlWorkers() ;
+
+      /**
+       *  @brief  Stop and join the elastic controller thread
+       */
+      void stopElasticWorkers() ;
+
+      /**
+       *  @brief  Get the total application and processor times of the worker sequences
+       */
+      clock::pair workerClockTotals() const ;
 
     private:
       ///< The worker thread pool
       WorkerPool                       _pool {} ;
       ///< The processor super sequence
       ProcessorSequence                _superSequence {nullptr} ;
-      ///< The list of worker output promises
-      PushResultList                   _pushResults {} ;
+      ///< The queue of processed events, filled by the workers
+      CompletionQueue                  _completionQueue {} ;
+      ///< The reorder buffer, filled by the workers if some processors are ordered
+      CommitBuffer                     _commitBuffer {} ;
+      ///< The commit thread running the ordered processors
+      std::thread                      _commitThread {} ;
+      ///< Whether some processors are ordered
+      bool                             _ordered {false} ;
+      ///< The index of the first ordered processor
+      std::size_t                      _commitIndex {0} ;
+      ///< The critical stages
+      std::vector<std::unique_ptr<CriticalStage>> _criticalStages {} ;
+      ///< The critical stage of each processor index (nullptr if none)
+      std::vector<CriticalStage*>      _stageOfProcessor {} ;
+      ///< The maximum number of events in flight when using critical stages
+      std::size_t                      _maxActiveEvents {0} ;
+      ///< The number of events in flight when using critical stages
+      std::size_t                      _nActiveEvents {0} ;
+      ///< The synchronization mutex for events in flight
+      std::mutex                       _activeMutex {} ;
+      ///< The condition variable notified when an event is finished
+      std::condition_variable          _activeConditionVariable {} ;
+      ///< The total time spent waiting for a free event slot when using critical stages
+      clock::duration_rep              _activeWaitTime {0} ;
+      ///< The number of events pushed and not popped yet
+      std::size_t                      _nInFlight {0} ;
       ///< The start time
       clock::time_point                _startTime {} ;
       ///< The end time
       clock::time_point                _endTime {} ;
-      ///< The total time spent on processing run headers
+      ///< The total time spent on run headers in the scheduler thread
       clock::duration_rep              _runHeaderTime {0} ;
       ///< The total time spent on locking on thread pool queue access
       clock::duration_rep              _lockingTime {0} ;
       ///< The total time spent on popping events from the output event pool
       clock::duration_rep              _popTime {0} ;
+      ///< The end time of the last pushEvent() call
+      clock::time_point                _lastPushEnd {} ;
+      ///< The total time spent by the main thread between two pushEvent() calls (unit: ms)
+      clock::duration_rep              _dispatchTime {0} ;
+      ///< The asynchronous logger (nullptr if disabled)
+      std::shared_ptr<AsyncLogger>     _asyncLogger {nullptr} ;
+      ///< The worker affinity policy
+      AffinityPolicy                   _affinityPolicy {AffinityPolicy::None} ;
+      ///< The CPU of each worker (empty: no pinning)
+      std::vector<unsigned int>        _workerCpus {} ;
+      ///< The number of workers pinned on a CPU
+      std::size_t                      _nPinnedWorkers {0} ;
+      ///< The elastic controller thread
+      std::thread                      _elasticThread {} ;
+      ///< The synchronization mutex of the elastic controller
+      std::mutex                       _elasticMutex {} ;
+      ///< The condition variable notified to stop the elastic controller
+      std::condition_variable          _elasticConditionVariable {} ;
+      ///< The elastic controller stop flag
+      bool                             _elasticStop {false} ;
+      ///< The minimum number of active workers in elastic mode
+      std::size_t                      _elasticMin {0} ;
+      ///< The maximum number of active workers in elastic mode
+      std::size_t                      _elasticMax {0} ;
+      ///< The number of worker activations in elastic mode
+      std::size_t                      _nScaleUp {0} ;
+      ///< The number of worker parkings in elastic mode
+      std::size_t                      _nScaleDown {0} ;
+      ///< The number of elastic controller decisions
+      std::size_t                      _nElasticDecisions {0} ;
+      ///< The sum of the number of active workers over the elastic controller decisions
+      std::size_t                      _activeWorkersSum {0} ;
       /// The scheduler event queue size
       UIntParameter                    _queueSize {*this, "EventQueueSize", "The input event queue size (default 2*nthreads)"} ;
+      /// The reorder buffer size for ordered processors
+      UIntParameter                    _orderedBufferSize {*this, "OrderedBufferSize", "The maximum number of events waiting for ordered processors (default EventQueueSize + 2*nthreads)"} ;
+      /// Whether critical processors run in their own stage thread
+      BoolParameter                    _useCriticalStages {*this, "CriticalStages", "Whether critical processors run in their own serial stage thread instead of locking the workers", false} ;
+      /// The worker thread CPU affinity policy
+      StringParameter                  _workerAffinity {*this, "WorkerAffinity", "The worker thread CPU affinity policy: none, compact, scatter or list", "none"} ;
+      /// The worker CPU list for the list affinity policy
+      UIntVectorParameter              _workerCpuList {*this, "WorkerCpus", "The worker CPU list, for the 'list' affinity policy"} ;
+      /// Whether the number of active workers adapts at runtime
+      BoolParameter                    _elasticWorkers {*this, "ElasticWorkers", "Whether the number of active workers adapts to the queue occupancy, the lock time fraction and the CPU quota", false} ;
+      /// The minimum number of active workers in elastic mode
+      UIntParameter                    _minThreads {*this, "MinThreads", "The minimum number of active workers in elastic mode", 1} ;
+      /// The maximum number of active workers in elastic mode
+      UIntParameter                    _maxThreads {*this, "MaxThreads", "The maximum number of active workers in elastic mode (default nthreads)"} ;
+      /// The interval between two elastic scaling decisions
+      UIntParameter                    _elasticInterval {*this, "ElasticInterval", "The interval between two elastic scaling decisions (unit: ms)", 1000} ;
+      /// The lock time fraction above which no worker is activated
+      DoubleParameter                  _elasticMaxLockFraction {*this, "ElasticMaxLockFraction", "The lock time fraction of the processors above which a worker is parked in elastic mode", 0.3} ;
     };
 
   }
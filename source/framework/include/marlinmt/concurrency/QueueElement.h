@@ -4,6 +4,7 @@
 // -- std headers
 #include <memory>
 #include <future>
+#include <cstddef>
 
 namespace marlinmt {
 
@@ -34,6 +35,18 @@ namespace marlinmt {
         /* nop */
       }
 
+      /**
+       *  @brief  Constructor with input data and without promise.
+       *  The output of the processing is discarded
+       *
+       *  @param  input user input data
+       */
+      QueueElement( IN && input, std::nullptr_t ) :
+        _promise(nullptr),
+        _input(std::move(input)) {
+        /* nop */
+      }
+
       /**
        *  @brief  Move constructor
        */
@@ -63,7 +76,9 @@ namespace marlinmt {
        *  @param  output the output data to retrieve in the future object
        */
       void setValue( OUT && output ) {
-        _promise->set_value( output ) ;
+        if( nullptr != _promise ) {
+          _promise->set_value( output ) ;
+        }
       }
 
       /**
@@ -104,6 +119,7 @@ namespace marlinmt {
       QueueElement( const QueueElement<IN,void> & ) = delete ;
       QueueElement &operator=( const QueueElement<IN,void> & ) = delete ;
       QueueElement( IN && input ) : _input(input) {}
+      QueueElement( IN && input, std::nullptr_t ) : _promise(nullptr), _input(std::move(input)) {}
       QueueElement( QueueElement<IN,void> &&rhs ) { *this = std::move(rhs) ; }
       QueueElement &operator=( QueueElement<IN,void> &&rhs ) {
         _promise = std::move(rhs._promise) ;
@@ -111,7 +127,7 @@ namespace marlinmt {
         return *this ;
       }
       std::shared_ptr<std::promise<void>> promise() const { return _promise ; }
-      void setValue() { _promise->set_value() ; }
+      void setValue() { if( nullptr != _promise ) { _promise->set_value() ; } }
       IN takeInput() { return std::move(_input) ; }
     private:
       std::shared_ptr<std::promise<void>>    _promise {std::make_shared<std::promise<void>>()} ;
@@ -0,0 +1,178 @@
+#ifndef MARLINMT_CONCURRENCY_READAHEADBUFFER_h
+#define MARLINMT_CONCURRENCY_READAHEADBUFFER_h 1
+
+// -- marlinmt headers
+#include <marlinmt/Utils.h>
+
+// -- std headers
+#include <functional>
+#include <exception>
+#include <thread>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <condition_variable>
+
+namespace marlinmt {
+
+  class EventStore ;
+  class RunHeader ;
+
+  namespace concurrency {
+
+    /**
+     *  @brief  ReadAheadBuffer class
+     *  Asynchronous read-ahead stage between the data source and the scheduler.
+     *
+     *  A dedicated reader thread runs the reader function, which pushes the
+     *  records (events and run headers) in a bounded buffer. The reader sleeps
+     *  while the buffer is full. The dispatcher thread pops the records in the
+     *  order they were read and sleeps while the buffer is empty.
+     *  An exception thrown in the reader thread is rethrown in the dispatcher
+     *  thread by pop(). Calling stop() makes the pending and next pushes
+     *  return false, so that the reader function can return early.
+     */
+    class ReadAheadBuffer {
+    public:
+      /**
+       *  @brief  Record struct
+       *  A record read from the data source. Only one of the two pointers is set
+       */
+      struct Record {
+        ///< The event read
+        std::shared_ptr<EventStore>        _event {nullptr} ;
+        ///< The run header read
+        std::shared_ptr<RunHeader>         _runHeader {nullptr} ;
+      };
+
+      using ReaderFunction = std::function<void()> ;
+
+    public:
+      ReadAheadBuffer() = delete ;
+      ReadAheadBuffer(const ReadAheadBuffer &) = delete ;
+      ReadAheadBuffer(ReadAheadBuffer &&) = delete ;
+      ReadAheadBuffer& operator=(const ReadAheadBuffer &) = delete ;
+      ReadAheadBuffer& operator=(ReadAheadBuffer &&) = delete ;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  maxSize the maximum number of records in the buffer
+       */
+      ReadAheadBuffer( std::size_t maxSize ) ;
+
+      /**
+       *  @brief  Destructor. Stop the reader thread
+       */
+      ~ReadAheadBuffer() ;
+
+      /**
+       *  @brief  Start the reader thread
+       *
+       *  @param  reader the function reading the data source
+       */
+      void start( ReaderFunction reader ) ;
+
+      /**
+       *  @brief  Stop the reader thread. The records remaining
+       *  in the buffer are dropped
+       */
+      void stop() ;
+
+      /**
+       *  @brief  Push an event in the buffer. Called from the reader thread.
+       *  Returns false if the buffer has been stopped
+       *
+       *  @param  event the event to push
+       */
+      bool push( std::shared_ptr<EventStore> event ) ;
+
+      /**
+       *  @brief  Push a run header in the buffer. Called from the reader thread.
+       *  Returns false if the buffer has been stopped
+       *
+       *  @param  rhdr the run header to push
+       */
+      bool push( std::shared_ptr<RunHeader> rhdr ) ;
+
+      /**
+       *  @brief  Pop the next record. Called from the dispatcher thread.
+       *  Returns false once the reader is finished and the buffer is empty
+       *
+       *  @param  record the record to receive
+       */
+      bool pop( Record &record ) ;
+
+      /**
+       *  @brief  Whether stop() has been called
+       */
+      bool stopped() const ;
+
+      /**
+       *  @brief  Get the maximum number of records in the buffer
+       */
+      std::size_t maxSize() const ;
+
+      /**
+       *  @brief  Get the number of records popped so far
+       */
+      std::size_t nRecords() const ;
+
+      /**
+       *  @brief  Get the average number of records found in the buffer by pop()
+       */
+      double averageOccupancy() const ;
+
+      /**
+       *  @brief  Get the total time the reader waited on a full buffer (unit ms)
+       */
+      clock::duration_rep readerStallTime() const ;
+
+      /**
+       *  @brief  Get the total time the dispatcher waited on an empty buffer (unit ms)
+       */
+      clock::duration_rep dispatcherStallTime() const ;
+
+    private:
+      /**
+       *  @brief  Push a record in the buffer. Blocks while the buffer is full
+       *
+       *  @param  record the record to push
+       */
+      bool pushRecord( Record &&record ) ;
+
+    private:
+      ///< The maximum number of records in the buffer
+      const std::size_t                  _maxSize ;
+      ///< The record buffer
+      std::deque<Record>                 _records {} ;
+      ///< The reader thread
+      std::thread                        _thread {} ;
+      ///< The synchronization mutex
+      mutable std::mutex                 _mutex {} ;
+      ///< The condition variable notified when a record is pushed or the reader finishes
+      std::condition_variable            _pushConditionVariable {} ;
+      ///< The condition variable notified when a record is popped or the buffer stops
+      std::condition_variable            _popConditionVariable {} ;
+      ///< Whether the reader function has returned
+      bool                               _readerFinished {false} ;
+      ///< The exception thrown by the reader function, if any
+      std::exception_ptr                 _exception {nullptr} ;
+      ///< The stop flag
+      std::atomic<bool>                  _stop {false} ;
+      ///< The number of records popped
+      std::size_t                        _nRecords {0} ;
+      ///< The sum of the buffer sizes seen by pop()
+      std::size_t                        _occupancySum {0} ;
+      ///< The total time the reader waited on a full buffer
+      clock::duration_rep                _readerStallTime {0} ;
+      ///< The total time the dispatcher waited on an empty buffer
+      clock::duration_rep                _dispatcherStallTime {0} ;
+    };
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
+
+#endif
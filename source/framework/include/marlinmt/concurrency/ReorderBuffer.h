@@ -0,0 +1,261 @@
+#ifndef MARLINMT_CONCURRENCY_REORDERBUFFER_h
+#define MARLINMT_CONCURRENCY_REORDERBUFFER_h 1
+
+// -- std headers
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+// -- marlinmt headers
+#include "marlinmt/Exceptions.h"
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    /**
+     *  @brief  ReorderBuffer class
+     *  A bounded buffer restoring the input order of elements processed
+     *  out of order.
+     *
+     *  The producer calls acquire() to get the sequence number of the next
+     *  input element. At most maxSize() sequence numbers can be acquired and
+     *  not popped yet: acquire() blocks until the oldest element is popped.
+     *  The elements are inserted with their sequence number in any order
+     *  from any thread (insert() never blocks) and pop() returns them in the
+     *  sequence number order. After stop(), no more sequence number can be
+     *  acquired and pop() returns false once all acquired elements are popped,
+     *  or immediately if the buffer is not drained.
+     */
+    template <typename T>
+    class ReorderBuffer {
+    public:
+      using SequenceNumber = std::size_t ;
+      using Clock = std::chrono::steady_clock ;
+      static constexpr std::size_t DefaultMaxSize = 64 ;
+
+    public:
+      ReorderBuffer() ;
+      ~ReorderBuffer() = default ;
+      ReorderBuffer(const ReorderBuffer &) = delete ;
+      ReorderBuffer& operator=(const ReorderBuffer &) = delete ;
+
+      /**
+       *  @brief  Get the next sequence number. Blocks while the buffer is full
+       */
+      SequenceNumber acquire() ;
+
+      /**
+       *  @brief  Insert an element with its sequence number
+       *
+       *  @param  sequence the sequence number obtained from acquire()
+       *  @param  element the element to insert
+       */
+      void insert( SequenceNumber sequence, T &&element ) ;
+
+      /**
+       *  @brief  Pop the next element in sequence order. Blocks until it is
+       *  inserted. Returns false if the buffer is stopped and empty
+       *
+       *  @param  element the element to receive
+       */
+      bool pop( T &element ) ;
+
+      /**
+       *  @brief  Stop the buffer. See class description
+       *
+       *  @param  drain whether pop() should still return the acquired elements
+       */
+      void stop( bool drain = true ) ;
+
+      /**
+       *  @brief  Set the maximum number of acquired and not popped elements.
+       *  The buffer must be empty
+       *
+       *  @param  maxSize the maximum buffer size
+       */
+      void setMaxSize( std::size_t maxSize ) ;
+
+      /**
+       *  @brief  Get the maximum number of acquired and not popped elements
+       */
+      std::size_t maxSize() const ;
+
+      /**
+       *  @brief  Get the average number of inserted elements waiting in the buffer, seen by pop()
+       */
+      double averageOccupancy() const ;
+
+      /**
+       *  @brief  Get the total time spent in acquire() waiting on a full buffer
+       */
+      Clock::duration acquireWaitTime() const ;
+
+      /**
+       *  @brief  Get the number of times acquire() waited on a full buffer
+       */
+      std::size_t nAcquireWaits() const ;
+
+    private:
+      ///< The buffer slots, indexed by sequence number modulo the buffer size
+      std::vector<std::optional<T>>   _slots {} ;
+      ///< The next sequence number to acquire
+      SequenceNumber                  _nextAcquire {0} ;
+      ///< The next sequence number to pop
+      SequenceNumber                  _nextPop {0} ;
+      ///< The number of inserted elements not popped yet
+      std::size_t                     _nInserted {0} ;
+      ///< The number of popped elements
+      std::size_t                     _nPopped {0} ;
+      ///< The sum of the number of inserted elements seen by pop()
+      std::size_t                     _occupancySum {0} ;
+      ///< The total time spent waiting in acquire()
+      Clock::duration                 _acquireWaitTime {0} ;
+      ///< The number of waits in acquire()
+      std::size_t                     _nAcquireWaits {0} ;
+      ///< The stop flag
+      bool                            _stop {false} ;
+      ///< Whether pop() returns the remaining elements after stop
+      bool                            _drain {true} ;
+      ///< The synchronization mutex
+      mutable std::mutex              _mutex {} ;
+      ///< The condition variable notified on pop
+      std::condition_variable         _acquireConditionVariable {} ;
+      ///< The condition variable notified on insert and stop
+      std::condition_variable         _popConditionVariable {} ;
+    };
+
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline ReorderBuffer<T>::ReorderBuffer() :
+      _slots(DefaultMaxSize) {
+      /* nop */
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline typename ReorderBuffer<T>::SequenceNumber ReorderBuffer<T>::acquire() {
+      std::unique_lock<std::mutex> lock( _mutex ) ;
+      if( _stop ) {
+        throw Exception( "ReorderBuffer::acquire: buffer stopped!" ) ;
+      }
+      if( _nextAcquire - _nextPop >= _slots.size() ) {
+        auto start = Clock::now() ;
+        _acquireConditionVariable.wait( lock, [this](){
+          return ( _nextAcquire - _nextPop < _slots.size() ) ;
+        }) ;
+        _acquireWaitTime += Clock::now() - start ;
+        ++ _nAcquireWaits ;
+      }
+      return _nextAcquire++ ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline void ReorderBuffer<T>::insert( SequenceNumber sequence, T &&element ) {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      if( sequence < _nextPop or sequence >= _nextAcquire ) {
+        throw Exception( "ReorderBuffer::insert: invalid sequence number!" ) ;
+      }
+      auto &slot = _slots[ sequence % _slots.size() ] ;
+      if( slot.has_value() ) {
+        throw Exception( "ReorderBuffer::insert: sequence number already inserted!" ) ;
+      }
+      slot = std::move( element ) ;
+      ++ _nInserted ;
+      if( sequence == _nextPop ) {
+        _popConditionVariable.notify_one() ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool ReorderBuffer<T>::pop( T &element ) {
+      std::unique_lock<std::mutex> lock( _mutex ) ;
+      _popConditionVariable.wait( lock, [this](){
+        return ( _stop and not _drain ) or
+          _slots[ _nextPop % _slots.size() ].has_value() or
+          ( _stop and _nextPop == _nextAcquire ) ;
+      }) ;
+      auto &slot = _slots[ _nextPop % _slots.size() ] ;
+      if( ( _stop and not _drain ) or not slot.has_value() ) {
+        return false ;
+      }
+      _occupancySum += _nInserted ;
+      ++ _nPopped ;
+      element = std::move( slot.value() ) ;
+      slot.reset() ;
+      -- _nInserted ;
+      ++ _nextPop ;
+      _acquireConditionVariable.notify_one() ;
+      return true ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline void ReorderBuffer<T>::stop( bool drain ) {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      _stop = true ;
+      _drain = drain ;
+      _popConditionVariable.notify_all() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline void ReorderBuffer<T>::setMaxSize( std::size_t maxSize ) {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      if( _nextAcquire != _nextPop ) {
+        throw Exception( "ReorderBuffer::setMaxSize: buffer not empty!" ) ;
+      }
+      if( 0 == maxSize ) {
+        throw Exception( "ReorderBuffer::setMaxSize: size must be > 0" ) ;
+      }
+      _slots = std::vector<std::optional<T>>( maxSize ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline std::size_t ReorderBuffer<T>::maxSize() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return _slots.size() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline double ReorderBuffer<T>::averageOccupancy() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return ( 0 == _nPopped ) ? 0. : static_cast<double>( _occupancySum ) / static_cast<double>( _nPopped ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline typename ReorderBuffer<T>::Clock::duration ReorderBuffer<T>::acquireWaitTime() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return _acquireWaitTime ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename T>
+    inline std::size_t ReorderBuffer<T>::nAcquireWaits() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return _nAcquireWaits ;
+    }
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
+
+#endif
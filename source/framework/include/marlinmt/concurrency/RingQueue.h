@@ -0,0 +1,236 @@
+#ifndef MARLINMT_CONCURRENCY_RINGQUEUE_h
+#define MARLINMT_CONCURRENCY_RINGQUEUE_h 1
+
+// -- std headers
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+// -- marlinmt headers
+#include "marlinmt/Exceptions.h"
+#include "marlinmt/concurrency/CacheLine.h"
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    /**
+     *  @brief  RingQueue class.
+     *  A lock-free bounded multi-producer / multi-consumer queue.
+     *  The queue is a ring buffer of slots, each holding a sequence number
+     *  telling whether the slot is ready to be written (by a producer) or
+     *  read (by a consumer). Producers and consumers only synchronize on
+     *  the enqueue and dequeue positions, which live on separate cache lines.
+     *  Provides the same interface as the Queue class, so that it can be used
+     *  as a drop-in replacement for the ThreadPool queue.
+     *  The type T must be default constructible and implement move assignement
+     */
+    template <
+      typename T,
+      class = typename std::enable_if<std::is_move_assignable<T>::value>::type>
+    class RingQueue {
+    private:
+      /**
+       *  @brief  Cell struct.
+       *  A slot in the ring buffer
+       */
+      struct alignas(CacheLineSize) Cell {
+        /// The slot sequence number
+        std::atomic<std::size_t>      _sequence {0} ;
+        /// The stored value
+        T                             _data {} ;
+      };
+
+    public:
+      /// The default maximum queue size
+      static constexpr std::size_t DefaultMaxSize = 1024 ;
+
+    public:
+      ~RingQueue() = default ;
+      RingQueue(const RingQueue&) = delete ;
+      RingQueue& operator=(const RingQueue&) = delete ;
+
+      /**
+       *  @brief  Default constructor. Use DefaultMaxSize as maximum size
+       */
+      RingQueue() :
+        RingQueue( DefaultMaxSize ) {
+        /* nop */
+      }
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  maxsize the maximum queue size
+       */
+      RingQueue( std::size_t maxsize ) {
+        allocate( maxsize ) ;
+      }
+
+      /**
+       *  @brief  Push a value to the queue.
+       *  WARNING: On success, the element is moved in the queue
+       *  container, else it is not !
+       *
+       *  @param  value the value to push
+       */
+      bool push( T &value ) {
+        Cell *cell = nullptr ;
+        std::size_t pos = _enqueuePos.load( std::memory_order_relaxed ) ;
+        while( true ) {
+          cell = &_buffer[ pos % _maxSize ] ;
+          const std::size_t seq = cell->_sequence.load( std::memory_order_acquire ) ;
+          const auto diff = static_cast<std::ptrdiff_t>( seq ) - static_cast<std::ptrdiff_t>( pos ) ;
+          if( 0 == diff ) {
+            if( _enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+              break ;
+            }
+          }
+          else if( diff < 0 ) {
+            // the slot has not been consumed yet: the queue is full
+            return false ;
+          }
+          else {
+            pos = _enqueuePos.load( std::memory_order_relaxed ) ;
+          }
+        }
+        cell->_data = std::move( value ) ;
+        cell->_sequence.store( pos + 1, std::memory_order_release ) ;
+        return true ;
+      }
+
+      /**
+       *  @brief  Pop and get the front element in the queue.
+       *  The queue type must support move operation
+       *
+       *  @param  value the value to receive
+       */
+      bool pop( T &value ) {
+        Cell *cell = nullptr ;
+        std::size_t pos = _dequeuePos.load( std::memory_order_relaxed ) ;
+        while( true ) {
+          cell = &_buffer[ pos % _maxSize ] ;
+          const std::size_t seq = cell->_sequence.load( std::memory_order_acquire ) ;
+          const auto diff = static_cast<std::ptrdiff_t>( seq ) - static_cast<std::ptrdiff_t>( pos + 1 ) ;
+          if( 0 == diff ) {
+            if( _dequeuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+              break ;
+            }
+          }
+          else if( diff < 0 ) {
+            // the slot has not been written yet: the queue is empty
+            return false ;
+          }
+          else {
+            pos = _dequeuePos.load( std::memory_order_relaxed ) ;
+          }
+        }
+        value = std::move( cell->_data ) ;
+        cell->_sequence.store( pos + _maxSize, std::memory_order_release ) ;
+        return true ;
+      }
+
+      /**
+       *  @brief  Whether the queue is empty.
+       *  The result is a snapshot and may be outdated
+       *  as soon as it is returned
+       */
+      bool empty() const {
+        return ( 0 == size() ) ;
+      }
+
+      /**
+       *  @brief  Get the maximum queue size
+       */
+      std::size_t maxSize() const {
+        return _maxSize ;
+      }
+
+      /**
+       *  @brief  Set the maximum queue size.
+       *  The ring buffer is re-allocated, so the queue must be empty and
+       *  must not be accessed by other threads during this call.
+       *  The value of the old max size is returned
+       *
+       *  @param  maxsize the maximum queue size to set
+       */
+      std::size_t setMaxSize( std::size_t maxsize ) {
+        if( not empty() ) {
+          MARLINMT_THROW( "RingQueue::setMaxSize: queue is not empty" ) ;
+        }
+        const std::size_t oldSize = _maxSize ;
+        allocate( maxsize ) ;
+        return oldSize ;
+      }
+
+      /**
+       *  @brief  Check whether the queue has reached the maximum allowed size
+       */
+      bool isFull() const {
+        return ( size() >= _maxSize ) ;
+      }
+
+      /**
+       *  @brief  Clear the queue
+       */
+      void clear() {
+        T value {} ;
+        while( pop( value ) ) {
+          /* nop */
+        }
+      }
+
+      /**
+       *  @brief  Get the number of free slots in the queue
+       */
+      std::size_t freeSlots() const {
+        const std::size_t current = size() ;
+        return ( current >= _maxSize ? 0 : (_maxSize - current) ) ;
+      }
+
+    private:
+      /**
+       *  @brief  Get the number of elements in the queue (snapshot)
+       */
+      std::size_t size() const {
+        const std::size_t dequeuePos = _dequeuePos.load( std::memory_order_acquire ) ;
+        const std::size_t enqueuePos = _enqueuePos.load( std::memory_order_acquire ) ;
+        return ( enqueuePos > dequeuePos ? (enqueuePos - dequeuePos) : 0 ) ;
+      }
+
+      /**
+       *  @brief  Allocate the ring buffer and reset the positions
+       *
+       *  @param  maxsize the number of slots to allocate
+       */
+      void allocate( std::size_t maxsize ) {
+        if( 0 == maxsize ) {
+          MARLINMT_THROW( "RingQueue: maximum size can't be 0" ) ;
+        }
+        _buffer.reset( new Cell[maxsize] ) ;
+        for( std::size_t i=0 ; i<maxsize ; ++i ) {
+          _buffer[i]._sequence.store( i, std::memory_order_relaxed ) ;
+        }
+        _maxSize = maxsize ;
+        _enqueuePos.store( 0, std::memory_order_relaxed ) ;
+        _dequeuePos.store( 0, std::memory_order_relaxed ) ;
+      }
+
+    private:
+      /// The ring buffer slots
+      std::unique_ptr<Cell[]>                                _buffer {nullptr} ;
+      /// The maximum size of the queue (number of slots)
+      std::size_t                                            _maxSize {0} ;
+      /// The next position to write to (producers)
+      alignas(CacheLineSize) std::atomic<std::size_t>        _enqueuePos {0} ;
+      /// The next position to read from (consumers)
+      alignas(CacheLineSize) std::atomic<std::size_t>        _dequeuePos {0} ;
+    };
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
+
+#endif
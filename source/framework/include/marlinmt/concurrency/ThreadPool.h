@@ -11,40 +11,49 @@
 #include <memory>
 #include <future>
 #include <condition_variable>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <exception>
 
 // -- marlinmt headers
 #include "marlinmt/Exceptions.h"
 #include "marlinmt/concurrency/Queue.h"
+#include "marlinmt/concurrency/RingQueue.h"
 #include "marlinmt/concurrency/QueueElement.h"
 
 namespace marlinmt {
 
   namespace concurrency {
 
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     class Worker ;
 
     /**
      *  @brief  ThreadPool class
-     *  The template parameter T is the type of data to enqueue and process
-     *  in worker threads
+     *  The template parameters IN and OUT are the types of data to enqueue
+     *  and process in worker threads. The QUEUE parameter is the task queue
+     *  implementation: the lock-free RingQueue by default, or the mutex
+     *  based Queue. Both provide the same interface
      */
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE = RingQueue<QueueElement<IN,OUT>>>
     class ThreadPool {
     public:
-      using QueueType = Queue<QueueElement<IN,OUT>> ;
-      using PoolType = std::vector<std::shared_ptr<Worker<IN,OUT>>> ;
+      using QueueType = QUEUE ;
+      using WorkerType = Worker<IN,OUT,QUEUE> ;
+      using PoolType = std::vector<std::shared_ptr<WorkerType>> ;
       using Promise = std::shared_ptr<std::promise<OUT>> ;
       using Future = std::future<OUT> ;
       using PushResult = std::pair<Promise,Future> ;
-      friend class Worker<IN,OUT> ;
+      using Clock = std::chrono::steady_clock ;
+      friend class Worker<IN,OUT,QUEUE> ;
 
     public:
       /**
        *  @brief  PushPolicy enumerator
        */
       enum class PushPolicy {
-        Blocking,      ///< Block until a slot is free in the queue
+        Blocking,      ///< Block (sleeping) until a slot is free in the queue
         ThrowIfFull    ///< Throw an exception if the queue is full
       };
 
@@ -69,10 +78,26 @@ namespace marlinmt {
       void addWorker(Args &&...args) ;
 
       /**
-       *  @brief  Start the worker threads
+       *  @brief  Set the CPU of each worker. The worker N is pinned on the
+       *  CPU cpus[N % cpus.size()] before its initialization. An empty list
+       *  (default) means no pinning. Must be called before start()
+       *
+       *  @param  cpus the worker CPU list (see concurrency::workerCpus())
+       */
+      void setWorkerCpus( const std::vector<unsigned int> &cpus ) ;
+
+      /**
+       *  @brief  Start the worker threads and wait for all workers to be
+       *  initialized (see WorkerBase::initialize()). If a worker initialization
+       *  throws, the pool is stopped and the exception is rethrown here
        */
       void start() ;
 
+      /**
+       *  @brief  Get the number of workers pinned on a CPU
+       */
+      std::size_t nPinnedWorkers() const ;
+
       /**
        *  @brief  Get the thread pool size
        */
@@ -92,6 +117,25 @@ namespace marlinmt {
        *  @brief  Get the number of free slots in the task queue
        */
       std::size_t freeSlots() const ;
+
+      /**
+       *  @brief  Get the maximum queue size
+       */
+      std::size_t maxQueueSize() const ;
+
+      /**
+       *  @brief  Set the number of active workers. The workers with an index
+       *  greater or equal to this number finish their current task and park
+       *  until they are activated again. By default all workers are active
+       *
+       *  @param  nActive the number of active workers, in [1, size()]
+       */
+      void setActiveWorkers( std::size_t nActive ) ;
+
+      /**
+       *  @brief  Get the number of active workers
+       */
+      std::size_t activeWorkers() const ;
       
       /**
        *  @brief  Whether the queue is empty
@@ -150,6 +194,52 @@ namespace marlinmt {
       template <class = typename std::enable_if<not std::is_same<IN,void>::value>::type>
       PushResult push( PushPolicy policy, IN && input ) ;
 
+      /**
+       *  @brief  Push a new task in the task queue, without tracking its result.
+       *  No promise/future pair is allocated and the output of the task
+       *  is discarded. Use this when the worker reports its output by other
+       *  means. See PushPolicy for runtime behavior of enqueuing.
+       *
+       *  @param  policy the push policy
+       *  @param  input the task input data
+       */
+      template <class = typename std::enable_if<not std::is_same<IN,void>::value>::type>
+      void post( PushPolicy policy, IN && input ) ;
+
+      /**
+       *  @brief  Get the total time spent by the callers of push()
+       *  waiting for a free slot in the queue (Blocking policy only)
+       */
+      Clock::duration pushWaitTime() const ;
+
+      /**
+       *  @brief  Get the number of times push() had to wait
+       *  for a free slot in the queue (Blocking policy only)
+       */
+      std::size_t nPushWaits() const ;
+
+    private:
+      /**
+       *  @brief  Push an element in the task queue and wake up a worker
+       *
+       *  @param  policy the push policy
+       *  @param  element the queue element to push
+       */
+      void pushElement( PushPolicy policy, QueueElement<IN,OUT> &element ) ;
+
+      /**
+       *  @brief  Called by the workers once initialized
+       *
+       *  @param  exception the exception thrown by the worker initialization, if any
+       */
+      void workerInitialized( std::exception_ptr exception ) ;
+
+      /**
+       *  @brief  Wake up the threads blocked in push(), if any.
+       *  Called by the workers after having taken an element from the queue
+       */
+      void notifyFreeSlot() ;
+
     private:
       ///< The synchronization mutex
       std::mutex               _mutex {} ;
@@ -167,6 +257,32 @@ namespace marlinmt {
       std::atomic<bool>        _isRunning {false} ;
       ///< Whether the thread pool accepts push action
       std::atomic<bool>        _acceptPush {true} ;
+      ///< The number of workers sleeping on the condition variable
+      std::atomic<std::size_t> _nSleepingWorkers {0} ;
+      ///< The number of active workers. The others are parked
+      std::atomic<std::size_t> _nActiveWorkers {std::numeric_limits<std::size_t>::max()} ;
+      ///< The condition variable notified when the number of active workers changes
+      std::condition_variable  _parkConditionVariable {} ;
+      ///< The synchronization mutex for blocked push calls
+      mutable std::mutex       _pushMutex {} ;
+      ///< The condition variable notified when a queue slot is freed
+      std::condition_variable  _pushConditionVariable {} ;
+      ///< The number of threads blocked in push()
+      std::atomic<std::size_t> _nWaitingPushers {0} ;
+      ///< The total time spent waiting in push() (guarded by _pushMutex)
+      Clock::duration          _pushWaitTime {0} ;
+      ///< The number of waits in push() (guarded by _pushMutex)
+      std::size_t              _nPushWaits {0} ;
+      ///< The CPU of each worker (empty: no pinning)
+      std::vector<unsigned int> _workerCpus {} ;
+      ///< The synchronization mutex for the worker initializations
+      std::mutex               _initMutex {} ;
+      ///< The condition variable notified when a worker is initialized
+      std::condition_variable  _initConditionVariable {} ;
+      ///< The number of initialized workers (guarded by _initMutex)
+      std::size_t              _nInitialized {0} ;
+      ///< The first exception thrown by a worker initialization (guarded by _initMutex)
+      std::exception_ptr       _initException {nullptr} ;
     };
 
   }
@@ -180,28 +296,28 @@ namespace marlinmt {
 
   namespace concurrency {
 
-    template <typename IN, typename OUT>
-    inline ThreadPool<IN,OUT>::~ThreadPool() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline ThreadPool<IN,OUT,QUEUE>::~ThreadPool() {
       stop(true) ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     template <typename WORKER, typename ...Args>
-    inline void ThreadPool<IN,OUT>::addWorker(Args &&...args) {
+    inline void ThreadPool<IN,OUT,QUEUE>::addWorker(Args &&...args) {
       if( _isRunning ) {
         throw Exception( "ThreadPool::addWorker: thread pool is running, can't add a worker!" ) ;
       }
       std::unique_ptr<WORKER> impl( new WORKER(args...) ) ;
-      auto worker = std::make_shared<Worker<IN,OUT>>( *this, std::move( impl ) ) ;
+      auto worker = std::make_shared<WorkerType>( *this, _pool.size(), std::move( impl ) ) ;
       _pool.push_back( worker ) ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void ThreadPool<IN,OUT>::start() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::start() {
       if( _isRunning ) {
         throw Exception( "ThreadPool::start: already running!" ) ;
       }
@@ -210,19 +326,62 @@ namespace marlinmt {
         _pool[i]->start() ;
       }
       _isRunning = true ;
+      std::exception_ptr exception {nullptr} ;
+      {
+        std::unique_lock<std::mutex> lock(_initMutex) ;
+        _initConditionVariable.wait(lock, [this](){
+          return ( _nInitialized >= _pool.size() ) ;
+        }) ;
+        exception = _initException ;
+      }
+      if( nullptr != exception ) {
+        stop( true ) ;
+        std::rethrow_exception( exception ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::setWorkerCpus( const std::vector<unsigned int> &cpus ) {
+      if( _isRunning ) {
+        throw Exception( "ThreadPool::setWorkerCpus: thread pool is running, can't set the worker CPUs!" ) ;
+      }
+      _workerCpus = cpus ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::nPinnedWorkers() const {
+      return std::count_if( _pool.begin(), _pool.end(), []( const std::shared_ptr<WorkerType> &worker ){
+        return worker->pinned() ;
+      }) ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline std::size_t ThreadPool<IN,OUT>::size() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::workerInitialized( std::exception_ptr exception ) {
+      std::lock_guard<std::mutex> lock(_initMutex) ;
+      if( nullptr != exception and nullptr == _initException ) {
+        _initException = exception ;
+      }
+      ++_nInitialized ;
+      _initConditionVariable.notify_all() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::size() const {
       return _pool.size() ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline std::size_t ThreadPool<IN,OUT>::nWaiting() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::nWaiting() const {
       std::size_t count = 0 ;
       for( auto &worker : _pool ) {
         if( worker->waiting() ) {
@@ -234,57 +393,85 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline std::size_t ThreadPool<IN,OUT>::nRunning() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::nRunning() const {
       return ( _pool.size() - nWaiting() ) ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline std::size_t ThreadPool<IN,OUT>::freeSlots() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::freeSlots() const {
       return _queue.freeSlots() ;
     }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::maxQueueSize() const {
+      return _queue.maxSize() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::setActiveWorkers( std::size_t nActive ) {
+      if( 0 == nActive or nActive > _pool.size() ) {
+        throw Exception( "ThreadPool::setActiveWorkers: number of active workers must be in [1, pool size]!" ) ;
+      }
+      std::unique_lock<std::mutex> lock(_mutex) ;
+      _nActiveWorkers = nActive ;
+      // wake up the parked workers and the sleeping workers to park
+      _parkConditionVariable.notify_all() ;
+      _conditionVariable.notify_all() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::activeWorkers() const {
+      return std::min( _nActiveWorkers.load(), _pool.size() ) ;
+    }
     
     //--------------------------------------------------------------------------
     
-    template <typename IN, typename OUT>
-    inline bool ThreadPool<IN,OUT>::isQueueEmpty() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool ThreadPool<IN,OUT,QUEUE>::isQueueEmpty() const {
       return _queue.empty() ;
     }
     
     //--------------------------------------------------------------------------
     
-    template <typename IN, typename OUT>
-    inline void ThreadPool<IN,OUT>::setMaxQueueSize( std::size_t maxQueueSize ) {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::setMaxQueueSize( std::size_t maxQueueSize ) {
       _queue.setMaxSize( maxQueueSize ) ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void ThreadPool<IN,OUT>::clearQueue() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::clearQueue() {
       _queue.clear() ;
     }
     
     //--------------------------------------------------------------------------
     
-    template <typename IN, typename OUT>
-    inline void ThreadPool<IN,OUT>::setAcceptPush( bool accept ) {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::setAcceptPush( bool accept ) {
       _acceptPush = accept ;
     }
     
     //--------------------------------------------------------------------------
     
-    template <typename IN, typename OUT>
-    inline bool ThreadPool<IN,OUT>::acceptPush() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool ThreadPool<IN,OUT,QUEUE>::acceptPush() const {
       return _acceptPush.load() ;
     }
     
     //--------------------------------------------------------------------------
     
-    template <typename IN, typename OUT>
-    inline bool ThreadPool<IN,OUT>::active() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool ThreadPool<IN,OUT,QUEUE>::active() const {
       if( not _queue.empty() ) {
         return true ;
       }
@@ -298,8 +485,8 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void ThreadPool<IN,OUT>::stop( bool clear ) {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::stop( bool clear ) {
       if ( clear ) {
         if (_isStop) {
           return ;
@@ -319,6 +506,11 @@ namespace marlinmt {
       {
         std::unique_lock<std::mutex> lock(_mutex);
         _conditionVariable.notify_all();  // stop all waiting threads
+        _parkConditionVariable.notify_all();  // stop all parked threads
+      }
+      {
+        std::unique_lock<std::mutex> lock(_pushMutex);
+        _pushConditionVariable.notify_all();  // release the blocked push calls
       }
       for (auto &worker : _pool) {  // wait for the computing threads to finish
         worker->join() ;
@@ -330,9 +522,9 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     template <class>
-    inline typename ThreadPool<IN,OUT>::PushResult ThreadPool<IN,OUT>::push(PushPolicy policy, IN && queueData) {
+    inline typename ThreadPool<IN,OUT,QUEUE>::PushResult ThreadPool<IN,OUT,QUEUE>::push(PushPolicy policy, IN && queueData) {
       if( not _isRunning.load() ) {
         throw Exception( "ThreadPool::push: pool not running yet!" ) ;
       }
@@ -343,24 +535,92 @@ namespace marlinmt {
       PushResult result ;
       result.first = element.promise() ;
       result.second = result.first->get_future() ;
+      pushElement( policy, element ) ;
+      return result ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    template <class>
+    inline void ThreadPool<IN,OUT,QUEUE>::post(PushPolicy policy, IN && queueData) {
+      if( not _isRunning.load() ) {
+        throw Exception( "ThreadPool::post: pool not running yet!" ) ;
+      }
+      if( not _acceptPush.load() ) {
+        throw Exception( "ThreadPool::post: not allowed to push in pool!" ) ;
+      }
+      QueueElement<IN,OUT> element( std::move(queueData), nullptr ) ;
+      pushElement( policy, element ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::pushElement( PushPolicy policy, QueueElement<IN,OUT> &element ) {
       if(policy == PushPolicy::Blocking) {
-        // this is dirty yet
-        // TODO find a proper implementation ...
-        while( _queue.isFull() ) {
-          std::this_thread::sleep_for( std::chrono::microseconds(10) ) ;
+        if( not _queue.push(element) ) {
+          // queue full: sleep until a worker takes an element out
+          std::unique_lock<std::mutex> lock(_pushMutex) ;
+          const auto waitStart = Clock::now() ;
+          ++_nWaitingPushers ;
+          // pairs with the fence in notifyFreeSlot()
+          std::atomic_thread_fence( std::memory_order_seq_cst ) ;
+          bool pushed = false ;
+          _pushConditionVariable.wait(lock, [this, &element, &pushed](){
+            pushed = _queue.push(element) ;
+            return pushed || _isStop || _isDone ;
+          }) ;
+          --_nWaitingPushers ;
+          _pushWaitTime += Clock::now() - waitStart ;
+          ++_nPushWaits ;
+          if( not pushed ) {
+            throw Exception( "ThreadPool::push: pool stopped while waiting for a free slot!" ) ;
+          }
         }
-        // this is not really safe
-        _queue.push(element) ;
       }
       else {
-        if( _queue.isFull() ) {
+        if( not _queue.push(element) ) {
           throw Exception( "ThreadPool::push: queue is full!" ) ;
         }
-        _queue.push(element) ;
       }
-      std::unique_lock<std::mutex> lock(_mutex) ;
-      _conditionVariable.notify_one() ;
-      return std::move(result) ;
+      // Only take the lock if a worker is sleeping. The fence pairs with
+      // the one in Worker::run() so that either the worker sees the new
+      // element before sleeping or we see the worker sleeping here
+      std::atomic_thread_fence( std::memory_order_seq_cst ) ;
+      if( _nSleepingWorkers.load() > 0 ) {
+        std::unique_lock<std::mutex> lock(_mutex) ;
+        _conditionVariable.notify_one() ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline typename ThreadPool<IN,OUT,QUEUE>::Clock::duration ThreadPool<IN,OUT,QUEUE>::pushWaitTime() const {
+      std::unique_lock<std::mutex> lock(_pushMutex) ;
+      return _pushWaitTime ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline std::size_t ThreadPool<IN,OUT,QUEUE>::nPushWaits() const {
+      std::unique_lock<std::mutex> lock(_pushMutex) ;
+      return _nPushWaits ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void ThreadPool<IN,OUT,QUEUE>::notifyFreeSlot() {
+      // Only take the lock if a thread is blocked in push(). The fence
+      // pairs with the one in push() (see also Worker::run())
+      std::atomic_thread_fence( std::memory_order_seq_cst ) ;
+      if( _nWaitingPushers.load() > 0 ) {
+        std::unique_lock<std::mutex> lock(_pushMutex) ;
+        _pushConditionVariable.notify_all() ;
+      }
     }
 
   } // end namespace concurrency
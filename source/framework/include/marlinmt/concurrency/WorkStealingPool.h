@@ -0,0 +1,130 @@
+#ifndef MARLINMT_CONCURRENCY_WORKSTEALINGPOOL_h
+#define MARLINMT_CONCURRENCY_WORKSTEALINGPOOL_h 1
+
+// -- std headers
+#include <functional>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <condition_variable>
+
+// -- marlinmt headers
+#include "marlinmt/concurrency/CacheLine.h"
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    /**
+     *  @brief  WorkStealingPool class
+     *  A thread pool where each worker owns a task queue. Tasks submitted
+     *  from a worker thread go to the queue of this worker, which processes
+     *  them in LIFO order for better cache locality. Tasks submitted from
+     *  outside the pool are distributed over the worker queues in a round
+     *  robin manner. Idle workers steal tasks from the front of the other
+     *  worker queues before going to sleep.
+     *  Tasks receive the index of the worker executing them, making it
+     *  possible to use per-worker resources without locking.
+     */
+    class WorkStealingPool {
+    public:
+      using Task = std::function<void(std::size_t)> ;
+
+    public:
+      WorkStealingPool() = default ;
+      WorkStealingPool(const WorkStealingPool &) = delete ;
+      WorkStealingPool(WorkStealingPool &&) = delete ;
+      WorkStealingPool& operator=(const WorkStealingPool &) = delete ;
+      WorkStealingPool& operator=(WorkStealingPool &&) = delete ;
+
+      /**
+       *  @brief  Destructor. Stop the pool
+       */
+      ~WorkStealingPool() ;
+
+      /**
+       *  @brief  Start the worker threads
+       *
+       *  @param  nworkers the number of worker threads to start
+       */
+      void start( std::size_t nworkers ) ;
+
+      /**
+       *  @brief  Stop the pool. The tasks already submitted are processed
+       *  and the worker threads are joined
+       */
+      void stop() ;
+
+      /**
+       *  @brief  Submit a new task
+       *
+       *  @param  task the task to execute
+       */
+      void submit( Task task ) ;
+
+      /**
+       *  @brief  Get the number of worker threads
+       */
+      std::size_t size() const ;
+
+      /**
+       *  @brief  Get the number of tasks stolen by workers from other worker queues
+       */
+      std::size_t nStolenTasks() const ;
+
+    private:
+      /**
+       *  @brief  TaskQueue struct
+       *  The task queue owned by a worker
+       */
+      struct alignas(CacheLineSize) TaskQueue {
+        ///< The synchronization mutex
+        std::mutex                _mutex {} ;
+        ///< The task list
+        std::deque<Task>          _tasks {} ;
+      };
+
+      /**
+       *  @brief  The method executing in the worker threads
+       *
+       *  @param  index the worker index
+       */
+      void run( std::size_t index ) ;
+
+      /**
+       *  @brief  Take a task from the worker queue or steal one from the other queues
+       *
+       *  @param  index the worker index
+       *  @param  task the task to receive
+       */
+      bool takeTask( std::size_t index, Task &task ) ;
+
+    private:
+      ///< The per worker task queues
+      std::vector<std::unique_ptr<TaskQueue>>   _queues {} ;
+      ///< The worker threads
+      std::vector<std::thread>                  _threads {} ;
+      ///< The synchronization mutex for sleeping workers
+      std::mutex                                _mutex {} ;
+      ///< The condition variable notified on task submission
+      std::condition_variable                   _conditionVariable {} ;
+      ///< The number of tasks submitted and not taken yet
+      std::atomic<std::size_t>                  _nPendingTasks {0} ;
+      ///< The number of workers sleeping on the condition variable
+      std::atomic<std::size_t>                  _nSleepingWorkers {0} ;
+      ///< The next queue for tasks submitted from outside the pool
+      std::atomic<std::size_t>                  _nextQueue {0} ;
+      ///< The number of stolen tasks
+      std::atomic<std::size_t>                  _nStolenTasks {0} ;
+      ///< The pool stop flag
+      std::atomic<bool>                         _stop {false} ;
+    };
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
+
+#endif
@@ -12,18 +12,20 @@
 #include <future>
 #include <queue>
 #include <condition_variable>
+#include <exception>
 
 // -- marlinmt headers
 #include "marlinmt/Exceptions.h"
 #include "marlinmt/concurrency/QueueElement.h"
+#include "marlinmt/concurrency/CpuResources.h"
 
 namespace marlinmt {
 
   namespace concurrency {
 
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     class ThreadPool ;
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     class Worker ;
 
     /**
@@ -35,7 +37,7 @@ namespace marlinmt {
      */
     template <typename IN, typename OUT>
     class WorkerBase {
-      friend class Worker<IN,OUT> ;
+      template <typename, typename, typename> friend class Worker ;
     public:
       using Input = IN ;
       using Output = OUT ;
@@ -50,6 +52,14 @@ namespace marlinmt {
        */
       virtual OUT process( IN && data ) = 0 ;
 
+      /**
+       *  @brief  Initialize the worker. Called once in the worker thread, after
+       *  the thread has been pinned (see ThreadPool::setWorkerCpus()) and before
+       *  processing any data. Per-thread data allocated here is first-touched
+       *  on the memory node of the worker
+       */
+      virtual void initialize() { /* nop */ }
+
     protected:
       /**
        *  @brief  Process queued element from the thread pool
@@ -64,10 +74,11 @@ namespace marlinmt {
 
     template <typename OUT>
     class WorkerBase<void,OUT> {
-      friend class Worker<void,OUT> ;
+      template <typename, typename, typename> friend class Worker ;
     public:
       virtual ~WorkerBase() = default ;
       virtual OUT process() = 0 ;
+      virtual void initialize() { /* nop */ }
     protected:
       void processElement( QueueElement<void,OUT> &element ) ;
     };
@@ -76,10 +87,11 @@ namespace marlinmt {
 
     template <typename IN>
     class WorkerBase<IN,void> {
-      friend class Worker<IN,void> ;
+      template <typename, typename, typename> friend class Worker ;
     public:
       virtual ~WorkerBase() = default ;
       virtual void process( IN && data ) = 0 ;
+      virtual void initialize() { /* nop */ }
     protected:
       void processElement( QueueElement<IN,void> &element ) ;
     };
@@ -88,10 +100,11 @@ namespace marlinmt {
 
     template <>
     class WorkerBase<void,void> {
-      friend class Worker<void,void> ;
+      template <typename, typename, typename> friend class Worker ;
     public:
       virtual ~WorkerBase() = default ;
       virtual void process() = 0 ;
+      virtual void initialize() { /* nop */ }
     protected:
       void processElement( QueueElement<void,void> &element ) ;
     };
@@ -126,12 +139,12 @@ namespace marlinmt {
     /**
      *  @brief  Worker class
      */
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     class Worker {
     public:
       using Input = IN ;
       using Output = OUT ;
-      using Pool = ThreadPool<IN, OUT> ;
+      using Pool = ThreadPool<IN, OUT, QUEUE> ;
       using Impl = WorkerBase<IN,OUT> ;
 
     public:
@@ -145,10 +158,11 @@ namespace marlinmt {
        *  @brief  Constructor
        *
        *  @param  pool the parent thread pool
+       *  @param  index the worker index in the pool
        *  @param  impl the worker implementation consuming IN data, producing OUT data
        */
       template <typename IMPL, class = typename std::enable_if<std::is_base_of<Impl,IMPL>::value>::type>
-      Worker( Pool &pool, std::unique_ptr<IMPL> impl ) ;
+      Worker( Pool &pool, std::size_t index, std::unique_ptr<IMPL> impl ) ;
 
       /**
        *  @brief  Start the worker thread
@@ -176,20 +190,48 @@ namespace marlinmt {
        */
       bool waiting() const ;
 
+      /**
+       *  @brief  Whether the worker thread has been pinned on a CPU
+       */
+      bool pinned() const ;
+
+      /**
+       *  @brief  Whether the worker is parked, meaning that its index
+       *  is above the number of active workers of the pool
+       */
+      bool parked() const ;
+
       /**
        *  @brief  Join the worker thread
        */
       void join() ;
 
+    private:
+      /**
+       *  @brief  Pin the worker thread, if required by the pool, and
+       *  initialize the worker implementation. Called in the worker thread
+       */
+      void initialize() ;
+
+      /**
+       *  @brief  Sleep until the worker is not parked anymore
+       *  or the pool is stopped. Returns false in the latter case
+       */
+      bool park() ;
+
     private:
       ///< The parent thread pool
       Pool                        &_threadPool ;
+      ///< The worker index in the pool
+      const std::size_t            _index ;
       ///< The worker thread
       std::thread                  _thread {} ;
       ///< The stop flag
       std::atomic<bool>            _stopFlag {false} ;
       ///< Whether the worker thread is waiting for data
       std::atomic<bool>            _waitingFlag {false} ;
+      ///< Whether the worker thread has been pinned on a CPU
+      std::atomic<bool>            _pinnedFlag {false} ;
       ///< The worker implementation
       std::unique_ptr<Impl>        _impl {nullptr} ;
     };
@@ -205,45 +247,66 @@ namespace marlinmt {
 
   namespace concurrency {
 
-    template <typename IN, typename OUT>
+    template <typename IN, typename OUT, typename QUEUE>
     template <typename IMPL, class>
-    inline Worker<IN,OUT>::Worker( Pool & pool, std::unique_ptr<IMPL> impl ) :
+    inline Worker<IN,OUT,QUEUE>::Worker( Pool & pool, std::size_t index, std::unique_ptr<IMPL> impl ) :
       _threadPool(pool),
+      _index(index),
       _impl(std::move(impl)) {
       /* nop */
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void Worker<IN,OUT>::start() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void Worker<IN,OUT,QUEUE>::start() {
       _thread = std::thread( &Worker::run, this ) ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void Worker<IN,OUT>::run() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void Worker<IN,OUT,QUEUE>::run() {
+      initialize() ;
       QueueElement<IN,OUT> element ;
-      bool isPop = _threadPool._queue.pop( element ) ;
+      bool isPop = ( not parked() ) and _threadPool._queue.pop( element ) ;
       while (true) {
         // if there is anything in the queue
         while (isPop) {
+          // a slot has been freed in the queue
+          _threadPool.notifyFreeSlot() ;
           _impl->processElement( element ) ;
           // the thread is wanted to stop, return even if the queue is not empty yet
           if (_stopFlag.load())
             return;
           else
-            isPop = _threadPool._queue.pop( element ) ;
+            isPop = ( not parked() ) and _threadPool._queue.pop( element ) ;
+        }
+        if ( parked() ) {
+          if ( not park() ) {
+            return ;
+          }
+          isPop = _threadPool._queue.pop( element ) ;
+          continue ;
         }
         // the queue is empty here, wait for the next command
         std::unique_lock<std::mutex> lock(_threadPool._mutex);
         _waitingFlag = true ;
+        ++_threadPool._nSleepingWorkers ;
+        // pairs with the fence in ThreadPool::push()
+        std::atomic_thread_fence( std::memory_order_seq_cst ) ;
         _threadPool._conditionVariable.wait(lock, [this, &element, &isPop](){
-          isPop = _threadPool._queue.pop( element ) ;
-          return isPop || _threadPool._isDone || _stopFlag ;
+          isPop = ( not parked() ) and _threadPool._queue.pop( element ) ;
+          return isPop || parked() || _threadPool._isDone || _stopFlag ;
         }) ;
+        --_threadPool._nSleepingWorkers ;
         _waitingFlag = false ;
+        if ( not isPop and parked() and not ( _threadPool._isDone || _stopFlag ) ) {
+          // the notification may have been meant for an active
+          // worker: pass it on before parking
+          _threadPool._conditionVariable.notify_one() ;
+          continue ;
+        }
         // if the queue is empty and this->isDone == true or *flag then return
         if ( not isPop ) {
           return ;
@@ -253,29 +316,76 @@ namespace marlinmt {
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void Worker<IN,OUT>::stop() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void Worker<IN,OUT,QUEUE>::initialize() {
+      const auto &cpus = _threadPool._workerCpus ;
+      if( not cpus.empty() ) {
+        _pinnedFlag = pinCurrentThread( cpus[ _index % cpus.size() ] ) ;
+      }
+      std::exception_ptr exception {nullptr} ;
+      try {
+        // worker initializations are serialized
+        std::lock_guard<std::mutex> lock( _threadPool._initMutex ) ;
+        _impl->initialize() ;
+      }
+      catch(...) {
+        exception = std::current_exception() ;
+      }
+      _threadPool.workerInitialized( exception ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool Worker<IN,OUT,QUEUE>::park() {
+      std::unique_lock<std::mutex> lock(_threadPool._mutex);
+      _waitingFlag = true ;
+      _threadPool._parkConditionVariable.wait(lock, [this](){
+        return ( not parked() ) || _threadPool._isDone || _stopFlag ;
+      }) ;
+      _waitingFlag = false ;
+      return not ( parked() || _stopFlag ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void Worker<IN,OUT,QUEUE>::stop() {
       _stopFlag = true ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline bool Worker<IN,OUT>::running() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool Worker<IN,OUT,QUEUE>::running() const {
       return ( _thread.get_id() != std::thread::id() ) ;
     }
     
     //--------------------------------------------------------------------------
     
-    template <typename IN, typename OUT>
-    inline bool Worker<IN,OUT>::waiting() const {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool Worker<IN,OUT,QUEUE>::waiting() const {
       return _waitingFlag.load() ;
     }
 
     //--------------------------------------------------------------------------
 
-    template <typename IN, typename OUT>
-    inline void Worker<IN,OUT>::join() {
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool Worker<IN,OUT,QUEUE>::pinned() const {
+      return _pinnedFlag.load() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline bool Worker<IN,OUT,QUEUE>::parked() const {
+      return ( _index >= _threadPool._nActiveWorkers.load() ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    template <typename IN, typename OUT, typename QUEUE>
+    inline void Worker<IN,OUT,QUEUE>::join() {
       if( _thread.joinable() ) {
         _thread.join() ;
       }
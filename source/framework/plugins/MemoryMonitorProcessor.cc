@@ -83,16 +83,13 @@ namespace marlinmt {
                                   &t_info_count)) {
       log<ERROR>() << "Problem accessing system information from  MacOS X!"<< std::endl ;
     }
-    log<MESSAGE>() << " Processed event  " << _eventNumber
-    << " Resident size is: "<< t_info.resident_size<<" virtual size: "<<t_info.virtual_size
-    << std::endl ;
+    logLine<MESSAGE>( " Processed event  ", _eventNumber,
+      " Resident size is: ", t_info.resident_size, " virtual size: ", t_info.virtual_size ) ;
 #else
     struct sysinfo memInfo;
     sysinfo (&memInfo);
     unsigned long physMemUsed = memInfo.totalram - memInfo.freeram;
-    log<MESSAGE>() << " Processed event  " << _eventNumber
-                          << " Physical memory in use: " << physMemUsed
-                          << std::endl ;
+    logLine<MESSAGE>( " Processed event  ", _eventNumber, " Physical memory in use: ", physMemUsed ) ;
 #endif
     }
   	_eventNumber++ ;
@@ -83,9 +83,7 @@ namespace marlinmt {
   void Statusmonitor::processEvent( EventStore *  ) {
     auto eventid = _nEvt.fetch_add(1) ;
     if (eventid % _howOften == 0) {
-      log<MESSAGE>()
-        << " ===== Run  : " << std::setw(7) << _nRun
-        << "  Event: " << std::setw(7) << eventid << std::endl;
+      MARLINMT_LOG_LINE( *this, MESSAGE, " ===== Run  : ", std::setw(7), _nRun, "  Event: ", std::setw(7), eventid ) ;
     }
   }
 
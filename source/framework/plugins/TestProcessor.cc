@@ -98,19 +98,17 @@ namespace marlinmt {
     const bool calibrate = (eventCounter % 3 ) == 0 ;
 
     if( firstEvent ) {
-      log<DEBUG>() << " This is the first event ! uid = " << evt->uid() << std::endl ;
+      MARLINMT_LOG_LINE( *this, DEBUG, " This is the first event ! uid = ", evt->uid() ) ;
     }
     ProcessorApi::setReturnValue( this, evt, "Calibrating", calibrate ) ;
 
     if( calibrate ) {
-      log<MESSAGE>() << "processEvent()  ---CALIBRATING ------ "
-			      << " in event uid " << evt->uid()
-			      << std::endl ;
+      MARLINMT_LOG_LINE( *this, MESSAGE, "processEvent()  ---CALIBRATING ------ ", " in event uid ", evt->uid() ) ;
     }
 
-    log<MESSAGE>() << " processing event uid " << evt->uid() << std::endl ;
+    MARLINMT_LOG_LINE( *this, MESSAGE, " processing event uid ", evt->uid() ) ;
 
-    log<MESSAGE>() << "(MESSAGE) local verbosity level: " << verbosity() << std::endl ;
+    MARLINMT_LOG_LINE( *this, MESSAGE, "(MESSAGE) local verbosity level: ", verbosity() ) ;
 
     // always return true for this processor
     ProcessorApi::setReturnValue( this, evt, true ) ;
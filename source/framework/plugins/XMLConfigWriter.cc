@@ -118,7 +118,8 @@ namespace marlinmt {
         {"ProcessorName", "name"},
         {"ProcessorType", "type"},
         {"ProcessorCritical", "critical"},
-        {"ProcessorClone", "clone"}
+        {"ProcessorClone", "clone"},
+        {"ProcessorOrdered", "ordered"}
       } ) ) ;
     }
     
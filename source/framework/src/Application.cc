@@ -10,6 +10,8 @@
 #include <marlinmt/IScheduler.h>
 #include <marlinmt/SimpleScheduler.h>
 #include <marlinmt/concurrency/PEPScheduler.h>
+#include <marlinmt/concurrency/DAGScheduler.h>
+#include <marlinmt/concurrency/ReadAheadBuffer.h>
 #include <marlinmt/EventStore.h>
 #include <marlinmt/RunHeader.h>
 
@@ -20,6 +22,14 @@
 using namespace std::placeholders ;
 
 namespace marlinmt {
+
+  Application::Application() = default ;
+
+  //--------------------------------------------------------------------------
+
+  Application::~Application() = default ;
+
+  //--------------------------------------------------------------------------
   
   int Application::main( int argc, char**argv ) {
     // configure and run application
@@ -99,19 +109,50 @@ namespace marlinmt {
     
     // initialize geometry
     _geometryMgr.setup( this ) ;
+
+    // initialize random seeds. Use a fixed global seed by default for reproducible runs
+    unsigned int globalSeed {0} ;
+    if( configuration().hasSection("global") ) {
+      globalSeed = configuration().section("global").parameter<unsigned int>( "RandomSeed", 0 ) ;
+    }
+    _randomSeedMgr.setGlobalSeed( globalSeed ) ;
+
+    // processor timing mode, applied by the scheduler to its sequences
+    if( configuration().hasSection("global") ) {
+      auto &globalSection = configuration().section("global") ;
+      _timingMode = timingModeFromString( globalSection.parameter<std::string>( "ProcessorTiming", "full" ) ) ;
+      _timingSampling = globalSection.parameter<unsigned int>( "ProcessorTimingSampling", 100 ) ;
+      if( 0 == _timingSampling ) {
+        MARLINMT_THROW( "ProcessorTimingSampling can't be 0 !" ) ;
+      }
+    }
     
     // setup scheduler
     if( 0 == _parseResult._nthreads ) {
       MARLINMT_THROW( "Number of threads can't be 0 !" ) ;
     }
-    if( 1 == _parseResult._nthreads ) {
+    std::string schedulerType {} ;
+    if( configuration().hasSection("scheduler") ) {
+      schedulerType = configuration().section("scheduler").parameter<std::string>( "SchedulerType", "" ) ;
+    }
+    if( schedulerType.empty() ) {
+      schedulerType = ( 1 == _parseResult._nthreads ) ? "Simple" : "PEP" ;
+    }
+    if( "Simple" == schedulerType ) {
       logger()->log<MESSAGE>() << "Running in single-thread mode" << std::endl ;
       _scheduler = std::make_shared<SimpleScheduler>() ;
     }
-    else {
+    else if( "PEP" == schedulerType ) {
       logger()->log<MESSAGE>() << "Running in multi-thread mode (nthreads=" << _parseResult._nthreads << ")" << std::endl ;
       _scheduler = std::make_shared<concurrency::PEPScheduler>() ;
     }
+    else if( "DAG" == schedulerType ) {
+      logger()->log<MESSAGE>() << "Running in multi-thread mode with processor graph (nthreads=" << _parseResult._nthreads << ")" << std::endl ;
+      _scheduler = std::make_shared<concurrency::DAGScheduler>() ;
+    }
+    else {
+      MARLINMT_THROW( "Unknown scheduler type '" + schedulerType + "'" ) ;
+    }
     _scheduler->setup( this ) ;
 
     // initialize data source
@@ -121,8 +162,22 @@ namespace marlinmt {
       MARLINMT_THROW( "Data source of type '" + dstype + "' not found in plugins" ) ;
     }
     _dataSource->setup( this ) ;
-    _dataSource->onEventRead( std::bind( &Application::onEventRead, this, _1 ) ) ;
-    _dataSource->onRunHeaderRead( std::bind( &Application::onRunHeaderRead, this, _1 ) ) ;
+    _dataSource->setEventStorePool( &_eventStorePool ) ;
+    if( _dataSource->readAheadSize() > 0 ) {
+      // the data source runs in the reader thread and fills the read-ahead buffer
+      logger()->log<MESSAGE>() << "Reading data source in a dedicated thread (buffer size=" << _dataSource->readAheadSize() << ")" << std::endl ;
+      _readAhead = std::make_unique<concurrency::ReadAheadBuffer>( _dataSource->readAheadSize() ) ;
+      _dataSource->onEventRead( [this]( std::shared_ptr<EventStore> event ){
+        _readAhead->push( event ) ;
+      }) ;
+      _dataSource->onRunHeaderRead( [this]( std::shared_ptr<RunHeader> rhdr ){
+        _readAhead->push( rhdr ) ;
+      }) ;
+    }
+    else {
+      _dataSource->onEventRead( std::bind( &Application::onEventRead, this, _1 ) ) ;
+      _dataSource->onRunHeaderRead( std::bind( &Application::onRunHeaderRead, this, _1 ) ) ;
+    }
     
     // store processor conditions
     auto &execSection = _configuration.section("execute") ;
@@ -130,6 +185,7 @@ namespace marlinmt {
     for( auto &proc : procs ) {
       _conditions[ proc ] = execSection.parameter<std::string>( proc ) ;
     }
+    _compiledConditions = std::make_shared<const CompiledConditions>( _conditions ) ;
     _initialized = true ;
   }
 
@@ -142,7 +198,12 @@ namespace marlinmt {
       return ;
     }
     try {
-      _dataSource->readAll() ;
+      if( nullptr != _readAhead ) {
+        dispatchReadAhead() ;
+      }
+      else {
+        _dataSource->readAll() ;
+      }
     }
     catch( StopProcessingException &e ) {
       logger()->log<ERROR>() << std::endl
@@ -157,6 +218,11 @@ namespace marlinmt {
     }
     _geometryMgr.clear() ;
     _scheduler->end() ;
+    logger()->log<MESSAGE>() << "Event stores: " << _eventStorePool.nAllocated() << " allocated, "
+      << _eventStorePool.nRecycled() << " recycled" << std::endl ;
+    if( nullptr != _readAhead ) {
+      printReadAheadSummary() ;
+    }
     _bookStoreManager.writeToDisk();
   }
   
@@ -197,34 +263,34 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  std::shared_ptr<AsyncLogger> Application::asyncLogger() const {
+    return _loggerMgr.asyncLogger() ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void Application::onEventRead( std::shared_ptr<EventStore> event ) {
     EventList events ;
-    while( _scheduler->freeSlots() == 0 ) {
-      _scheduler->popFinishedEvents( events ) ;
-      if( not events.empty() ) {
-        processFinishedEvents( events ) ;
-        events.clear() ;
-        break;
-      }
-      std::this_thread::sleep_for( std::chrono::milliseconds(1) ) ;
-    }
-    // prepare event extensions for users
-    // random seeds extension
-    auto seeds = _randomSeedMgr.generateRandomSeeds( event.get() ) ;
-    auto randomSeedExtension = new RandomSeedExtension( std::move(seeds) ) ;
-    event->extensions().add<extensions::RandomSeed>( randomSeedExtension ) ;
-    // runtime conditions extension
-    // TODO replace this
-    auto procCondExtension = new ProcessorConditionsExtension( _conditions ) ;
-    event->extensions().add<extensions::ProcessorConditions>( procCondExtension )  ;
-    _scheduler->pushEvent( event ) ;
-    // check a second time
+    // the extensions are attached by the scheduler workers, see prepareEvent().
+    // blocks until a slot is free in the scheduler
+    _scheduler->pushEvent( std::move(event) ) ;
     _scheduler->popFinishedEvents( events ) ;
     if( not events.empty() ) {
       processFinishedEvents( events ) ;
+      recycleFinishedEvents( events ) ;
     }
   }
   
+  //--------------------------------------------------------------------------
+
+  void Application::prepareEvent( EventStore &event ) const {
+    // The extensions are recyclable: a recycled event store resets them in place.
+    // random seeds extension: only the event seed here, the processor seeds are computed on request
+    event.extensions().recyclable<extensions::RandomSeed, RandomSeedExtension>( _randomSeedMgr.eventSeed( event.uid() ) ) ;
+    // runtime conditions extension
+    event.extensions().recyclable<extensions::ProcessorConditions, ProcessorConditionsExtension>( _compiledConditions ) ;
+  }
+  
   //--------------------------------------------------------------------------
   
   void Application::onRunHeaderRead( std::shared_ptr<RunHeader> rhdr ) {
@@ -249,6 +315,18 @@ namespace marlinmt {
   RandomSeedManager &Application::randomSeedManager() {
     return _randomSeedMgr ;
   }
+
+  //--------------------------------------------------------------------------
+
+  TimingMode Application::processorTimingMode() const {
+    return _timingMode ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  unsigned int Application::processorTimingSampling() const {
+    return _timingSampling ;
+  }
   
   //--------------------------------------------------------------------------
   
@@ -261,6 +339,53 @@ namespace marlinmt {
     }
   }
   
+  //--------------------------------------------------------------------------
+
+  void Application::recycleFinishedEvents( EventList &events ) {
+    for( auto &event : events ) {
+      _eventStorePool.release( std::move(event) ) ;
+    }
+    events.clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Application::dispatchReadAhead() {
+    _readAhead->start( [this](){
+      while( (not _readAhead->stopped()) and _dataSource->readOne() ) ;
+    }) ;
+    concurrency::ReadAheadBuffer::Record record {} ;
+    try {
+      while( _readAhead->pop( record ) ) {
+        if( nullptr != record._event ) {
+          onEventRead( record._event ) ;
+        }
+        else {
+          onRunHeaderRead( record._runHeader ) ;
+        }
+      }
+    }
+    catch(...) {
+      // stop reading on processing error
+      _readAhead->stop() ;
+      throw ;
+    }
+    _readAhead->stop() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Application::printReadAheadSummary() const {
+    logger()->log<MESSAGE>() << "---------------------------------------------------" << std::endl ;
+    logger()->log<MESSAGE>() << "-- Read-ahead summary" << std::endl ;
+    logger()->log<MESSAGE>() << "--   Buffer size:                    " << _readAhead->maxSize() << std::endl ;
+    logger()->log<MESSAGE>() << "--   Records read:                   " << _readAhead->nRecords() << std::endl ;
+    logger()->log<MESSAGE>() << "--   Average buffer occupancy:       " << _readAhead->averageOccupancy() << std::endl ;
+    logger()->log<MESSAGE>() << "--   Reader stall time (full):       " << _readAhead->readerStallTime() << " ms" << std::endl ;
+    logger()->log<MESSAGE>() << "--   Dispatcher stall time (empty):  " << _readAhead->dispatcherStallTime() << " ms" << std::endl ;
+    logger()->log<MESSAGE>() << "---------------------------------------------------" << std::endl ;
+  }
+
   //--------------------------------------------------------------------------
   
   BookStoreManager &Application::bookStoreManager() {
@@ -310,6 +435,8 @@ namespace marlinmt {
     
     auto &globalSection = config.createSection("global") ;
     globalSection.setParameter( "RandomSeed", 1234567890 ) ;
+    globalSection.setParameter<std::string>( "ProcessorTiming", "full" ) ;
+    globalSection.setParameter( "ProcessorTimingSampling", 100 ) ;
     
     auto &procsSection = config.createSection("processors") ;
     auto pluginNames = pluginMgr.pluginNames<Processor>() ;
@@ -321,8 +448,10 @@ namespace marlinmt {
       procSection.setParameter( "ProcessorType", processor->type() ) ;
       auto criticalOpt = processor->runtimeOption( Processor::ERuntimeOption::eCritical ) ;
       auto cloneOpt = processor->runtimeOption( Processor::ERuntimeOption::eClone ) ;
+      auto orderedOpt = processor->runtimeOption( Processor::ERuntimeOption::eOrdered ) ;
       procSection.setParameter( "ProcessorCritical", criticalOpt.has_value() ? criticalOpt.value() : false ) ;
       procSection.setParameter( "ProcessorClone", cloneOpt.has_value() ? cloneOpt.value() : false ) ;
+      procSection.setParameter( "ProcessorOrdered", orderedOpt.has_value() ? orderedOpt.value() : false ) ;
       processor->getParameters( procSection ) ;
     }
     ConfigHelper::writeConfig( _parseResult._config.value(), config ) ;
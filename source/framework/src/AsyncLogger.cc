@@ -0,0 +1,347 @@
+#include <marlinmt/AsyncLogger.h>
+
+// -- marlinmt headers
+#include <marlinmt/Exceptions.h>
+
+// -- std headers
+#include <algorithm>
+
+namespace marlinmt {
+
+  namespace detail {
+
+    /// Round up to the next power of 2
+    static std::size_t nextPowerOf2( std::size_t value ) {
+      std::size_t result {1} ;
+      while( result < value ) {
+        result <<= 1 ;
+      }
+      return result ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    AsyncLogRing::AsyncLogRing( std::size_t size ) :
+      _records( nextPowerOf2( std::max<std::size_t>( size, 2 ) ) ),
+      _mask( _records.size() - 1 ) {
+      /* nop */
+    }
+
+    //--------------------------------------------------------------------------
+
+    AsyncLogRecord *AsyncLogRing::acquire( const std::atomic<bool> &stopped ) {
+      const auto head = _head.load( std::memory_order_relaxed ) ;
+      if( head - _cachedTail >= _records.size() ) {
+        _cachedTail = _tail.load( std::memory_order_acquire ) ;
+        if( head - _cachedTail >= _records.size() ) {
+          _fullWaits.fetch_add( 1, std::memory_order_relaxed ) ;
+          while( head - _cachedTail >= _records.size() ) {
+            if( stopped.load( std::memory_order_acquire ) ) {
+              return nullptr ;
+            }
+            std::this_thread::yield() ;
+            _cachedTail = _tail.load( std::memory_order_acquire ) ;
+          }
+        }
+      }
+      return &_records[ head & _mask ] ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void AsyncLogRing::drain( std::vector<AsyncLogRecord*> &records ) {
+      const auto tail = _tail.load( std::memory_order_relaxed ) ;
+      _drained = _head.load( std::memory_order_acquire ) ;
+      for( auto index = tail ; index < _drained ; ++index ) {
+        records.push_back( &_records[ index & _mask ] ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void AsyncLogRing::release() {
+      _tail.store( _drained, std::memory_order_release ) ;
+    }
+
+  } // end namespace detail
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  /// A ring of the calling thread and the logger it belongs to
+  struct ThreadRing {
+    std::size_t              _logger {0} ;
+    AsyncLogger::Ring       *_ring {nullptr} ;
+  };
+
+  static thread_local std::vector<ThreadRing> threadRings {} ;
+  static thread_local std::size_t threadCurrentEvent {0} ;
+  static std::atomic<std::size_t> loggerCounter {0} ;
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::Channel::Channel( AsyncLogger *logger, const std::string *name, const std::string &level ) :
+    _logger(logger),
+    _name(name) {
+    setLevel( level ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void AsyncLogger::Channel::setLevel( const std::string &level ) {
+    _threshold = AsyncLogger::levelRank( level.c_str() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::AsyncLogger( std::ostream &out, FlushMode mode, std::size_t ringSize, unsigned int drainPeriod ) :
+    _id( ++loggerCounter ),
+    _out( out ),
+    _flushMode( mode ),
+    _ringSize( ringSize ),
+    _drainPeriod( drainPeriod ) {
+    start() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::AsyncLogger( const std::string &filename, FlushMode mode, std::size_t ringSize, unsigned int drainPeriod ) :
+    _id( ++loggerCounter ),
+    _file( std::make_unique<std::ofstream>( filename ) ),
+    _out( *_file ),
+    _flushMode( mode ),
+    _ringSize( ringSize ),
+    _drainPeriod( drainPeriod ) {
+    if( not _file->is_open() ) {
+      throw Exception( "AsyncLogger::AsyncLogger: couldn't open log file '" + filename + "'" ) ;
+    }
+    start() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::~AsyncLogger() {
+    stop() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::Channel AsyncLogger::channel( const std::string &name, const std::string &level ) {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    auto iter = std::find( _channelNames.begin(), _channelNames.end(), name ) ;
+    if( _channelNames.end() == iter ) {
+      iter = _channelNames.insert( _channelNames.end(), name ) ;
+    }
+    return Channel( this, &(*iter), level ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void AsyncLogger::setCurrentEvent( std::size_t id ) {
+    threadCurrentEvent = id ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t AsyncLogger::currentEvent() {
+    return threadCurrentEvent ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void AsyncLogger::flushEvent( std::size_t id ) {
+    if( FlushMode::Event != _flushMode or 0 == id ) {
+      return ;
+    }
+    const auto previous = currentEvent() ;
+    setCurrentEvent( id ) ;
+    push( Record::Kind::EventEnd, nullptr, nullptr ) ;
+    setCurrentEvent( previous ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void AsyncLogger::stop() {
+    {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      if( _stopped.load() ) {
+        return ;
+      }
+      _stopped.store( true, std::memory_order_release ) ;
+    }
+    _drainCondition.notify_all() ;
+    if( _drainer.joinable() ) {
+      _drainer.join() ;
+    }
+    // the second drain writes the event ends collected by the first one
+    drain() ;
+    drain() ;
+    // events never flushed
+    for( auto &lines : _eventLines ) {
+      _out << lines.second ;
+    }
+    _eventLines.clear() ;
+    _out.flush() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::FlushMode AsyncLogger::flushMode() const {
+    return _flushMode ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t AsyncLogger::nLines() const {
+    return _nLines.load() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t AsyncLogger::fullWaits() const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    std::size_t waits {0} ;
+    for( auto &ring : _rings ) {
+      waits += ring->fullWaits() ;
+    }
+    return waits ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  unsigned int AsyncLogger::levelRank( const char *level ) {
+    if( nullptr == level ) {
+      return 0 ;
+    }
+    unsigned int base {1} ;
+    switch( level[0] ) {
+      case 'D': base = 0 ; break ;
+      case 'M': base = 1 ; break ;
+      case 'W': base = 2 ; break ;
+      case 'E': base = 3 ; break ;
+      case 'S': base = 4 ; break ;
+      default: break ;
+    }
+    // optional trailing digit, e.g DEBUG5
+    unsigned int digit {0} ;
+    for( const char *c = level ; '\0' != *c ; ++c ) {
+      if( *c >= '0' and *c <= '9' ) {
+        digit = static_cast<unsigned int>( *c - '0' ) ;
+        break ;
+      }
+    }
+    return base * 10 + digit ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::FlushMode AsyncLogger::flushModeFromString( const std::string &mode ) {
+    if( "line" == mode ) {
+      return FlushMode::Line ;
+    }
+    if( "event" == mode ) {
+      return FlushMode::Event ;
+    }
+    throw Exception( "AsyncLogger::flushModeFromString: unknown flush mode '" + mode + "' (line or event)" ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  AsyncLogger::Ring &AsyncLogger::threadRing() {
+    // usually a single logger per thread: look at the last used one first
+    auto &cache = threadRings ;
+    if( not cache.empty() and _id == cache.back()._logger ) {
+      return *cache.back()._ring ;
+    }
+    auto iter = std::find_if( cache.begin(), cache.end(), [this]( const ThreadRing &ring ){
+      return _id == ring._logger ;
+    }) ;
+    if( cache.end() == iter ) {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      _rings.push_back( std::make_unique<Ring>( _ringSize ) ) ;
+      cache.push_back( ThreadRing { _id, _rings.back().get() } ) ;
+      return *_rings.back() ;
+    }
+    std::iter_swap( iter, cache.end() - 1 ) ;
+    return *cache.back()._ring ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void AsyncLogger::start() {
+    _drainer = std::thread( [this](){
+      std::unique_lock<std::mutex> lock( _mutex ) ;
+      while( not _stopped.load( std::memory_order_acquire ) ) {
+        _drainCondition.wait_for( lock, _drainPeriod ) ;
+        lock.unlock() ;
+        drain() ;
+        lock.lock() ;
+      }
+    }) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void AsyncLogger::drain() {
+    // collect the published records of all the rings
+    std::vector<Ring*> rings ;
+    {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      rings.reserve( _rings.size() ) ;
+      for( auto &ring : _rings ) {
+        rings.push_back( ring.get() ) ;
+      }
+    }
+    _batch.clear() ;
+    for( auto ring : rings ) {
+      ring->drain( _batch ) ;
+    }
+    std::stable_sort( _batch.begin(), _batch.end(), []( const Record *lhs, const Record *rhs ){
+      return lhs->_time < rhs->_time ;
+    }) ;
+    // format the lines
+    std::vector<std::size_t> eventEnds ;
+    std::ostringstream line ;
+    std::size_t nlines {0} ;
+    for( auto record : _batch ) {
+      if( Record::Kind::EventEnd == record->_kind ) {
+        eventEnds.push_back( record->_event ) ;
+        record->_format( record->_storage, nullptr ) ;
+        continue ;
+      }
+      line.str( "" ) ;
+      line << "[ " << record->_level << " \"" << *record->_channel << "\"] " ;
+      record->_format( record->_storage, &line ) ;
+      line << '\n' ;
+      if( 0 == record->_event ) {
+        _out << line.str() ;
+      }
+      else {
+        _eventLines[ record->_event ] += line.str() ;
+      }
+      ++ nlines ;
+    }
+    for( auto ring : rings ) {
+      ring->release() ;
+    }
+    // the lines written before the event ends collected by the
+    // previous drain are now all collected: write these events
+    bool eventWritten {false} ;
+    for( auto event : _eventEnds ) {
+      auto iter = _eventLines.find( event ) ;
+      if( _eventLines.end() != iter ) {
+        _out << iter->second ;
+        _eventLines.erase( iter ) ;
+        eventWritten = true ;
+      }
+    }
+    _eventEnds = std::move( eventEnds ) ;
+    if( nlines > 0 or eventWritten ) {
+      _out.flush() ;
+    }
+    _nLines.fetch_add( nlines, std::memory_order_relaxed ) ;
+  }
+
+} // end namespace marlinmt
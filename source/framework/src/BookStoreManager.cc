@@ -66,6 +66,7 @@ namespace marlinmt {
     static const std::map<std::string, BookFlag_t> flags {
       {"share", BookFlags::MultiShared},
       {"copy", BookFlags::MultiCopy},
+      {"atomic", BookFlags::MultiAtomic},
       {"default", BookFlags::MultiShared},
     } ;
     BookFlag_t memoryLayout( 0 ) ;
@@ -83,6 +84,20 @@ namespace marlinmt {
       memoryLayout = iter->second ;
     }
     _defaultFlag = BookFlags::Store | memoryLayout ;
+    // the worker threads and the main thread (processor init, run headers, end)
+    _nThreads = application().cmdLineParseResult()._nthreads + 1 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void BookStoreManager::setNumberOfThreads( std::size_t nthreads ) {
+    _nThreads = nthreads ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t BookStoreManager::numberOfThreads() const {
+    return _nThreads ;
   }
 
   //--------------------------------------------------------------------------
@@ -126,11 +141,20 @@ namespace marlinmt {
     book::Handle<book::Entry<HistT>> entry;
     
     if( flagsToPass.contains(book::Flags::Book::MultiCopy)) {
-      entry =  _bookStore.book( path, name, data.multiCopy(nthreads) ) ;
+      entry =  _bookStore.book( path, name, data.multiCopy(_nThreads) ) ;
     } 
     else if ( flagsToPass.contains(book::Flags::Book::MultiShared)) {
-      entry =  _bookStore.book( path, name, data.multiShared(nthreads) ) ;
+      entry =  _bookStore.book( path, name, data.multiShared(_nThreads) ) ;
     } 
+    else if ( flagsToPass.contains(book::Flags::Book::MultiAtomic)) {
+      if constexpr ( not book::types::AtomicBins ) {
+        _logger->log<WARNING>() << "Histogram '" << name << "' booked with the "
+          "atomic memory layout, but this histogram implementation has no atomic "
+          "bins: the fills fall back to a lock shared by all threads. "
+          "Use the copy or share memory layout instead" << std::endl ;
+      }
+      entry =  _bookStore.book( path, name, data.multiAtomic() ) ;
+    }
     else if ( flagsToPass.contains(book::Flags::Book::Single)) {
       if ( nthreads != 1) {
         _logger->log<ERROR>() << "Single Memory layout can't be used"
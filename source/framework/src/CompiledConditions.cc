@@ -0,0 +1,275 @@
+#include <marlinmt/CompiledConditions.h>
+
+// -- marlinmt headers
+#include <marlinmt/LogicalExpressions.h>
+#include <marlinmt/Exceptions.h>
+
+// -- std headers
+#include <algorithm>
+
+namespace marlinmt {
+
+  CompiledConditions::Values::Values( std::size_t nvalues ) :
+    _size(nvalues),
+    _values( (nvalues + 63) / 64 ),
+    _isSet( (nvalues + 63) / 64 ) {
+    clear() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompiledConditions::Values::set( Index index, bool value ) {
+    const std::uint64_t bit = std::uint64_t(1) << (index % 64) ;
+    if( value ) {
+      _values[ index / 64 ].fetch_or( bit ) ;
+    }
+    else {
+      _values[ index / 64 ].fetch_and( ~bit ) ;
+    }
+    _isSet[ index / 64 ].fetch_or( bit ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompiledConditions::Values::isSet( Index index ) const {
+    return ( _isSet[ index / 64 ].load() >> (index % 64) ) & 1 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompiledConditions::Values::get( Index index ) const {
+    return ( _values[ index / 64 ].load() >> (index % 64) ) & 1 ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompiledConditions::Values::clear() {
+    for( auto &word : _values ) {
+      word.store( 0 ) ;
+    }
+    for( auto &word : _isSet ) {
+      word.store( 0 ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CompiledConditions::Values::size() const {
+    return _size ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  void CompiledConditions::ValueSlots::resolve( const CompiledConditions &conds, const std::string &processorName ) {
+    if( &conds == _resolved.load( std::memory_order_acquire ) ) {
+      return ;
+    }
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    if( &conds == _resolved.load( std::memory_order_relaxed ) ) {
+      return ;
+    }
+    _index = conds.valueIndex( processorName ) ;
+    // the named values are the ones used in the conditions only, the others are not stored
+    _namedIndices.clear() ;
+    for( Index index=0 ; index<conds._valueNames.size() ; ++index ) {
+      const auto &valueName = conds._valueNames[ index ] ;
+      if( ( valueName.size() > processorName.size() + 1 )
+        and ( 0 == valueName.compare( 0, processorName.size(), processorName ) )
+        and ( '.' == valueName[ processorName.size() ] ) ) {
+        _namedIndices.emplace_back( valueName.substr( processorName.size() + 1 ), index ) ;
+      }
+    }
+    _resolved.store( &conds, std::memory_order_release ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  CompiledConditions::Index CompiledConditions::ValueSlots::index() const {
+    return _index ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  CompiledConditions::Index CompiledConditions::ValueSlots::index( const std::string &name ) const {
+    // a processor uses a few named values only
+    for( auto &namedIndex : _namedIndices ) {
+      if( namedIndex.first == name ) {
+        return namedIndex.second ;
+      }
+    }
+    return npos ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  CompiledConditions::CompiledConditions( const ConditionsMap &conds ) {
+    _programs.reserve( conds.size() ) ;
+    for( auto &cond : conds ) {
+      Program program {} ;
+      compile( cond.second, program, 0 ) ;
+      // check the stack depth once here, evaluate() doesn't
+      std::size_t depth {0}, maxDepth {0} ;
+      for( auto &inst : program ) {
+        if( inst._opcode == OpCode::And or inst._opcode == OpCode::Or ) {
+          -- depth ;
+        }
+        else if( inst._opcode != OpCode::Not ) {
+          maxDepth = std::max( maxDepth, ++ depth ) ;
+        }
+      }
+      if( maxDepth > MaxStackDepth ) {
+        MARLINMT_THROW_T( ParseException, "Condition '" + cond.first + "' is too complex: " + cond.second ) ;
+      }
+      _conditionIndices[ cond.first ] = _programs.size() ;
+      _programs.push_back( std::move( program ) ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  CompiledConditions::Index CompiledConditions::conditionIndex( const std::string &name ) const {
+    auto iter = _conditionIndices.find( name ) ;
+    return ( _conditionIndices.end() == iter ) ? npos : iter->second ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  CompiledConditions::Index CompiledConditions::valueIndex( const std::string &name ) const {
+    auto iter = _valueIndices.find( name ) ;
+    return ( _valueIndices.end() == iter ) ? npos : iter->second ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CompiledConditions::nValues() const {
+    return _valueNames.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t CompiledConditions::nConditions() const {
+    return _programs.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompiledConditions::evaluate( Index index, const Values &values ) const {
+    // conditions not in the map are true. See LogicalExpressions::conditionIsTrue()
+    if( npos == index ) {
+      return true ;
+    }
+    Index unset {npos} ;
+    const bool result = run( index, values, unset ) ;
+    if( npos != unset ) {
+      MARLINMT_THROW_T( ParseException, "key \"" + _valueNames[ unset ] + "\" not found. Bad processor condition?" ) ;
+    }
+    return result ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompiledConditions::isFalse( Index index, const Values &values ) const {
+    if( npos == index ) {
+      return false ;
+    }
+    Index unset {npos} ;
+    const bool result = run( index, values, unset ) ;
+    return ( npos == unset ) and ( not result ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool CompiledConditions::run( Index index, const Values &values, Index &unset ) const {
+    bool stack[ MaxStackDepth ] ;
+    std::size_t top {0} ;
+    for( auto &inst : _programs[ index ] ) {
+      switch( inst._opcode ) {
+        case OpCode::PushTrue:
+          stack[ top++ ] = true ;
+          break ;
+        case OpCode::PushFalse:
+          stack[ top++ ] = false ;
+          break ;
+        case OpCode::PushValue:
+          if( not values.isSet( inst._index ) ) {
+            unset = inst._index ;
+            return false ;
+          }
+          stack[ top++ ] = values.get( inst._index ) ;
+          break ;
+        case OpCode::Not:
+          stack[ top-1 ] = not stack[ top-1 ] ;
+          break ;
+        case OpCode::And:
+          -- top ;
+          stack[ top-1 ] = stack[ top-1 ] and stack[ top ] ;
+          break ;
+        case OpCode::Or:
+          -- top ;
+          stack[ top-1 ] = stack[ top-1 ] or stack[ top ] ;
+          break ;
+      }
+    }
+    return stack[ 0 ] ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompiledConditions::compile( const std::string &expression, Program &program, std::size_t depth ) {
+    if( depth > MaxStackDepth ) {
+      MARLINMT_THROW_T( ParseException, "Condition nested too deeply: " + expression ) ;
+    }
+    // Same parsing as LogicalExpressions::expressionIsTrue()
+    std::vector<Expression> tokens ;
+    Tokenizer t( tokens ) ;
+    std::for_each( expression.begin(), expression.end(), t ) ;
+    // atomic expression
+    if( tokens.size() == 1
+      && tokens[0].Value.find('&') == std::string::npos
+      && tokens[0].Value.find('|') == std::string::npos ) {
+      compileValue( tokens[0].Value, tokens[0].isNot, program ) ;
+      return ;
+    }
+    // empty expression
+    if( tokens.empty() ) {
+      program.push_back( { OpCode::PushTrue, 0 } ) ;
+      return ;
+    }
+    // evaluated from left to right. The first token is always
+    // combined with 'true' using AND, so it is pushed as is
+    for( std::size_t i=0 ; i<tokens.size() ; ++i ) {
+      compile( tokens[i].Value, program, depth+1 ) ;
+      if( tokens[i].isNot ) {
+        program.push_back( { OpCode::Not, 0 } ) ;
+      }
+      if( i > 0 ) {
+        program.push_back( { tokens[i].Operation == Expression::AND ? OpCode::And : OpCode::Or, 0 } ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void CompiledConditions::compileValue( const std::string &name, bool isNot, Program &program ) {
+    if( name == "true" or name == "True" ) {
+      program.push_back( { OpCode::PushTrue, 0 } ) ;
+    }
+    else if( name == "false" or name == "False" ) {
+      program.push_back( { OpCode::PushFalse, 0 } ) ;
+    }
+    else {
+      auto iter = _valueIndices.find( name ) ;
+      if( _valueIndices.end() == iter ) {
+        iter = _valueIndices.insert( { name, _valueNames.size() } ).first ;
+        _valueNames.push_back( name ) ;
+      }
+      program.push_back( { OpCode::PushValue, iter->second } ) ;
+    }
+    if( isNot ) {
+      program.push_back( { OpCode::Not, 0 } ) ;
+    }
+  }
+
+}
@@ -10,6 +10,7 @@ namespace marlinmt {
     _name(details::convert<void*>::to_string(this)) {
     _logger = Logging::createLogger( this->type() + "_" + this->name() ) ;
     _logger->setLevel( "MESSAGE" ) ;
+    _logRank = Logging::levelRank( _logger->levelName() ) ;
   }
   
   //--------------------------------------------------------------------------
@@ -70,6 +71,10 @@ namespace marlinmt {
   
   void Component::setVerbosity( const std::string &level ) {
     _logger->setLevel( level ) ;
+    _logRank = Logging::levelRank( _logger->levelName() ) ;
+    if( _asyncChannel.valid() ) {
+      _asyncChannel.setLevel( _logger->levelName() ) ;
+    }
   }
   
   //--------------------------------------------------------------------------
@@ -104,6 +109,11 @@ namespace marlinmt {
     if( _verbosity.isSet() ) {
       _logger->setLevel( _verbosity.get() ) ;
     }
+    _logRank = Logging::levelRank( _logger->levelName() ) ;
+    auto asyncLogger = application().asyncLogger() ;
+    if( nullptr != asyncLogger ) {
+      _asyncChannel = asyncLogger->channel( _name, _logger->levelName() ) ;
+    }
     initialize() ;
   }
   
@@ -3,6 +3,7 @@
 // -- marlinmt headers
 #include <marlinmt/Application.h>
 #include <marlinmt/EventStore.h>
+#include <marlinmt/EventStorePool.h>
 #include <marlinmt/RunHeader.h>
 
 namespace marlinmt {
@@ -32,6 +33,27 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  unsigned int DataSourcePlugin::readAheadSize() const {
+    return _readAheadSize.get() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void DataSourcePlugin::setEventStorePool( EventStorePool *pool ) {
+    _eventStorePool = pool ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::shared_ptr<EventStore> DataSourcePlugin::createEventStore() {
+    if( nullptr != _eventStorePool ) {
+      return _eventStorePool->acquire() ;
+    }
+    return std::make_shared<EventStore>() ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void DataSourcePlugin::processRunHeader( std::shared_ptr<RunHeader> rhdr ) {
     if( nullptr == _onRunHeaderRead ) {
       throw Exception( "DataSourcePlugin::processRunHeader: no callback function available" ) ;
@@ -5,50 +5,115 @@
 
 namespace marlinmt {
 
-  RandomSeedExtension::RandomSeedExtension( RandomSeedMap seeds ) :
-    _randomSeeds(std::move(seeds)) {
+  RandomSeedExtension::RandomSeedExtension( EventSeed evtSeed ) :
+    _eventSeed(evtSeed) {
     /* nop */
   }
 
   //--------------------------------------------------------------------------
 
-  RandomSeedExtension::RandomSeedType RandomSeedExtension::randomSeed( const Processor *const processor ) const {
-    RandomSeedManager::HashFunction hashf ;
-    RandomSeedManager::HashResult hashval = hashf( processor ) ;
-    auto iter = _randomSeeds->find( hashval ) ;
-    if( _randomSeeds->end() == iter ) {
-      throw Exception( "RandomSeedExtension::randomSeed: processor '" +
-        processor->name() +
-        "' not registered in random seed manager" ) ;
-    }
-    return iter->second ;
+  void RandomSeedExtension::reset( EventSeed evtSeed ) {
+    _eventSeed = evtSeed ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  RandomSeedExtension::RandomSeedType RandomSeedExtension::randomSeed( EntryKey key ) const {
+    return RandomSeedManager::randomSeed( _eventSeed, key ) ;
   }
 
   //--------------------------------------------------------------------------
   //--------------------------------------------------------------------------
 
-  ProcessorConditionsExtension::ProcessorConditionsExtension( const ConditionsMap &conds ) {
-    for( auto cond : conds ) {
-      _runtimeConditions->addCondition( cond.first, cond.second ) ;
+  ProcessorConditionsExtension::ProcessorConditionsExtension( Conditions conds ) :
+    _conditions(std::move(conds)),
+    _values(_conditions->nValues()) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ProcessorConditionsExtension::reset( Conditions conds ) {
+    if( conds != _conditions ) {
+      _conditions = std::move(conds) ;
+      _values = CompiledConditions::Values( _conditions->nValues() ) ;
+    }
+    else {
+      _values.clear() ;
     }
   }
 
   //--------------------------------------------------------------------------
 
   void ProcessorConditionsExtension::set( const Processor *const processor, bool value ) {
-    _runtimeConditions->setValue( processor->name(), value ) ;
+    // values not used in any condition are not stored
+    processor->_valueSlots.resolve( *_conditions, processor->name() ) ;
+    auto index = processor->_valueSlots.index() ;
+    if( CompiledConditions::npos != index ) {
+      _values.set( index, value ) ;
+    }
   }
 
   //--------------------------------------------------------------------------
 
   void ProcessorConditionsExtension::set( const Processor *const processor, const std::string &name, bool value ) {
-    _runtimeConditions->setValue( processor->name() + "." + name, value ) ;
+    processor->_valueSlots.resolve( *_conditions, processor->name() ) ;
+    auto index = processor->_valueSlots.index( name ) ;
+    if( CompiledConditions::npos != index ) {
+      _values.set( index, value ) ;
+    }
   }
 
   //--------------------------------------------------------------------------
 
   bool ProcessorConditionsExtension::check( const std::string &name ) const {
-    return _runtimeConditions->conditionIsTrue( name ) ;
+    return _conditions->evaluate( _conditions->conditionIndex( name ), _values ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool ProcessorConditionsExtension::check( Index index ) const {
+    return _conditions->evaluate( index, _values ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool ProcessorConditionsExtension::isFalse( Index index ) const {
+    return _conditions->isFalse( index, _values ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const ProcessorConditionsExtension::Conditions &ProcessorConditionsExtension::conditions() const {
+    return _conditions ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  RunContextExtension::RunContextExtension( Epoch epoch, std::shared_ptr<RunHeader> rhdr ) :
+    _epoch(epoch),
+    _runHeader(rhdr) {
+    /* nop */
+  }
+
+  //--------------------------------------------------------------------------
+
+  void RunContextExtension::reset( Epoch epoch, std::shared_ptr<RunHeader> rhdr ) {
+    _epoch = epoch ;
+    _runHeader = std::move(rhdr) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  RunContextExtension::Epoch RunContextExtension::epoch() const {
+    return _epoch ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::shared_ptr<RunHeader> RunContextExtension::runHeader() const {
+    return _runHeader ;
   }
 
 }
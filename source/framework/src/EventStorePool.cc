@@ -0,0 +1,68 @@
+#include <marlinmt/EventStorePool.h>
+
+// -- marlinmt headers
+#include <marlinmt/EventStore.h>
+
+namespace marlinmt {
+
+  EventStorePool::EventStorePool( std::size_t maxSize ) :
+    _maxSize(maxSize) {
+    _stores.reserve( _maxSize ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  EventStorePool::StorePtr EventStorePool::acquire() {
+    {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      if( not _stores.empty() ) {
+        auto store = std::move( _stores.back() ) ;
+        _stores.pop_back() ;
+        ++ _nRecycled ;
+        return store ;
+      }
+      ++ _nAllocated ;
+    }
+    return std::make_shared<EventStore>() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void EventStorePool::release( StorePtr &&store ) {
+    if( ( nullptr == store ) or ( 1 != store.use_count() ) ) {
+      store.reset() ;
+      return ;
+    }
+    // reset outside of the lock. Might delete the underlying event
+    store->recycle() ;
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    if( _stores.size() < _maxSize ) {
+      _stores.push_back( std::move( store ) ) ;
+    }
+    else {
+      store.reset() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t EventStorePool::nAllocated() const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    return _nAllocated ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t EventStorePool::nRecycled() const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    return _nRecycled ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::size_t EventStorePool::size() const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    return _stores.size() ;
+  }
+
+}
@@ -0,0 +1,17 @@
+#include <marlinmt/Extensions.h>
+
+// -- std headers
+#include <atomic>
+
+namespace marlinmt {
+
+  std::size_t Extensions::nextSlotIndex( const char *keyName ) {
+    static std::atomic<std::size_t> nextIndex {0} ;
+    const std::size_t index = nextIndex.fetch_add( 1 ) ;
+    if( index >= MaxSlots ) {
+      MARLINMT_THROW( "Too many extension key types (max " + std::to_string(MaxSlots) + "), can't register " + std::string(keyName) ) ;
+    }
+    return index ;
+  }
+
+}
@@ -3,6 +3,9 @@
 // -- marlinmt headers
 #include <marlinmt/Application.h>
 
+// -- std headers
+#include <iostream>
+
 namespace marlinmt {
 
   LoggerManager::LoggerManager() : 
@@ -34,6 +37,15 @@ namespace marlinmt {
     mainLogger()->setSinks( sinks ) ;
     streamlog::logstream::global().setName( application().programName() ) ;
     streamlog::logstream::global().setSinks( sinks ) ;
+    if( _asyncLogging.get() ) {
+      const auto flushMode = AsyncLogger::flushModeFromString( _asyncFlushMode.get() ) ;
+      if ( not _logfile.get().empty() ) {
+        _asyncLogger = std::make_shared<AsyncLogger>( _logfile.get() + ".async", flushMode ) ;
+      }
+      else {
+        _asyncLogger = std::make_shared<AsyncLogger>( std::cout, flushMode ) ;
+      }
+    }
   }
 
   //--------------------------------------------------------------------------
@@ -51,4 +63,10 @@ namespace marlinmt {
     return logger ;
   }
 
+  //--------------------------------------------------------------------------
+
+  std::shared_ptr<AsyncLogger> LoggerManager::asyncLogger() const {
+    return _asyncLogger ;
+  }
+
 } // namespace marlinmt
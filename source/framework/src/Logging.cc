@@ -1,4 +1,5 @@
 #include "marlinmt/Logging.h"
+#include "marlinmt/AsyncLogger.h"
 
 namespace marlinmt {
 
@@ -12,4 +13,11 @@ namespace marlinmt {
     return streamlog::logstream::global() ;
   }
 
+  //--------------------------------------------------------------------------
+
+  unsigned int Logging::levelRank( const std::string &level ) {
+    // same ranking as the asynchronous logger channels
+    return AsyncLogger::levelRank( level.c_str() ) ;
+  }
+
 }
@@ -38,4 +38,22 @@ namespace marlinmt {
     _forcedRuntimeOptions[option] = value ;
   }
 
+  //--------------------------------------------------------------------------
+
+  const Processor::CollectionNames &Processor::inputCollections() const {
+    return _inputCollections ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const Processor::CollectionNames &Processor::outputCollections() const {
+    return _outputCollections ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Processor::canSkipEvents() const {
+    return _canSkipEvents ;
+  }
+
 } // namespace marlinmt
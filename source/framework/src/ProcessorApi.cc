@@ -315,7 +315,25 @@ namespace marlinmt {
   //--------------------------------------------------------------------------
   
   void ProcessorApi::registerForRandomSeeds( Processor *const proc ) {
-    proc->application().randomSeedManager().addEntry( proc ) ;
+    proc->_randomSeedKey = proc->application().randomSeedManager().addEntry( proc, proc->name() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ProcessorApi::declareInputCollection( Processor *const proc, const std::string &name ) {
+    proc->_inputCollections.insert( name ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ProcessorApi::declareOutputCollection( Processor *const proc, const std::string &name ) {
+    proc->_outputCollections.insert( name ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void ProcessorApi::declareNoEventSkip( Processor *const proc ) {
+    proc->_canSkipEvents = false ;
   }
 
   //--------------------------------------------------------------------------
@@ -325,7 +343,10 @@ namespace marlinmt {
     if( nullptr == randomSeeds ) {
       MARLINMT_THROW( "No random seed extension in event" ) ;
     }
-    return randomSeeds->randomSeed( proc ) ;
+    if( not proc->_randomSeedKey.has_value() ) {
+      MARLINMT_THROW( "Processor '" + proc->name() + "' not registered for random seeds" ) ;
+    }
+    return randomSeeds->randomSeed( proc->_randomSeedKey.value() ) ;
   }
 
   //--------------------------------------------------------------------------
@@ -363,6 +384,13 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  void ProcessorApi::skipCurrentEvent( const Processor *const proc, EventStore *event ) {
+    MARLINMT_LOG_LINE( *proc, DEBUG, "Skipping current event !" ) ;
+    event->skip( proc ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void ProcessorApi::abort( const Processor *const proc, const std::string &reason ) {
     proc->log<WARNING>() << "Stopping application: " << reason << std::endl ;
     MARLINMT_STOP_PROCESSING( proc ) ;
@@ -0,0 +1,54 @@
+#include <marlinmt/ProcessorTiming.h>
+
+// -- marlinmt headers
+#include <marlinmt/Exceptions.h>
+
+namespace marlinmt {
+
+  TimingMode timingModeFromString( const std::string &mode ) {
+    if( "full" == mode ) {
+      return TimingMode::Full ;
+    }
+    if( "sampled" == mode ) {
+      return TimingMode::Sampled ;
+    }
+    if( "fast" == mode ) {
+      return TimingMode::Fast ;
+    }
+    throw Exception( "timingModeFromString: unknown timing mode '" + mode + "' (full, sampled or fast)" ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::string timingModeToString( TimingMode mode ) {
+    switch( mode ) {
+      case TimingMode::Full: return "full" ;
+      case TimingMode::Sampled: return "sampled" ;
+      case TimingMode::Fast: return "fast" ;
+    }
+    return "unknown" ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  double fastclock::secondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    // count the ticks during a short steady clock interval
+    static const double spt = [](){
+      const auto start = clock::now() ;
+      const auto startTicks = fastclock::now() ;
+      clock::duration_rep elapsed {0} ;
+      while( elapsed < 0.02f ) {
+        elapsed = clock::elapsed_since<clock::seconds>( start ) ;
+      }
+      const auto ticks = fastclock::now() - startTicks ;
+      return ( 0 == ticks ) ? 0. : static_cast<double>( elapsed ) / static_cast<double>( ticks ) ;
+    }() ;
+    return spt ;
+#else
+    return 1e-9 ;
+#endif
+  }
+
+}
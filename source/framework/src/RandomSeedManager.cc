@@ -3,62 +3,63 @@
 // -- marlinmt headers
 #include <jenkinsHash.h>
 #include <marlinmt/Exceptions.h>
-#include <marlinmt/EventStore.h>
 
 
 namespace marlinmt {
 
   RandomSeedManager::RandomSeedManager( SeedType globalSeed ) :
-    _globalSeed( globalSeed ),
-    _generator( _globalSeed ) {
+    _globalSeed( globalSeed ) {
     /* nop */
   }
 
   //--------------------------------------------------------------------------
 
-  void RandomSeedManager::addEntry( HashResult entry ) {
-    bool inserted = _entryList.insert( entry ).second ;
-    if ( not inserted ) {
-      throw Exception("RandomSeedManager: Entry '" + std::to_string(entry) + "' already registered !") ;
-    }
+  void RandomSeedManager::setGlobalSeed( SeedType globalSeed ) {
+    _globalSeed = globalSeed ;
   }
 
   //--------------------------------------------------------------------------
 
-  void RandomSeedManager::addEntry( HashArgument arg ) {
-    HashFunction hashf ;
-    addEntry( hashf(arg) ) ;
+  RandomSeedManager::SeedType RandomSeedManager::globalSeed() const {
+    return _globalSeed ;
   }
 
   //--------------------------------------------------------------------------
 
-  std::unique_ptr<RandomSeedManager::RandomSeedMap>
-  RandomSeedManager::generateRandomSeeds( const EventStore * const evt ) {
-    // get hashed seed using jenkins_hash
-    unsigned int seed = 0 ; // initial state
-    // unsigned int eventNumber = evt->getEventNumber() ;
-    // unsigned int runNumber = evt->getRunNumber() ;
-    auto uid = evt->uid() ;
-    unsigned char * c = (unsigned char *) &uid ;
-    // seed = jenkins_hash( c, sizeof eventNumber, seed) ;
-    // c = (unsigned char *) &runNumber ;
-    // seed = jenkins_hash( c, sizeof runNumber, seed) ;
-    // c = (unsigned char *) &uid ;
-    seed = jenkins_hash( c, sizeof _globalSeed, seed) ;
-    // refresh the seed
-    _generator.seed( seed ) ;
-    std::unique_ptr<RandomSeedMap> seedMap( new RandomSeedMap() ) ;
-    // fill map with seeds for each entry using random number generator
-    for (auto iter : _entryList ) {
-      (*seedMap)[iter] = getRandom() ;
+  RandomSeedManager::EntryKey RandomSeedManager::addEntry( HashArgument arg, const std::string &name ) {
+    HashFunction hashf ;
+    {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      bool inserted = _entryList.insert( hashf(arg) ).second ;
+      if ( not inserted ) {
+        throw Exception("RandomSeedManager: Entry '" + name + "' already registered !") ;
+      }
     }
-    return seedMap ;
+    // jenkins hash is stable across platforms, unlike std::hash
+    const auto *c = reinterpret_cast<const unsigned char*>( name.data() ) ;
+    return splitmix( jenkins_hash( c, static_cast<unsigned>( name.size() ), 0 ) ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  RandomSeedManager::EventSeed RandomSeedManager::eventSeed( std::size_t uid ) const {
+    return splitmix( splitmix( _globalSeed ) ^ static_cast<std::uint64_t>( uid ) ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  RandomSeedManager::SeedType RandomSeedManager::randomSeed( EventSeed evtSeed, EntryKey key ) {
+    // keep the high bits, the best mixed ones
+    return static_cast<SeedType>( splitmix( evtSeed ^ key ) >> 32 ) ;
   }
 
   //--------------------------------------------------------------------------
 
-  RandomSeedManager::SeedType RandomSeedManager::getRandom() {
-    return static_cast<SeedType>(_rdmDistribution(_generator)) ;
+  std::uint64_t RandomSeedManager::splitmix( std::uint64_t value ) {
+    value += 0x9e3779b97f4a7c15ULL ;
+    value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL ;
+    value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL ;
+    return value ^ ( value >> 31 ) ;
   }
 
 }
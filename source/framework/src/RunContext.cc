@@ -0,0 +1,78 @@
+#include <marlinmt/RunContext.h>
+
+// -- marlinmt headers
+#include <marlinmt/Exceptions.h>
+
+namespace marlinmt {
+
+  RunContext::Epoch RunContext::addRunHeader( std::shared_ptr<RunHeader> rhdr ) {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    _runHeaders.push_back( rhdr ) ;
+    return _runHeaders.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  RunContext::Epoch RunContext::currentEpoch() const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    return _runHeaders.size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::shared_ptr<RunHeader> RunContext::runHeader( Epoch epoch ) const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    if( 0 == epoch ) {
+      return nullptr ;
+    }
+    if( epoch > _runHeaders.size() ) {
+      throw Exception( "RunContext::runHeader: invalid epoch " + std::to_string( epoch ) ) ;
+    }
+    return _runHeaders[ epoch - 1 ] ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void RunContext::eventStarted( Epoch epoch ) {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    ++ _inFlightEvents[ epoch ] ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void RunContext::eventFinished( Epoch epoch ) {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    auto iter = _inFlightEvents.find( epoch ) ;
+    if( _inFlightEvents.end() == iter ) {
+      throw Exception( "RunContext::eventFinished: no event in flight for epoch " + std::to_string( epoch ) ) ;
+    }
+    if( 0 == -- iter->second ) {
+      _inFlightEvents.erase( iter ) ;
+      _conditionVariable.notify_all() ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void RunContext::waitPreviousEpochs( Epoch epoch ) {
+    std::unique_lock<std::mutex> lock( _mutex ) ;
+    // the map is ordered: check the oldest epoch in flight
+    auto previousDone = [this, epoch](){
+      return ( _inFlightEvents.empty() or _inFlightEvents.begin()->first >= epoch ) ;
+    } ;
+    if( previousDone() ) {
+      return ;
+    }
+    auto start = clock::now() ;
+    _conditionVariable.wait( lock, previousDone ) ;
+    _barrierTime += clock::elapsed_since<clock::seconds>( start ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  clock::duration_rep RunContext::barrierTime() const {
+    std::lock_guard<std::mutex> lock( _mutex ) ;
+    return _barrierTime ;
+  }
+
+}
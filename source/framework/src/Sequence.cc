@@ -10,6 +10,7 @@
 // -- std headers
 #include <algorithm>
 #include <iomanip>
+#include <numeric>
 
 namespace marlinmt {
 
@@ -23,9 +24,10 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
-  SequenceItem::SequenceItem( std::shared_ptr<Processor> proc, std::shared_ptr<std::mutex> lock ) :
+  SequenceItem::SequenceItem( std::shared_ptr<Processor> proc, std::shared_ptr<std::mutex> lock, bool shared ) :
     _processor(proc),
-    _mutex(lock) {
+    _mutex(lock),
+    _shared(shared) {
     if( nullptr == _processor ) {
       throw Exception( "SequenceItem: got a nullptr for processor" ) ;
     }
@@ -45,6 +47,32 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  void SequenceItem::updateRunEpoch( RunContext &context, RunContext::Epoch epoch ) {
+    if( _runEpoch.load() >= epoch ) {
+      return ;
+    }
+    std::unique_lock<std::mutex> lock( _runEpochMutex, std::defer_lock ) ;
+    if( _shared ) {
+      // the processor may still be processing events of the previous runs
+      context.waitPreviousEpochs( epoch ) ;
+      lock.lock() ;
+    }
+    auto start = clock::now() ;
+    while( _runEpoch.load() < epoch ) {
+      processRunHeader( context.runHeader( _runEpoch.load() + 1 ) ) ;
+      ++ _runEpoch ;
+    }
+    _runHeaderClock += clock::elapsed_since<clock::seconds>( start ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  clock::duration_rep SequenceItem::runHeaderClock() const {
+    return _runHeaderClock ;
+  }
+
+  //--------------------------------------------------------------------------
+
   clock::pair SequenceItem::processEvent( std::shared_ptr<EventStore> event ) {
     if( nullptr != _mutex ) {
       auto start = clock::now() ;
@@ -68,6 +96,40 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  clock::pair SequenceItem::processEventFast( std::shared_ptr<EventStore> event ) {
+    if( nullptr != _mutex ) {
+      auto start = fastclock::now() ;
+      std::lock_guard<std::mutex> lock( *_mutex ) ;
+      auto start2 = fastclock::now() ;
+      _processor->processEvent( event.get() ) ;
+      auto end = fastclock::now() ;
+      return clock::pair(
+        fastclock::time_difference(start, end),
+        fastclock::time_difference(start2, end)) ;
+    }
+    else {
+      auto start = fastclock::now() ;
+      _processor->processEvent( event.get() ) ;
+      auto end = fastclock::now() ;
+      const auto diff = fastclock::time_difference(start, end) ;
+      return clock::pair( diff, diff ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void SequenceItem::processEventUntimed( std::shared_ptr<EventStore> event ) {
+    if( nullptr != _mutex ) {
+      std::lock_guard<std::mutex> lock( *_mutex ) ;
+      _processor->processEvent( event.get() ) ;
+    }
+    else {
+      _processor->processEvent( event.get() ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
   std::shared_ptr<Processor> SequenceItem::processor() const {
     return _processor ;
   }
@@ -79,23 +141,46 @@ namespace marlinmt {
   }
 
   //--------------------------------------------------------------------------
+
+  bool SequenceItem::critical() const {
+    return ( nullptr != _mutex ) ;
+  }
+
   //--------------------------------------------------------------------------
 
-  std::shared_ptr<SequenceItem> Sequence::createItem( std::shared_ptr<Processor> processor, std::shared_ptr<std::mutex> lock ) const {
-    return std::make_shared<SequenceItem>( processor, lock ) ;
+  bool SequenceItem::shared() const {
+    return _shared ;
+  }
+
+  //--------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+
+  Sequence::Sequence( std::shared_ptr<RunContext> runContext ) :
+    _runContext(runContext) {
+    if( nullptr == _runContext ) {
+      throw Exception( "Sequence: got a nullptr for run context" ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::shared_ptr<SequenceItem> Sequence::createItem( std::shared_ptr<Processor> processor, std::shared_ptr<std::mutex> lock, bool shared ) const {
+    return std::make_shared<SequenceItem>( processor, lock, shared ) ;
   }
 
   //--------------------------------------------------------------------------
 
   void Sequence::addItem( std::shared_ptr<SequenceItem> item ) {
-    auto iter = std::find_if(_items.begin(), _items.end(), [&](std::shared_ptr<SequenceItem> i){
+    auto iter = std::find_if(_items.begin(), _items.end(), [&](const std::shared_ptr<SequenceItem> &i){
       return (i->name() == item->name()) ;
     });
     if( _items.end() != iter ) {
       throw Exception( "Sequence::addItem: processor '" + item->name() + "' already in sequence" ) ;
     }
     _items.push_back( item ) ;
-    _clockMeasures[item->name()] = ClockMeasure() ;
+    _statistics.emplace_back() ;
+    // the condition indices are resolved again for the new item list
+    _resolvedConditions.store( nullptr ) ;
   }
 
   //--------------------------------------------------------------------------
@@ -113,35 +198,157 @@ namespace marlinmt {
   //--------------------------------------------------------------------------
 
   void Sequence::processRunHeader( std::shared_ptr<RunHeader> rhdr ) {
-    for ( auto item : _items ) {
+    for ( auto &item : _items ) {
       item->processRunHeader( rhdr ) ;
     }
   }
 
   //--------------------------------------------------------------------------
 
-  void Sequence::processEvent( std::shared_ptr<EventStore> event ) {
+  bool Sequence::processEvent( std::shared_ptr<EventStore> event ) {
+    return processEvent( event, 0, _items.size() ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Sequence::processEvent( std::shared_ptr<EventStore> event, Index begin, Index end ) {
+    return processItems( event, begin, end, true ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Sequence::processEvent( std::shared_ptr<EventStore> event, Index index ) {
+    return processItems( event, index, index+1, false ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  bool Sequence::processItems( const std::shared_ptr<EventStore> &event, Index begin, Index end, bool earlyRelease ) {
+    const Index limit = earlyRelease ? _items.size() : end ;
+    Index index = begin ;
     try {
       auto extension = event->extensions().get<extensions::ProcessorConditions, ProcessorConditionsExtension>() ;
-      for ( auto item : _items ) {
-        if ( not extension->check( item->name() ) ) {
+      if( extension->conditions().get() != _resolvedConditions.load( std::memory_order_acquire ) ) {
+        resolveConditions( extension->conditions() ) ;
+      }
+      const bool hasRunEpoch = event->extensions().exits<extensions::RunEpoch>() ;
+      const RunContext::Epoch epoch = hasRunEpoch ?
+        event->extensions().get<extensions::RunEpoch, RunContextExtension>()->epoch() : 0 ;
+      // jump over the items that can't run. Their conditions don't change
+      // as long as no other processor runs
+      for ( index = nextItem( *extension, begin, limit ) ; index<end ; index = nextItem( *extension, index+1, limit ) ) {
+        auto &item = _items[ index ] ;
+        if ( not extension->check( _conditionIndices[ index ] ) ) {
           continue ;
         }
-        auto clockMeas = item->processEvent( event ) ;
-        auto iter = _clockMeasures.find( item->name() ) ;
-        iter->second._appClock += clockMeas.first ;
-        iter->second._procClock += clockMeas.second ;
-        iter->second._counter ++ ;
+        // skipped meanwhile by a processor running concurrently (see DAGScheduler)
+        if( event->skipped() ) {
+          return false ;
+        }
+        if( hasRunEpoch ) {
+          item->updateRunEpoch( *_runContext, epoch ) ;
+        }
+        auto &clockMeasure = _statistics[ index ]._clock ;
+        clock::pair clockMeas {} ;
+        double weight {1.} ;
+        bool timed {true} ;
+        switch( _timingMode ) {
+          case TimingMode::Full:
+            clockMeas = item->processEvent( event ) ;
+            break ;
+          case TimingMode::Fast:
+            clockMeas = item->processEventFast( event ) ;
+            break ;
+          case TimingMode::Sampled:
+            // time the first call and then one call in N of each item
+            timed = ( 0 == static_cast<unsigned int>( clockMeasure._counter ) % _timingSampling ) ;
+            if( timed ) {
+              clockMeas = item->processEvent( event ) ;
+              weight = _timingSampling ;
+            }
+            else {
+              item->processEventUntimed( event ) ;
+            }
+            break ;
+        }
+        clockMeasure._counter ++ ;
+        if( timed ) {
+          clockMeasure._appClock += clockMeas.first ;
+          clockMeasure._procClock += clockMeas.second ;
+          clockMeasure._timed ++ ;
+          // the critical stage threads run items of the same sequence concurrently
+          // (see PEPScheduler). The totals are estimates of all calls in sampled mode
+          _appClockTotal.fetch_add( static_cast<std::uint64_t>( clockMeas.first * weight * 1e9 ), std::memory_order_relaxed ) ;
+          _procClockTotal.fetch_add( static_cast<std::uint64_t>( clockMeas.second * weight * 1e9 ), std::memory_order_relaxed ) ;
+        }
+        // non-throwing skip, see ProcessorApi::skipCurrentEvent().
+        // Counted for the item that requested it only: other items of the
+        // same event may run concurrently and see the flag too
+        if( event->skipped() ) {
+          if( event->skippedBy() == item->processor().get() ) {
+            _statistics[ index ]._skipped ++ ;
+          }
+          return false ;
+        }
       }
     }
-    catch ( SkipEventException& e ) {
-      auto iter = _skipEventMap.find( e.what() ) ;
-      if ( _skipEventMap.end() == iter ) {
-        _skipEventMap.insert( SkippedEventMap::value_type( e.what() , 1 ) ) ;
-      }
-      else {
-        iter->second ++;
-      }
+    // kept for processors throwing directly or using the throwing API
+    catch ( SkipEventException& ) {
+      _statistics[ index ]._skipped ++ ;
+      return false ;
+    }
+    if( earlyRelease and ( index == _items.size() ) and ( end < _items.size() ) ) {
+      // none of the following items can run: the event is finished
+      ++ _nReleased ;
+      return false ;
+    }
+    return true ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  Sequence::Index Sequence::nextItem( const ProcessorConditionsExtension &extension, Index index, Index limit ) const {
+    const Index stop = std::min( limit, _nextUnconditioned[ std::min( index, _items.size() ) ] ) ;
+    while( ( index < stop ) and extension.isFalse( _conditionIndices[ index ] ) ) {
+      ++ index ;
+    }
+    return std::min( index, limit ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Sequence::resolveConditions( const std::shared_ptr<const CompiledConditions> &conditions ) {
+    // The indices are resolved lazily on the first event. The critical stage
+    // threads may run items of this sequence concurrently (see PEPScheduler):
+    // the first caller resolves them, the others wait and reuse the result
+    std::lock_guard<std::mutex> lock( _conditionsMutex ) ;
+    if( conditions.get() == _resolvedConditions.load( std::memory_order_relaxed ) ) {
+      return ;
+    }
+    _conditions = conditions ;
+    _conditionIndices.clear() ;
+    for( auto &item : _items ) {
+      _conditionIndices.push_back( _conditions->conditionIndex( item->name() ) ) ;
+    }
+    _nextUnconditioned.assign( _items.size() + 1, _items.size() ) ;
+    for( Index index=_items.size() ; index>0 ; --index ) {
+      _nextUnconditioned[ index-1 ] = ( CompiledConditions::npos == _conditionIndices[ index-1 ] ) ?
+        index-1 : _nextUnconditioned[ index ] ;
+    }
+    _resolvedConditions.store( _conditions.get(), std::memory_order_release ) ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void Sequence::setTiming( TimingMode mode, unsigned int sampling ) {
+    if( 0 == sampling ) {
+      throw Exception( "Sequence::setTiming: sampling must be > 0" ) ;
+    }
+    _timingMode = mode ;
+    _timingSampling = ( TimingMode::Sampled == mode ) ? sampling : 1 ;
+    if( TimingMode::Fast == mode ) {
+      // calibrate now and not on the first event
+      (void)fastclock::secondsPerTick() ;
     }
   }
 
@@ -149,24 +356,34 @@ namespace marlinmt {
 
   ClockMeasure Sequence::clockMeasureSummary() const {
     ClockMeasure summary {} ;
-    for ( auto t : _clockMeasures ) {
-      summary._appClock += t.second._appClock ;
-      summary._procClock += t.second._procClock ;
-      summary._counter += t.second._counter ;
+    for ( auto &stats : _statistics ) {
+      const double scale = stats._clock.timedScale() ;
+      summary._appClock += static_cast<clock::duration_rep>( stats._clock._appClock * scale ) ;
+      summary._procClock += static_cast<clock::duration_rep>( stats._clock._procClock * scale ) ;
+      summary._counter += stats._clock._counter ;
     }
+    summary._timed = summary._counter ;
     return summary ;
   }
 
   //--------------------------------------------------------------------------
 
-  const Sequence::ClockMeasureMap &Sequence::clockMeasures() const {
-    return _clockMeasures ;
+  clock::pair Sequence::clockTotals() const {
+    return clock::pair(
+      static_cast<clock::duration_rep>( static_cast<double>( _appClockTotal.load() ) * 1e-9 ),
+      static_cast<clock::duration_rep>( static_cast<double>( _procClockTotal.load() ) * 1e-9 )) ;
   }
 
   //--------------------------------------------------------------------------
 
-  const Sequence::SkippedEventMap &Sequence::skippedEvents() const {
-    return _skipEventMap ;
+  std::size_t Sequence::releasedEvents() const {
+    return _nReleased ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  const ItemStatistics &Sequence::statistics( Index index ) const {
+    return _statistics.at( index ) ;
   }
 
   //--------------------------------------------------------------------------
@@ -178,20 +395,43 @@ namespace marlinmt {
     }
     _sequences.resize(nseqs) ;
     for( std::size_t i=0 ; i<nseqs ; ++i ) {
-      _sequences.at(i) = std::make_shared<Sequence>() ;
+      _sequences.at(i) = std::make_shared<Sequence>( _runContext ) ;
     }
+    _commitSequence = std::make_shared<Sequence>( _runContext ) ;
   }
 
   //--------------------------------------------------------------------------
 
   void SuperSequence::init( Application *app ) {
-    for( auto item : _uniqueItems ) {
+    for( auto &item : _uniqueItems ) {
       item->processor()->setup( app ) ;
     }
   }
 
   //--------------------------------------------------------------------------
 
+  void SuperSequence::initShared( Application *app ) {
+    for( auto &item : _uniqueItems ) {
+      if( item->shared() ) {
+        item->processor()->setup( app ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  void SuperSequence::initSequence( Application *app, Index index ) {
+    auto &seq = _sequences.at( index ) ;
+    for( Sequence::Index i=0 ; i<seq->size() ; ++i ) {
+      auto item = seq->at( i ) ;
+      if( not item->shared() ) {
+        item->processor()->setup( app ) ;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
   std::shared_ptr<Sequence> SuperSequence::sequence( Index index ) const {
     return _sequences.at( index ) ;
   }
@@ -202,8 +442,10 @@ namespace marlinmt {
     
     const bool cloneSet = parameters.hasParameter( "ProcessorClone" ) ;
     const bool criticalSet = parameters.hasParameter( "ProcessorCritical" ) ;
+    const bool orderedSet = parameters.hasParameter( "ProcessorOrdered" ) ;
     bool clone = parameters.parameter<bool>( "ProcessorClone", true ) ;
     bool critical = parameters.parameter<bool>( "ProcessorCritical", false ) ;
+    bool ordered = parameters.parameter<bool>( "ProcessorOrdered", false ) ;
     auto type = parameters.parameter<std::string>( "ProcessorType" ) ;
     auto name = parameters.parameter<std::string>( "ProcessorName" ) ;
     auto &pluginMgr = PluginManager::instance() ;
@@ -213,6 +455,7 @@ namespace marlinmt {
     }
     auto cloneOpt = processor->runtimeOption( Processor::ERuntimeOption::eClone ) ;
     auto criticalOpt = processor->runtimeOption( Processor::ERuntimeOption::eCritical ) ;
+    auto orderedOpt = processor->runtimeOption( Processor::ERuntimeOption::eOrdered ) ;
     if( cloneOpt.has_value() ) {
       if( cloneSet and (cloneOpt.value() != clone) ) {
         throw Exception( "Processor '" +
@@ -233,6 +476,26 @@ namespace marlinmt {
       }
       critical = criticalOpt.value() ;
     }
+    if( orderedOpt.has_value() ) {
+      if( orderedSet and (orderedOpt.value() != ordered) ) {
+        throw Exception( "Processor '" +
+        type +
+        "' ordered option forced to " +
+        (orderedOpt.value() ? "true" : "false") +
+        "!") ;
+      }
+      ordered = orderedOpt.value() ;
+    }
+    if( ordered ) {
+      // a single instance sees all the events in order
+      if( clone and ( cloneSet or cloneOpt.has_value() ) ) {
+        throw Exception( "Processor '" + name + "' can't be both ordered and cloned!" ) ;
+      }
+      clone = false ;
+      if( not _commitIndex.has_value() ) {
+        _commitIndex = _sequences.at(0)->size() ;
+      }
+    }
     processor->setName( name ) ;
     processor->setParameters( parameters ) ;
     std::shared_ptr<std::mutex> lock = critical ? std::make_shared<std::mutex>() : nullptr ;
@@ -240,6 +503,7 @@ namespace marlinmt {
       // add the first but then create new processor instances and add them
       auto item = _sequences.at(0)->createItem( processor, lock ) ;
       _sequences.at(0)->addItem( item ) ;
+      _commitSequence->addItem( item ) ;
       _uniqueItems.insert( item ) ;
       for( SizeType i=1 ; i<size() ; ++i ) {
         processor = pluginMgr.create<Processor>( type ) ;
@@ -252,8 +516,9 @@ namespace marlinmt {
     }
     else {
       // add the first and re-use the same item
-      auto item = _sequences.at(0)->createItem( processor, lock ) ;
+      auto item = _sequences.at(0)->createItem( processor, lock, size() > 1 ) ;
       _sequences.at(0)->addItem( item ) ;
+      _commitSequence->addItem( item ) ;
       _uniqueItems.insert( item ) ;
       for( SizeType i=1 ; i<size() ; ++i ) {
         _sequences.at(i)->addItem( item ) ;
@@ -269,83 +534,136 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  Sequence::Index SuperSequence::commitIndex() const {
+    return _commitIndex.has_value() ? _commitIndex.value() : _sequences.at(0)->size() ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  std::shared_ptr<Sequence> SuperSequence::commitSequence() const {
+    return _commitSequence ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void SuperSequence::processRunHeader( std::shared_ptr<RunHeader> rhdr ) {
-    for( auto item : _uniqueItems ) {
+    for( auto &item : _uniqueItems ) {
       item->processRunHeader( rhdr ) ;
     }
   }
 
   //--------------------------------------------------------------------------
 
+  RunContext &SuperSequence::runContext() {
+    return *_runContext ;
+  }
+
+  //--------------------------------------------------------------------------
+
+  void SuperSequence::updateRunEpoch() {
+    const auto epoch = _runContext->currentEpoch() ;
+    for( auto &item : _uniqueItems ) {
+      item->updateRunEpoch( *_runContext, epoch ) ;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  clock::duration_rep SuperSequence::runHeaderClock() const {
+    clock::duration_rep total {0} ;
+    for( auto &item : _uniqueItems ) {
+      total += item->runHeaderClock() ;
+    }
+    return total ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void SuperSequence::end() {
-    for( auto item : _uniqueItems ) {
+    for( auto &item : _uniqueItems ) {
       item->processor()->end() ;
     }
   }
 
   //--------------------------------------------------------------------------
 
+  void SuperSequence::setTiming( TimingMode mode, unsigned int sampling ) {
+    for( auto &seq : _sequences ) {
+      seq->setTiming( mode, sampling ) ;
+    }
+    _commitSequence->setTiming( mode, sampling ) ;
+    _timingMode = mode ;
+    _timingSampling = ( TimingMode::Sampled == mode ) ? sampling : 1 ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void SuperSequence::printStatistics( Logging::Logger logger ) const {
-    // first merge measurements from the different sequences
-    Sequence::SkippedEventMap skippedEvents {} ;
-    Sequence::ClockMeasureMap clockMeasures {} ;
-    for( unsigned int i=0 ; i<size() ; ++i ) {
-      auto skipped = sequence(i)->skippedEvents() ;
-      auto clocks = sequence(i)->clockMeasures() ;
-      // merge skipped events stats
-      for( auto sk : skipped ) {
-        auto iter = skippedEvents.find( sk.first ) ;
-        if( skippedEvents.end() != iter ) {
-          iter->second += sk.second ;
-        }
-        else {
-          skippedEvents.insert( sk ) ;
-        }
-      }
-      // merge clocks stats
-      for( auto clk : clocks ) {
-        auto iter = clockMeasures.find( clk.first ) ;
-        if( clockMeasures.end() != iter ) {
-          iter->second._appClock += clk.second._appClock ;
-          iter->second._procClock += clk.second._procClock ;
-          iter->second._counter += clk.second._counter ;
-        }
-        else {
-          clockMeasures.insert( clk ) ;
-        }
+    // first merge measurements from the different sequences.
+    // All sequences hold the same processors at the same indices
+    const Sequence::SizeType nitems = _sequences.at(0)->size() ;
+    Sequence::Statistics statistics( nitems ) ;
+    std::size_t nReleased {0} ;
+    for( unsigned int i=0 ; i<=size() ; ++i ) {
+      // the last one is the commit sequence
+      auto &seq = ( i < size() ) ? _sequences.at(i) : _commitSequence ;
+      nReleased += seq->releasedEvents() ;
+      for( Sequence::Index index=0 ; index<nitems ; ++index ) {
+        auto &stats = seq->statistics( index ) ;
+        statistics[index]._clock._appClock += stats._clock._appClock ;
+        statistics[index]._clock._procClock += stats._clock._procClock ;
+        statistics[index]._clock._counter += stats._clock._counter ;
+        statistics[index]._clock._timed += stats._clock._timed ;
+        statistics[index]._skipped += stats._skipped ;
       }
     }
     logger->log<MESSAGE>() << "--------------------------------------------------------- " << std::endl ;
     logger->log<MESSAGE>() << "-- Events skipped by processors : " << std::endl ;
     unsigned int nSkipped = 0 ;
-    for( auto skip : skippedEvents ) {
-      logger->log<MESSAGE>() << "--       " << skip.first << ": \t" << skip.second << std::endl ;
-      nSkipped += skip.second ;
+    for( Sequence::Index index=0 ; index<nitems ; ++index ) {
+      if( statistics[index]._skipped > 0 ) {
+        logger->log<MESSAGE>() << "--       " << _sequences.at(0)->at(index)->name() << ": \t" << statistics[index]._skipped << std::endl ;
+        nSkipped += statistics[index]._skipped ;
+      }
     }
     logger->log<MESSAGE>() << "-- Total: " << nSkipped  << std::endl ;
+    logger->log<MESSAGE>() << "-- Events released early (no processor left to run) : " << nReleased << std::endl ;
     logger->log<MESSAGE>() << "--------------------------------------------------------- " << std::endl
           << std::endl ;
     logger->log<MESSAGE>() << "--------------------------------------------------------- " << std::endl
-          << "      Time used by processors ( in processEvent() ) :      " << std::endl
-          << std::endl ;
-    std::list<Sequence::ClockMeasureMap::value_type> clockList( clockMeasures.begin() , clockMeasures.end() ) ;
-    typedef std::list<Sequence::ClockMeasureMap::value_type>::value_type elt ;
-    clockList.sort( [](const elt &lhs, const elt &rhs) {
-      return ( lhs.second._procClock > rhs.second._procClock ) ;
+          << "      Time used by processors ( in processEvent() ) :      " << std::endl ;
+    if( TimingMode::Sampled == _timingMode ) {
+      logger->log<MESSAGE>() << "      Timing mode: sampled, 1 call in " << _timingSampling << " timed. Times are estimates" << std::endl ;
+    }
+    else {
+      logger->log<MESSAGE>() << "      Timing mode: " << timingModeToString( _timingMode ) << std::endl ;
+    }
+    logger->log<MESSAGE>() << std::endl ;
+    // scale the timed calls to all calls (sampled mode)
+    for( auto &stats : statistics ) {
+      const double scale = stats._clock.timedScale() ;
+      stats._clock._appClock = static_cast<clock::duration_rep>( stats._clock._appClock * scale ) ;
+      stats._clock._procClock = static_cast<clock::duration_rep>( stats._clock._procClock * scale ) ;
+    }
+    std::vector<Sequence::Index> order( nitems ) ;
+    std::iota( order.begin(), order.end(), 0 ) ;
+    std::stable_sort( order.begin(), order.end(), [&](Sequence::Index lhs, Sequence::Index rhs) {
+      return ( statistics[lhs]._clock._procClock > statistics[rhs]._clock._procClock ) ;
     }) ;
     double clockTotal = 0.0 ;
     int eventTotal = 0 ;
-    for( auto clockMeasure : clockList ) {
-      std::string procName = clockMeasure.first ;
+    for( auto index : order ) {
+      auto &clockMeasure = statistics[index]._clock ;
+      std::string procName = _sequences.at(0)->at(index)->name() ;
       procName.resize(40, ' ') ;
-      clockTotal += clockMeasure.second._procClock ;
-      int lockTimeFraction = static_cast<int>(((clockMeasure.second._appClock - clockMeasure.second._procClock) / clockMeasure.second._appClock) * 100.) ;
-      if( clockMeasure.second._counter > eventTotal ){
-        eventTotal = clockMeasure.second._counter ;
+      clockTotal += clockMeasure._procClock ;
+      int lockTimeFraction = static_cast<int>(((clockMeasure._appClock - clockMeasure._procClock) / clockMeasure._appClock) * 100.) ;
+      if( clockMeasure._counter > eventTotal ){
+        eventTotal = clockMeasure._counter ;
       }
       std::stringstream ss ;
-      if ( clockMeasure.second._counter > 0 ) {
-        ss << clockMeasure.second._procClock / static_cast<float>(clockMeasure.second._counter) ;
+      if ( clockMeasure._counter > 0 ) {
+        ss << clockMeasure._procClock / static_cast<float>(clockMeasure._counter) ;
       }
       else {
         ss << "NaN" ;
@@ -356,8 +674,8 @@ namespace marlinmt {
       }
       logger->log<MESSAGE>()
         << procName
-        << std::setw(12) << std::scientific  << clockMeasure.second._procClock  << " s "
-        << "in " << std::setw(12) << clockMeasure.second._counter
+        << std::setw(12) << std::scientific  << clockMeasure._procClock  << " s "
+        << "in " << std::setw(12) << clockMeasure._counter
         << " events  ==> "
         << std::setw(12) << std::scientific << ss.str() << " [ s/evt.] "
         << lockPrint.str()
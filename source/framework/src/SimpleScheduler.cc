@@ -29,6 +29,7 @@ namespace marlinmt {
     // auto activeProcessors = app->activeProcessors() ;
     // create super sequence with only only sequence and fill it
     _superSequence = std::make_shared<SuperSequence>(1) ;
+    _superSequence->setTiming( application().processorTimingMode(), application().processorTimingSampling() ) ;
     log<DEBUG5>() << "Creating processors ..." << std::endl ;
     if ( activeProcessors.empty() ) {
       MARLINMT_THROW( "Active processor list is empty !" ) ;
@@ -62,7 +63,8 @@ namespace marlinmt {
   //--------------------------------------------------------------------------
 
   void SimpleScheduler::pushEvent( std::shared_ptr<EventStore> event ) {
-    _currentEvent = event ;
+    _currentEvent = std::move( event ) ;
+    application().prepareEvent( *_currentEvent ) ;
     auto sequence = _superSequence->sequence(0) ;
     sequence->processEvent( _currentEvent ) ;
   }
@@ -71,7 +73,7 @@ namespace marlinmt {
 
   void SimpleScheduler::popFinishedEvents( std::vector<std::shared_ptr<EventStore>> &events ) {
     if( nullptr != _currentEvent ) {
-      events.push_back( _currentEvent ) ;
+      events.push_back( std::move( _currentEvent ) ) ;
       _currentEvent = nullptr ;
     }
   }
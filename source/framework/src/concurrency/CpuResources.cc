@@ -0,0 +1,254 @@
+#include <marlinmt/concurrency/CpuResources.h>
+
+// -- marlinmt headers
+#include <marlinmt/Exceptions.h>
+
+// -- std headers
+#include <fstream>
+#include <thread>
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <cctype>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    AffinityPolicy affinityPolicyFromString( const std::string &policy ) {
+      if( "none" == policy ) {
+        return AffinityPolicy::None ;
+      }
+      if( "compact" == policy ) {
+        return AffinityPolicy::Compact ;
+      }
+      if( "scatter" == policy ) {
+        return AffinityPolicy::Scatter ;
+      }
+      if( "list" == policy ) {
+        return AffinityPolicy::List ;
+      }
+      throw Exception( "affinityPolicyFromString: unknown affinity policy '" + policy + "' (none, compact, scatter or list)" ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    namespace {
+
+      /// Read the CPU limit of one cgroup v2 directory ("<quota> <period>" or "max <period>")
+      std::optional<double> cgroupV2Limit( const std::filesystem::path &dir ) {
+        std::ifstream cpuMax( dir / "cpu.max" ) ;
+        std::string quota ;
+        double period {0.} ;
+        if( not ( cpuMax >> quota >> period ) or "max" == quota or period <= 0. ) {
+          return std::nullopt ;
+        }
+        try {
+          return std::stod( quota ) / period ;
+        }
+        catch(...) {
+          return std::nullopt ;
+        }
+      }
+
+      /// Read the CPU limit of one cgroup v1 directory. A negative quota means no limit
+      std::optional<double> cgroupV1Limit( const std::filesystem::path &dir ) {
+        std::ifstream quotaFile( dir / "cpu.cfs_quota_us" ) ;
+        std::ifstream periodFile( dir / "cpu.cfs_period_us" ) ;
+        double quota {-1.}, period {0.} ;
+        if( not ( quotaFile >> quota ) or not ( periodFile >> period ) or quota <= 0. or period <= 0. ) {
+          return std::nullopt ;
+        }
+        return quota / period ;
+      }
+
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::optional<double> cgroupCpuLimit( const std::string &procCgroup, const std::string &cgroupRoot ) {
+      // find the process cgroup: "<id>:<controllers>:<path>" lines.
+      // The cgroup v1 "cpu" controller takes precedence over the
+      // cgroup v2 unified hierarchy ("0::<path>") on hybrid setups
+      std::string v2Path, v1Path ;
+      bool v2 {false}, v1 {false} ;
+      std::ifstream cgroupFile( procCgroup ) ;
+      std::string line ;
+      while( std::getline( cgroupFile, line ) ) {
+        const auto first = line.find( ':' ) ;
+        const auto second = ( std::string::npos == first ) ? first : line.find( ':', first + 1 ) ;
+        if( std::string::npos == second ) {
+          continue ;
+        }
+        const auto controllers = line.substr( first + 1, second - first - 1 ) ;
+        const auto path = line.substr( second + 1 ) ;
+        if( controllers.empty() ) {
+          v2 = true ;
+          v2Path = path ;
+          continue ;
+        }
+        std::size_t start {0} ;
+        while( start <= controllers.size() ) {
+          auto end = controllers.find( ',', start ) ;
+          if( std::string::npos == end ) {
+            end = controllers.size() ;
+          }
+          if( "cpu" == controllers.substr( start, end - start ) ) {
+            v1 = true ;
+            v1Path = path ;
+          }
+          start = end + 1 ;
+        }
+      }
+      if( not v1 and not v2 ) {
+        // no cgroup information: use the root cgroup files
+        v2 = true ;
+        v2Path = "/" ;
+      }
+      // the lowest limit from the process cgroup up to the root
+      const std::filesystem::path root = v1 ? std::filesystem::path( cgroupRoot ) / "cpu" : std::filesystem::path( cgroupRoot ) ;
+      std::filesystem::path relative = std::filesystem::path( v1 ? v1Path : v2Path ).relative_path() ;
+      std::optional<double> limit {} ;
+      while( true ) {
+        const auto dirLimit = v1 ? cgroupV1Limit( root / relative ) : cgroupV2Limit( root / relative ) ;
+        if( dirLimit.has_value() and ( not limit.has_value() or dirLimit.value() < limit.value() ) ) {
+          limit = dirLimit ;
+        }
+        if( relative.empty() ) {
+          break ;
+        }
+        relative = relative.parent_path() ;
+      }
+      return limit ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    unsigned int availableCpus() {
+      unsigned int ncpus = static_cast<unsigned int>( allowedCpus().size() ) ;
+      auto limit = cgroupCpuLimit() ;
+      if( limit.has_value() ) {
+        const auto limitCpus = static_cast<unsigned int>( std::ceil( limit.value() ) ) ;
+        ncpus = std::min( ncpus, limitCpus ) ;
+      }
+      return std::max( ncpus, 1u ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::vector<unsigned int> allowedCpus() {
+      std::vector<unsigned int> cpus ;
+#ifdef __linux__
+      cpu_set_t mask ;
+      CPU_ZERO( &mask ) ;
+      if( 0 == sched_getaffinity( 0, sizeof(mask), &mask ) ) {
+        for( unsigned int cpu=0 ; cpu<CPU_SETSIZE ; ++cpu ) {
+          if( CPU_ISSET( cpu, &mask ) ) {
+            cpus.push_back( cpu ) ;
+          }
+        }
+      }
+#endif
+      if( cpus.empty() ) {
+        const unsigned int ncpus = std::max( std::thread::hardware_concurrency(), 1u ) ;
+        for( unsigned int cpu=0 ; cpu<ncpus ; ++cpu ) {
+          cpus.push_back( cpu ) ;
+        }
+      }
+      return cpus ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    unsigned int cpuNode( unsigned int cpu ) {
+      // the cpu directory holds a "nodeN" link on NUMA machines
+      std::error_code ec ;
+      const std::filesystem::path cpuPath( "/sys/devices/system/cpu/cpu" + std::to_string( cpu ) ) ;
+      for( std::filesystem::directory_iterator iter( cpuPath, ec ), end ; not ec and iter != end ; iter.increment( ec ) ) {
+        const auto name = iter->path().filename().string() ;
+        if( name.size() > 4 and 0 == name.compare( 0, 4, "node" ) and std::all_of( name.begin()+4, name.end(), []( unsigned char c ){ return std::isdigit( c ) ; } ) ) {
+          return static_cast<unsigned int>( std::stoul( name.substr( 4 ) ) ) ;
+        }
+      }
+      return 0 ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::vector<unsigned int> workerCpus( AffinityPolicy policy, std::size_t nworkers, const std::vector<unsigned int> &cpuList ) {
+      std::vector<unsigned int> cpus ;
+      if( AffinityPolicy::None == policy or 0 == nworkers ) {
+        return cpus ;
+      }
+      if( AffinityPolicy::List == policy ) {
+        if( cpuList.empty() ) {
+          throw Exception( "workerCpus: empty CPU list!" ) ;
+        }
+        const auto allowed = allowedCpus() ;
+        for( auto cpu : cpuList ) {
+          if( allowed.end() == std::find( allowed.begin(), allowed.end(), cpu ) ) {
+            throw Exception( "workerCpus: CPU " + std::to_string( cpu ) + " is not in the process affinity mask!" ) ;
+          }
+        }
+        for( std::size_t i=0 ; i<nworkers ; ++i ) {
+          cpus.push_back( cpuList[ i % cpuList.size() ] ) ;
+        }
+        return cpus ;
+      }
+      // group the allowed CPUs by NUMA node. Single node
+      // machines end up with the same placement for both policies
+      std::map<unsigned int, std::vector<unsigned int>> nodes ;
+      for( auto cpu : allowedCpus() ) {
+        nodes[ cpuNode( cpu ) ].push_back( cpu ) ;
+      }
+      std::vector<unsigned int> ordered ;
+      if( AffinityPolicy::Compact == policy ) {
+        for( auto &node : nodes ) {
+          ordered.insert( ordered.end(), node.second.begin(), node.second.end() ) ;
+        }
+      }
+      else {
+        std::size_t maxNodeSize {0} ;
+        for( auto &node : nodes ) {
+          maxNodeSize = std::max( maxNodeSize, node.second.size() ) ;
+        }
+        for( std::size_t rank=0 ; rank<maxNodeSize ; ++rank ) {
+          for( auto &node : nodes ) {
+            if( rank < node.second.size() ) {
+              ordered.push_back( node.second[rank] ) ;
+            }
+          }
+        }
+      }
+      for( std::size_t i=0 ; i<nworkers ; ++i ) {
+        cpus.push_back( ordered[ i % ordered.size() ] ) ;
+      }
+      return cpus ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool pinCurrentThread( unsigned int cpu ) {
+#ifdef __linux__
+      if( cpu >= CPU_SETSIZE ) {
+        return false ;
+      }
+      cpu_set_t mask ;
+      CPU_ZERO( &mask ) ;
+      CPU_SET( cpu, &mask ) ;
+      return ( 0 == pthread_setaffinity_np( pthread_self(), sizeof(mask), &mask ) ) ;
+#else
+      (void)cpu ;
+      return false ;
+#endif
+    }
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
@@ -0,0 +1,329 @@
+#include <marlinmt/concurrency/DAGScheduler.h>
+
+// -- marlinmt headers
+#include <marlinmt/Application.h>
+#include <marlinmt/Utils.h>
+#include <marlinmt/Sequence.h>
+#include <marlinmt/Processor.h>
+#include <marlinmt/EventStore.h>
+#include <marlinmt/RunHeader.h>
+
+// -- std headers
+#include <exception>
+#include <algorithm>
+#include <sstream>
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    DAGScheduler::DAGScheduler() :
+      IScheduler() {
+      setName( "DAGScheduler" ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::initialize() {
+      // base init
+      IScheduler::initialize() ;
+      preConfigure() ;
+      configureProcessors() ;
+      configureGraph() ;
+      configurePool() ;
+      _startTime = clock::now() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::end() {
+      waitInFlight( 1 ) ;
+      EventList events ;
+      popFinishedEvents( events ) ;
+      _pool.stop() ;
+      message() << "Terminating application" << std::endl ;
+      _endTime = clock::now() ;
+      _superSequence->end() ;
+      // print some statistics
+      _superSequence->printStatistics( _logger ) ;
+      // print additional threading summary
+      const auto parallelTime = clock::time_difference( _startTime, _endTime ) - _runHeaderTime ;
+      double totalProcessorClock {0.0} ;
+      for ( unsigned int i=0 ; i<_superSequence->size() ; ++i ) {
+        auto summary = _superSequence->sequence(i)->clockMeasureSummary() ;
+        totalProcessorClock += summary._procClock ;
+      }
+      const double speedup = totalProcessorClock / parallelTime ;
+      message() << "---------------------------------------------------" << std::endl ;
+      message() << "-- Threading summary" << std::endl ;
+      message() << "--   N threads:                      " << _superSequence->size() << std::endl ;
+      message() << "--   Max events in flight:           " << _maxInFlight << std::endl ;
+      message() << "--   Speedup (serial/parallel):      " << totalProcessorClock << " / " << parallelTime << " = " << speedup << std::endl ;
+      message() << "--   Stolen tasks:                   " << _pool.nStolenTasks() << std::endl ;
+      message() << "--   Event slot wait time:           " << _pushWaitTime << " ms" << std::endl ;
+      message() << "--   Run header time:                " << _runHeaderTime << " s" << std::endl ;
+      message() << "---------------------------------------------------" << std::endl ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::preConfigure() {
+      // create processor super sequence
+      unsigned int nthreads = application().cmdLineParseResult()._nthreads ;
+      _superSequence = std::make_shared<SuperSequence>(nthreads) ;
+      _superSequence->setTiming( application().processorTimingMode(), application().processorTimingSampling() ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::configureProcessors() {
+      log<DEBUG5>() << "DAGScheduler configureProcessors ..." << std::endl ;
+      auto &execSection = application().configuration().section("execute") ;
+      auto &procsSection = application().configuration().section("processors") ;
+      // create list of active processors
+      auto activeProcessors = execSection.parameterNames() ;
+      if ( activeProcessors.empty() ) {
+        MARLINMT_THROW( "Active processor list is empty !" ) ;
+      }
+      // populate processor sequences
+      for ( size_t i=0 ; i<activeProcessors.size() ; ++i ) {
+        auto procName = activeProcessors[ i ] ;
+        log<DEBUG5>() << "Active processor " << procName << std::endl ;
+        auto &procSection = procsSection.section( procName ) ;
+        _superSequence->addProcessor( procSection ) ;
+      }
+      _superSequence->init( &application() ) ;
+      log<DEBUG5>() << "configureProcessors ... DONE" << std::endl ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::configureGraph() {
+      log<DEBUG5>() << "configureGraph ..." << std::endl ;
+      auto &execSection = application().configuration().section("execute") ;
+      auto &procsSection = application().configuration().section("processors") ;
+      // all sequences hold the same processor list. Use the first one
+      auto sequence = _superSequence->sequence(0) ;
+      const Index nprocs = sequence->size() ;
+      if( _superSequence->commitIndex() < nprocs ) {
+        MARLINMT_THROW( "Ordered processors are not supported by the DAGScheduler. Use the PEP scheduler" ) ;
+      }
+      std::vector<ProcessorDeclaration> declarations( nprocs ) ;
+      _graph.resize( nprocs ) ;
+      for( Index i=0 ; i<nprocs ; ++i ) {
+        auto processor = sequence->at(i)->processor() ;
+        auto &declaration = declarations[i] ;
+        _graph[i]._name = processor->name() ;
+        // collections declared in the code and in the steering file
+        declaration._inputs = processor->inputCollections() ;
+        declaration._outputs = processor->outputCollections() ;
+        declaration._canSkipEvents = processor->canSkipEvents() ;
+        if( procsSection.hasSection( processor->name() ) ) {
+          auto &procSection = procsSection.section( processor->name() ) ;
+          auto in = procSection.parameter<std::vector<std::string>>( "ProcessorInputs", {} ) ;
+          auto out = procSection.parameter<std::vector<std::string>>( "ProcessorOutputs", {} ) ;
+          declaration._inputs.insert( in.begin(), in.end() ) ;
+          declaration._outputs.insert( out.begin(), out.end() ) ;
+          declaration._canSkipEvents = procSection.parameter<bool>( "ProcessorSkipsEvents", declaration._canSkipEvents ) ;
+        }
+        const auto condition = execSection.parameter<std::string>( processor->name(), "true" ) ;
+        declaration._conditional = ( condition != "true" ) ;
+      }
+      auto successors = dependencies( declarations ) ;
+      for( Index i=0 ; i<nprocs ; ++i ) {
+        _graph[i]._successors = std::move( successors[i] ) ;
+        for( auto succ : _graph[i]._successors ) {
+          ++ _graph[succ]._nPredecessors ;
+        }
+      }
+      _roots.clear() ;
+      for( Index i=0 ; i<nprocs ; ++i ) {
+        if( 0 == _graph[i]._nPredecessors ) {
+          _roots.push_back( i ) ;
+        }
+        std::stringstream ss ;
+        for( auto succ : _graph[i]._successors ) {
+          ss << _graph[succ]._name << " " ;
+        }
+        log<DEBUG5>() << "Processor " << _graph[i]._name << ", successors: " << ss.str() << std::endl ;
+      }
+      message() << "Processor graph: " << nprocs << " processors, " << _roots.size() << " without dependency" << std::endl ;
+      log<DEBUG5>() << "configureGraph ... DONE" << std::endl ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::vector<std::vector<DAGScheduler::Index>> DAGScheduler::dependencies( const std::vector<ProcessorDeclaration> &processors ) {
+      auto intersect = []( const std::set<std::string> &lhs, const std::set<std::string> &rhs ) {
+        return std::any_of( lhs.begin(), lhs.end(), [&rhs]( const std::string &name ){
+          return ( rhs.end() != rhs.find( name ) ) ;
+        }) ;
+      } ;
+      auto undeclared = [&]( Index i ) {
+        return ( processors[i]._inputs.empty() and processors[i]._outputs.empty() ) ;
+      } ;
+      const Index nprocs = processors.size() ;
+      std::vector<std::vector<Index>> successors( nprocs ) ;
+      for( Index j=0 ; j<nprocs ; ++j ) {
+        for( Index i=0 ; i<j ; ++i ) {
+          // a processor that may skip the event must run before all the next
+          // ones, even if they only read the same collections
+          const bool depends = undeclared( i ) or undeclared( j )
+            or processors[j]._conditional or processors[i]._canSkipEvents
+            or intersect( processors[i]._outputs, processors[j]._inputs )
+            or intersect( processors[i]._outputs, processors[j]._outputs )
+            or intersect( processors[i]._inputs, processors[j]._outputs ) ;
+          if( depends ) {
+            successors[i].push_back( j ) ;
+          }
+        }
+      }
+      return successors ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::configurePool() {
+      log<DEBUG5>() << "configurePool ..." << std::endl ;
+      _maxInFlight = _maxEventsInFlight.isSet() ?
+        _maxEventsInFlight.get() :
+        static_cast<unsigned int>(2 * _superSequence->size()) ;
+      if( 0 == _maxInFlight ) {
+        MARLINMT_THROW( "MaxEventsInFlight must be > 0" ) ;
+      }
+      // finished events not popped yet: the events in flight plus the
+      // ones pushed by the reader before popping the finished events
+      _completionQueue.setMaxSize( 2 * _maxInFlight + 1 ) ;
+      _pool.start( _superSequence->size() ) ;
+      log<DEBUG5>() << "configurePool ... DONE" << std::endl ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::processRunHeader( std::shared_ptr<RunHeader> rhdr ) {
+      // shared processors may be running on any worker: wait for
+      // all events in flight before processing the run header
+      waitInFlight( 1 ) ;
+      auto rhdrStart = clock::now() ;
+      _superSequence->processRunHeader( rhdr ) ;
+      _runHeaderTime += clock::elapsed_since<clock::seconds>( rhdrStart ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::pushEvent( std::shared_ptr<EventStore> event ) {
+      auto start = clock::now() ;
+      waitInFlight( _maxInFlight ) ;
+      _pushWaitTime += clock::elapsed_since<clock::milliseconds>( start ) ;
+      auto state = std::make_shared<EventState>() ;
+      state->_event = event ;
+      state->_nPendingPredecessors.reset( new std::atomic<unsigned int>[_graph.size()] ) ;
+      for( Index i=0 ; i<_graph.size() ; ++i ) {
+        state->_nPendingPredecessors[i] = _graph[i]._nPredecessors ;
+      }
+      state->_nRemainingTasks = _graph.size() ;
+      {
+        std::lock_guard<std::mutex> lock( _mutex ) ;
+        ++ _nInFlight ;
+      }
+      // prepare the event in a worker before running the root processors
+      _pool.submit( [this, state]( std::size_t ){
+        try {
+          application().prepareEvent( *state->_event ) ;
+        }
+        catch(...) {
+          state->_hasException = true ;
+          state->_exception = std::current_exception() ;
+          state->_skipped = true ;
+        }
+        for( auto root : _roots ) {
+          submitTask( state, root ) ;
+        }
+      }) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::popFinishedEvents( std::vector<std::shared_ptr<EventStore>> &events ) {
+      EventStatePtr state {nullptr} ;
+      while( _completionQueue.pop( state ) ) {
+        // if an exception was raised during processing rethrow it there !
+        if( nullptr != state->_exception ) {
+          std::rethrow_exception( state->_exception ) ;
+        }
+        message() << "Finished event uid " << state->_event->uid() << std::endl ;
+        events.push_back( std::move( state->_event ) ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::size_t DAGScheduler::freeSlots() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return ( _nInFlight >= _maxInFlight ) ? 0 : ( _maxInFlight - _nInFlight ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::runTask( const EventStatePtr &state, Index index, std::size_t worker ) {
+      if( not state->_skipped.load() ) {
+        try {
+          // the worker always uses its own sequence: cloned processors
+          // are never called concurrently
+          if( not _superSequence->sequence( worker )->processEvent( state->_event, index ) ) {
+            state->_skipped = true ;
+          }
+        }
+        catch(...) {
+          if( not state->_hasException.exchange( true ) ) {
+            state->_exception = std::current_exception() ;
+          }
+          state->_skipped = true ;
+        }
+      }
+      for( auto succ : _graph[index]._successors ) {
+        if( 1 == state->_nPendingPredecessors[succ].fetch_sub( 1 ) ) {
+          submitTask( state, succ ) ;
+        }
+      }
+      if( 1 == state->_nRemainingTasks.fetch_sub( 1 ) ) {
+        finishEvent( state ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::submitTask( const EventStatePtr &state, Index index ) {
+      _pool.submit( [this, state, index]( std::size_t worker ){
+        runTask( state, index, worker ) ;
+      }) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::finishEvent( const EventStatePtr &state ) {
+      EventStatePtr output = state ;
+      // The completion queue is sized to hold all events in flight,
+      // so this should never loop. See DAGScheduler::configurePool()
+      while( not _completionQueue.push( output ) ) {
+        std::this_thread::yield() ;
+      }
+      {
+        std::lock_guard<std::mutex> lock( _mutex ) ;
+        -- _nInFlight ;
+      }
+      _conditionVariable.notify_all() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void DAGScheduler::waitInFlight( std::size_t maxInFlight ) {
+      std::unique_lock<std::mutex> lock( _mutex ) ;
+      _conditionVariable.wait( lock, [this, maxInFlight](){
+        return ( _nInFlight < maxInFlight ) ;
+      }) ;
+    }
+
+  }
+
+} // namespace marlinmt
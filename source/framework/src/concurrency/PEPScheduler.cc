@@ -8,12 +8,18 @@
 #include <marlinmt/PluginManager.h>
 #include <marlinmt/EventStore.h>
 #include <marlinmt/RunHeader.h>
+#include <marlinmt/RunContext.h>
+#include <marlinmt/EventExtensions.h>
+#include <marlinmt/concurrency/CpuResources.h>
+#include <marlinmt/book/ThreadSlot.h>
 
 // -- std headers
 #include <exception>
 #include <algorithm>
 #include <iomanip>
 #include <set>
+#include <sstream>
+#include <string>
 
 namespace marlinmt {
 
@@ -22,11 +28,10 @@ namespace marlinmt {
     /**
      *  @brief  ProcessorSequenceWorker class
      */
-    class ProcessorSequenceWorker : public WorkerBase<PEPScheduler::InputType,PEPScheduler::OutputType> {
+    class ProcessorSequenceWorker : public WorkerBase<PEPScheduler::InputType,void> {
     public:
-      using Base = WorkerBase<PEPScheduler::InputType,PEPScheduler::OutputType>;
-      using Input = Base::Input ;
-      using Output = Base::Output ;
+      using Base = WorkerBase<PEPScheduler::InputType,void>;
+      using Input = PEPScheduler::InputType ;
 
     public:
       ~ProcessorSequenceWorker() = default ;
@@ -35,39 +40,45 @@ namespace marlinmt {
       /**
        *  @brief  Constructor
        *
-       *  @param  sequence the processor sequence to execute
+       *  @param  scheduler the scheduler owning the worker
+       *  @param  index the index of the processor sequence to execute
        */
-      ProcessorSequenceWorker( std::shared_ptr<Sequence> sequence ) ;
+      ProcessorSequenceWorker( PEPScheduler &scheduler, std::size_t index ) ;
 
     private:
       // from WorkerBase<IN,OUT>
-      Output process( Input && event ) override ;
+      void process( Input && input ) override ;
+      void initialize() override ;
 
     private:
+      ///< The scheduler owning the worker
+      PEPScheduler                       &_scheduler ;
+      ///< The index of the processor sequence
+      const std::size_t                   _index ;
       ///< The processor sequence to run in the worker thread
-      std::shared_ptr<Sequence>     _sequence {nullptr} ;
+      std::shared_ptr<Sequence>           _sequence {nullptr} ;
     };
 
     //--------------------------------------------------------------------------
     //--------------------------------------------------------------------------
 
-    ProcessorSequenceWorker::ProcessorSequenceWorker( std::shared_ptr<Sequence> sequence ) :
-      _sequence(sequence) {
+    ProcessorSequenceWorker::ProcessorSequenceWorker( PEPScheduler &scheduler, std::size_t index ) :
+      _scheduler(scheduler),
+      _index(index),
+      _sequence(scheduler._superSequence->sequence(index)) {
       /* nop */
     }
 
     //--------------------------------------------------------------------------
 
-    ProcessorSequenceWorker::Output ProcessorSequenceWorker::process( Input && event ) {
-      Output output {} ;
-      output._event = event ;
-      try {
-        _sequence->processEvent( event ) ;
-      }
-      catch(...) {
-        output._exception = std::current_exception() ;
-      }
-      return output ;
+    void ProcessorSequenceWorker::process( Input && input ) {
+      _scheduler.runSequence( _sequence, std::move( input ) ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void ProcessorSequenceWorker::initialize() {
+      _scheduler.initializeWorker( _index ) ;
     }
 
     //--------------------------------------------------------------------------
@@ -77,6 +88,30 @@ namespace marlinmt {
       IScheduler() {
       setName( "PEPScheduler" ) ;
     }
+
+    //--------------------------------------------------------------------------
+
+    PEPScheduler::~PEPScheduler() {
+      // normal termination goes through end(). Here, don't
+      // wait for the remaining events on errors
+      stopElasticWorkers() ;
+      for( auto &stage : _criticalStages ) {
+        {
+          std::lock_guard<std::mutex> lock( stage->_mutex ) ;
+          stage->_stop = true ;
+          stage->_queue.clear() ;
+          stage->_conditionVariable.notify_all() ;
+        }
+        if( stage->_thread.joinable() ) {
+          stage->_thread.join() ;
+        }
+      }
+      if( _commitThread.joinable() ) {
+        _commitBuffer.stop( false ) ;
+        _commitThread.join() ;
+      }
+      _pool.stop( true ) ;
+    }
     
     //--------------------------------------------------------------------------
 
@@ -86,20 +121,45 @@ namespace marlinmt {
       preConfigure() ;
       configureProcessors() ;
       configurePool() ;
+      _asyncLogger = application().asyncLogger() ;
       _startTime = clock::now() ;
     }
 
     //--------------------------------------------------------------------------
 
     void PEPScheduler::end() {
+      stopElasticWorkers() ;
+      if( not _criticalStages.empty() ) {
+        // events may still go back from the stages to the pool
+        std::unique_lock<std::mutex> lock( _activeMutex ) ;
+        _activeConditionVariable.wait( lock, [this](){
+          return ( 0 == _nActiveEvents ) ;
+        }) ;
+      }
+      for( auto &stage : _criticalStages ) {
+        {
+          std::lock_guard<std::mutex> lock( stage->_mutex ) ;
+          stage->_stop = true ;
+          stage->_conditionVariable.notify_all() ;
+        }
+        stage->_thread.join() ;
+      }
       _pool.stop(false) ;
+      if( _commitThread.joinable() ) {
+        _commitBuffer.stop() ;
+        _commitThread.join() ;
+      }
       EventList events ;
       popFinishedEvents( events ) ;
-      if( not _pushResults.empty() ) {
+      if( 0 != _nInFlight ) {
         error() << "This should never happen !!" << std::endl ;
       }
       message() << "Terminating application" << std::endl ;
       _endTime = clock::now() ;
+      // apply the remaining run headers to processors that didn't see them
+      auto rhdrStart = clock::now() ;
+      _superSequence->updateRunEpoch() ;
+      _runHeaderTime += clock::elapsed_since<clock::seconds>( rhdrStart ) ;
       _superSequence->end() ;
       // print some statistics
       _superSequence->printStatistics( _logger ) ;
@@ -112,6 +172,9 @@ namespace marlinmt {
         totalProcessorClock += summary._procClock ;
         totalApplicationClock += summary._appClock ;
       }
+      auto commitSummary = _superSequence->commitSequence()->clockMeasureSummary() ;
+      totalProcessorClock += commitSummary._procClock ;
+      totalApplicationClock += commitSummary._appClock ;
       const double speedup = totalProcessorClock / parallelTime ;
       const double lockTimeFraction = ((totalApplicationClock - totalProcessorClock) / totalApplicationClock) * 100. ;
       message() << "---------------------------------------------------" << std::endl ;
@@ -127,7 +190,59 @@ namespace marlinmt {
       }
       message() << "--   Queue lock time:                " << _lockingTime << " ms" << std::endl ;
       message() << "--   Pop event time:                 " << _popTime << " ms" << std::endl ;
+      message() << "--   Queue full wait time:           " << std::chrono::duration_cast<clock::milliseconds>( _pool.pushWaitTime() ).count() << " ms (" << _pool.nPushWaits() << " waits)" << std::endl ;
       message() << "--   Lock time fraction:             " << lockTimeFraction << " %" << std::endl ;
+      // Amdahl's law: the serial part is the main thread time without the waits on the workers
+      const double pushWaitTime = std::chrono::duration_cast<clock::milliseconds>( _pool.pushWaitTime() ).count()
+        + std::chrono::duration_cast<clock::milliseconds>( _commitBuffer.acquireWaitTime() ).count()
+        + _activeWaitTime ;
+      const double serialTime = ( _dispatchTime + std::max( 0., _lockingTime - pushWaitTime ) ) * 1e-3 ;
+      const double serialFraction = ( serialTime + totalProcessorClock > 0. ) ? serialTime / ( serialTime + totalProcessorClock ) : 0. ;
+      message() << "--   Serial time (main thread):      " << serialTime << " s (dispatch " << _dispatchTime * 1e-3 << " s)" << std::endl ;
+      std::stringstream maxSpeedup ;
+      if( serialFraction > 0. ) {
+        maxSpeedup << " (max speedup " << 1. / serialFraction << ")" ;
+      }
+      message() << "--   Serial fraction:                " << serialFraction * 100. << " %" << maxSpeedup.str() << std::endl ;
+      if( not _workerCpus.empty() ) {
+        std::set<unsigned int> nodes ;
+        for( auto cpu : _workerCpus ) {
+          nodes.insert( cpuNode( cpu ) ) ;
+        }
+        message() << "--   Worker affinity:                " << _workerAffinity.get() << ", " << _nPinnedWorkers << " pinned worker(s) on " << nodes.size() << " NUMA node(s)" << std::endl ;
+      }
+      if( _elasticWorkers.get() ) {
+        const double averageActive = ( 0 == _nElasticDecisions ) ? 0. : static_cast<double>( _activeWorkersSum ) / static_cast<double>( _nElasticDecisions ) ;
+        message() << "--   Elastic workers:                [" << _elasticMin << ", " << _elasticMax << "], " << averageActive << " active (average)" << std::endl ;
+        message() << "--   Elastic scaling:                " << _nScaleUp << " up, " << _nScaleDown << " down (" << _nElasticDecisions << " decisions)" << std::endl ;
+      }
+      if( _ordered ) {
+        const auto commitIndex = _superSequence->commitIndex() ;
+        message() << "--   Ordered processors from:        " << _superSequence->commitSequence()->at( commitIndex )->name() << std::endl ;
+        message() << "--   Reorder buffer size:            " << _commitBuffer.maxSize() << std::endl ;
+        message() << "--   Reorder buffer occupancy:       " << _commitBuffer.averageOccupancy() << " (average)" << std::endl ;
+        message() << "--   Reorder buffer full wait time:  " << std::chrono::duration_cast<clock::milliseconds>( _commitBuffer.acquireWaitTime() ).count() << " ms (" << _commitBuffer.nAcquireWaits() << " waits)" << std::endl ;
+      }
+      if( not _criticalStages.empty() ) {
+        message() << "--   Critical stages:                " << _criticalStages.size() << std::endl ;
+        message() << "--   Event slot wait time:           " << _activeWaitTime << " ms" << std::endl ;
+        for( auto &stage : _criticalStages ) {
+          const double occupancy = ( 0 == stage->_nEvents ) ? 0. : static_cast<double>( stage->_occupancySum ) / static_cast<double>( stage->_nEvents ) ;
+          const double utilization = ( parallelTime > 0. ) ? stage->_busyTime * 100. / parallelTime : 0. ;
+          message() << "--     " << _superSequence->sequence(0)->at( stage->_index )->name() << ": "
+                    << stage->_nEvents << " events, busy " << utilization << " %, queue occupancy " << occupancy << " (average)" << std::endl ;
+        }
+      }
+      // run headers are processed in the workers. The former implementation
+      // drained the pool and processed them serially in the scheduler thread
+      const double runHeaderClock = _superSequence->runHeaderClock() ;
+      const double barrierTime = _superSequence->runContext().barrierTime() ;
+      const double nthreads = static_cast<double>( _superSequence->size() ) ;
+      const double runHeaderSaved = runHeaderClock - (runHeaderClock + barrierTime) / nthreads - _runHeaderTime ;
+      message() << "--   Run headers:                    " << _superSequence->runContext().currentEpoch() << std::endl ;
+      message() << "--   Run header processing time:     " << runHeaderClock << " s (serial equivalent)" << std::endl ;
+      message() << "--   Run header barrier wait time:   " << barrierTime << " s" << std::endl ;
+      message() << "--   Run header time saved (est.):   " << runHeaderSaved << " s (excluding pool drain time)" << std::endl ;
       message() << "---------------------------------------------------" << std::endl ;
     }
 
@@ -137,6 +252,8 @@ namespace marlinmt {
       // create processor super sequence
       unsigned int nthreads = application().cmdLineParseResult()._nthreads ;
       _superSequence = std::make_shared<SuperSequence>(nthreads) ;
+      _superSequence->setTiming( application().processorTimingMode(), application().processorTimingSampling() ) ;
+      _affinityPolicy = affinityPolicyFromString( _workerAffinity.get() ) ;
     }
 
     //--------------------------------------------------------------------------
@@ -161,7 +278,19 @@ namespace marlinmt {
         // }
         _superSequence->addProcessor( procSection ) ;
       }
-      _superSequence->init( &application() ) ;
+      // the processors book their histograms in init(): the multi copy histograms
+      // need an instance for each thread running processors. The main thread,
+      // the workers, the critical stage threads and the commit thread
+      configureCriticalStages() ;
+      const std::size_t nthreads = 1 + _superSequence->size() + _criticalStages.size() + ( _ordered ? 1 : 0 ) ;
+      application().bookStoreManager().setNumberOfThreads( nthreads ) ;
+      if( AffinityPolicy::None == _affinityPolicy ) {
+        _superSequence->init( &application() ) ;
+      }
+      else {
+        // the clones are set up in their worker thread. See initializeWorker()
+        _superSequence->initShared( &application() ) ;
+      }
       log<DEBUG5>() << "configureProcessors ... DONE" << std::endl ;
     }
 
@@ -171,69 +300,419 @@ namespace marlinmt {
       // create N workers for N processor sequences
       log<DEBUG5>() << "configurePool ..." << std::endl ;
       log<DEBUG5>() << "Number of workers: " << _superSequence->size() << std::endl ;
+      const auto commitIndex = _commitIndex ;
       for( unsigned int i=0 ; i<_superSequence->size() ; ++i ) {
         log<DEBUG>() << "Adding worker ..." << std::endl ;
-        _pool.addWorker<ProcessorSequenceWorker>( _superSequence->sequence(i) ) ;
+        _pool.addWorker<ProcessorSequenceWorker>( *this, i ) ;
+      }
+      if( AffinityPolicy::None != _affinityPolicy ) {
+        _workerCpus = workerCpus( _affinityPolicy, _superSequence->size(), _workerCpuList.get() ) ;
+        _pool.setWorkerCpus( _workerCpus ) ;
+        std::stringstream ss ;
+        for( auto cpu : _workerCpus ) {
+          ss << cpu << "(node " << cpuNode( cpu ) << ") " ;
+        }
+        message() << "Worker affinity '" << _workerAffinity.get() << "', CPUs: " << ss.str() << std::endl ;
       }
       log<DEBUG5>() << "starting thread pool" << std::endl ;
       unsigned int queueSize = _queueSize.isSet() ? 
         _queueSize.get() : 
         static_cast<unsigned int>(2 * _superSequence->size()) ;
       _pool.setMaxQueueSize( queueSize ) ;
+      // events in flight: in the queue, processed by the workers and the one pushed
+      // by the reader while the scheduler is blocked in pushEvent()
+      std::size_t maxInFlight = queueSize + _superSequence->size() + 1 ;
+      if( _ordered ) {
+        const unsigned int bufferSize = _orderedBufferSize.isSet() ?
+          _orderedBufferSize.get() :
+          static_cast<unsigned int>(queueSize + 2 * _superSequence->size()) ;
+        _commitBuffer.setMaxSize( bufferSize ) ;
+        // plus the events in the reorder buffer and the one in the commit thread
+        maxInFlight += bufferSize + 1 ;
+        message() << "Processors from '" << _superSequence->commitSequence()->at( commitIndex )->name()
+                  << "' run in input order in the commit thread (buffer size=" << bufferSize << ")" << std::endl ;
+        _commitThread = std::thread( &PEPScheduler::commitEvents, this ) ;
+      }
+      if( not _criticalStages.empty() ) {
+        // events in the stage queues don't take a slot in the pool queue
+        _maxActiveEvents = queueSize + _superSequence->size() ;
+        for( auto &stage : _criticalStages ) {
+          auto stagePtr = stage.get() ;
+          stage->_thread = std::thread( [this, stagePtr](){
+            runCriticalStage( *stagePtr ) ;
+          }) ;
+        }
+      }
+      _completionQueue.setMaxSize( maxInFlight ) ;
       _pool.start() ;
+      _nPinnedWorkers = _pool.nPinnedWorkers() ;
+      if( _nPinnedWorkers < _workerCpus.size() ) {
+        warning() << "Only " << _nPinnedWorkers << " out of " << _workerCpus.size() << " worker(s) could be pinned" << std::endl ;
+      }
       _pool.setAcceptPush( true ) ;
+      configureElasticWorkers() ;
       log<DEBUG5>() << "configurePool ... DONE" << std::endl ;
     }
 
     //--------------------------------------------------------------------------
 
-    void PEPScheduler::processRunHeader( std::shared_ptr<RunHeader> rhdr ) {
-      // Current way to process run header:
-      //  - Stop accepting event in thread pool
-      //  - Wait for current events processing to finish
-      //  - Process run header
-      //  - Resume pool access for new event push
-      _pool.setAcceptPush( false ) ;
-      // need to wait for all current tasks to finish
-      // and then process run header
-      while( _pool.active() ) {
-        std::this_thread::sleep_for( std::chrono::microseconds(10) ) ;
+    void PEPScheduler::configureElasticWorkers() {
+      if( not _elasticWorkers.get() ) {
+        return ;
+      }
+      const std::size_t nthreads = _superSequence->size() ;
+      _elasticMin = _minThreads.get() ;
+      _elasticMax = _maxThreads.isSet() ? _maxThreads.get() : nthreads ;
+      if( 0 == _elasticMin or _elasticMin > _elasticMax or _elasticMax > nthreads ) {
+        MARLINMT_THROW( "Elastic workers: invalid thread range [" + std::to_string( _elasticMin ) + ", "
+          + std::to_string( _elasticMax ) + "], must be within [1, " + std::to_string( nthreads ) + "]" ) ;
+      }
+      if( 0 == _elasticInterval.get() ) {
+        MARLINMT_THROW( "Elastic workers: ElasticInterval must be > 0" ) ;
+      }
+      const std::size_t ncpus = availableCpus() ;
+      const std::size_t nactive = std::max( _elasticMin, std::min( _elasticMax, ncpus ) ) ;
+      _pool.setActiveWorkers( nactive ) ;
+      message() << "Elastic workers: " << nactive << " active worker(s) out of " << nthreads
+                << " (range [" << _elasticMin << ", " << _elasticMax << "], " << ncpus << " CPU(s) available)" << std::endl ;
+      _elasticThread = std::thread( &PEPScheduler::controlWorkers, this ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::controlWorkers() {
+      const auto interval = std::chrono::milliseconds( _elasticInterval.get() ) ;
+      const auto sampleInterval = std::max( interval / 10, std::chrono::milliseconds( 1 ) ) ;
+      const double maxLockFraction = _elasticMaxLockFraction.get() ;
+      const double maxQueueSize = static_cast<double>( std::max( _pool.maxQueueSize(), std::size_t(1) ) ) ;
+      auto lastTotals = workerClockTotals() ;
+      std::unique_lock<std::mutex> lock( _elasticMutex ) ;
+      while( not _elasticStop ) {
+        // sample the queue occupancy and the idle active workers over the interval
+        double occupancySum {0.}, idleSum {0.} ;
+        std::size_t nSamples {0} ;
+        const auto deadline = Clock::now() + interval ;
+        while( not _elasticStop and Clock::now() < deadline ) {
+          _elasticConditionVariable.wait_for( lock, sampleInterval ) ;
+          const std::size_t nactive = _pool.activeWorkers() ;
+          const std::size_t nparked = _pool.size() - nactive ;
+          const std::size_t nwaiting = _pool.nWaiting() ;
+          occupancySum += ( maxQueueSize - static_cast<double>( _pool.freeSlots() ) ) / maxQueueSize ;
+          idleSum += ( nwaiting > nparked ) ? static_cast<double>( nwaiting - nparked ) : 0. ;
+          ++ nSamples ;
+        }
+        if( _elasticStop or 0 == nSamples ) {
+          break ;
+        }
+        const double occupancy = occupancySum / static_cast<double>( nSamples ) ;
+        const double idle = idleSum / static_cast<double>( nSamples ) ;
+        const auto totals = workerClockTotals() ;
+        const double appTime = totals.first - lastTotals.first ;
+        const double procTime = totals.second - lastTotals.second ;
+        const double lockFraction = ( appTime > 0. ) ? std::max( appTime - procTime, 0. ) / appTime : 0. ;
+        lastTotals = totals ;
+        const std::size_t ncpus = availableCpus() ;
+        const std::size_t upper = std::max( _elasticMin, std::min( _elasticMax, ncpus ) ) ;
+        const std::size_t current = _pool.activeWorkers() ;
+        std::size_t target = current ;
+        std::string reason {} ;
+        if( current > upper ) {
+          target = upper ;
+          reason = "CPU limit" ;
+        }
+        else if( occupancy > 0.75 and lockFraction < maxLockFraction and current < upper ) {
+          target = current + 1 ;
+          reason = "queue backlog" ;
+        }
+        else if( lockFraction > maxLockFraction and current > _elasticMin ) {
+          target = current - 1 ;
+          reason = "lock contention" ;
+        }
+        else if( occupancy < 0.1 and idle >= 1. and current > _elasticMin ) {
+          target = current - 1 ;
+          reason = "idle workers" ;
+        }
+        ++ _nElasticDecisions ;
+        _activeWorkersSum += target ;
+        std::stringstream measures ;
+        measures << "queue occupancy " << std::setprecision(3) << occupancy
+                 << ", idle workers " << idle
+                 << ", lock fraction " << lockFraction
+                 << ", CPUs " << ncpus ;
+        if( target == current ) {
+          log<DEBUG5>() << "Elastic workers: keep " << current << " active (" << measures.str() << ")" << std::endl ;
+          continue ;
+        }
+        ( target > current ? _nScaleUp : _nScaleDown ) += 1 ;
+        _pool.setActiveWorkers( target ) ;
+        message() << "Elastic workers: " << current << " -> " << target << " active, " << reason << " (" << measures.str() << ")" << std::endl ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::stopElasticWorkers() {
+      if( not _elasticThread.joinable() ) {
+        return ;
+      }
+      {
+        std::lock_guard<std::mutex> lock( _elasticMutex ) ;
+        _elasticStop = true ;
+        _elasticConditionVariable.notify_all() ;
+      }
+      _elasticThread.join() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    clock::pair PEPScheduler::workerClockTotals() const {
+      clock::pair totals {0., 0.} ;
+      for( unsigned int i=0 ; i<_superSequence->size() ; ++i ) {
+        auto sequenceTotals = _superSequence->sequence(i)->clockTotals() ;
+        totals.first += sequenceTotals.first ;
+        totals.second += sequenceTotals.second ;
+      }
+      return totals ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::configureCriticalStages() {
+      _commitIndex = _superSequence->commitIndex() ;
+      _ordered = ( _commitIndex < _superSequence->commitSequence()->size() ) ;
+      auto sequence = _superSequence->sequence(0) ;
+      _stageOfProcessor.assign( sequence->size(), nullptr ) ;
+      if( not _useCriticalStages.get() ) {
+        return ;
+      }
+      // the ordered processors already run in a single thread
+      for( std::size_t i=0 ; i<_commitIndex ; ++i ) {
+        if( sequence->at(i)->critical() ) {
+          auto stage = std::make_unique<CriticalStage>() ;
+          stage->_index = i ;
+          _stageOfProcessor[i] = stage.get() ;
+          _criticalStages.push_back( std::move( stage ) ) ;
+          message() << "Critical processor '" << sequence->at(i)->name() << "' runs in its own stage thread" << std::endl ;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::initializeWorker( std::size_t index ) {
+      // take the book store thread slot now, in worker start order,
+      // instead of on the first histogram handle request
+      (void) book::ThreadSlot::current() ;
+      if( AffinityPolicy::None != _affinityPolicy ) {
+        // the worker thread is already pinned: first touch of the clone data on its node
+        _superSequence->initSequence( &application(), index ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::runSequence( const std::shared_ptr<Sequence> &sequence, InputType &&input ) {
+      // run until the next critical stage or the ordered processors
+      std::size_t stop = input._startIndex ;
+      while( ( stop < _commitIndex ) and ( nullptr == _stageOfProcessor[stop] ) ) {
+        ++ stop ;
+      }
+      OutputType output {} ;
+      output._event = input._event ;
+      // tag the asynchronous log lines of the processors with the event
+      AsyncLogger::setCurrentEvent( input._event->uid() ) ;
+      try {
+        if( 0 == input._startIndex ) {
+          // first step of the event: the reader thread only forwards raw events
+          application().prepareEvent( *input._event ) ;
+        }
+        output._skipped = not sequence->processEvent( input._event, input._startIndex, stop ) ;
+      }
+      catch(...) {
+        output._exception = std::current_exception() ;
+      }
+      AsyncLogger::setCurrentEvent( 0 ) ;
+      if( ( stop < _commitIndex ) and ( nullptr == output._exception ) and ( not output._skipped ) ) {
+        // hand over the event to the stage and take another one
+        auto stage = _stageOfProcessor[stop] ;
+        input._startIndex = stop ;
+        std::lock_guard<std::mutex> lock( stage->_mutex ) ;
+        stage->_queue.push_back( StageInput{ sequence, std::move( input ) } ) ;
+        stage->_conditionVariable.notify_one() ;
+        return ;
+      }
+      forwardEvent( input._sequenceNumber, std::move( output ) ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::runCriticalStage( CriticalStage &stage ) {
+      while( true ) {
+        StageInput stageInput {} ;
+        {
+          std::unique_lock<std::mutex> lock( stage._mutex ) ;
+          stage._conditionVariable.wait( lock, [&stage](){
+            return ( not stage._queue.empty() ) or stage._stop ;
+          }) ;
+          if( stage._queue.empty() ) {
+            break ;
+          }
+          stage._occupancySum += stage._queue.size() ;
+          stageInput = std::move( stage._queue.front() ) ;
+          stage._queue.pop_front() ;
+        }
+        auto &input = stageInput._input ;
+        OutputType output {} ;
+        output._event = input._event ;
+        auto start = clock::now() ;
+        AsyncLogger::setCurrentEvent( input._event->uid() ) ;
+        try {
+          // the processor instance of the worker sequence, called by this thread only
+          output._skipped = not stageInput._sequence->processEvent( input._event, stage._index ) ;
+        }
+        catch(...) {
+          output._exception = std::current_exception() ;
+        }
+        AsyncLogger::setCurrentEvent( 0 ) ;
+        stage._busyTime += clock::elapsed_since<clock::seconds>( start ) ;
+        ++ stage._nEvents ;
+        input._startIndex = stage._index + 1 ;
+        if( ( input._startIndex < _commitIndex ) and ( nullptr == output._exception ) and ( not output._skipped ) ) {
+          // back to the parallel part
+          _pool.post( WorkerPool::PushPolicy::Blocking, std::move( input ) ) ;
+        }
+        else {
+          forwardEvent( input._sequenceNumber, std::move( output ) ) ;
+        }
       }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::forwardEvent( std::size_t sequenceNumber, OutputType &&output ) {
+      if( _ordered ) {
+        // the commit thread finishes the event
+        _commitBuffer.insert( sequenceNumber, std::move( output ) ) ;
+      }
+      else {
+        finishEvent( std::move( output ) ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::finishEvent( OutputType &&output ) {
+      auto runExtension = output._event->extensions().get<extensions::RunEpoch, RunContextExtension>() ;
+      _superSequence->runContext().eventFinished( runExtension->epoch() ) ;
+      // The completion queue is sized to hold all events in flight,
+      // so this should never loop. See PEPScheduler::configurePool()
+      while( not _completionQueue.push( output ) ) {
+        std::this_thread::yield() ;
+      }
+      if( not _criticalStages.empty() ) {
+        {
+          std::lock_guard<std::mutex> lock( _activeMutex ) ;
+          -- _nActiveEvents ;
+        }
+        _activeConditionVariable.notify_all() ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::commitEvents() {
+      auto sequence = _superSequence->commitSequence() ;
+      const auto end = sequence->size() ;
+      OutputType output {} ;
+      while( _commitBuffer.pop( output ) ) {
+        if( ( nullptr == output._exception ) and ( not output._skipped ) ) {
+          AsyncLogger::setCurrentEvent( output._event->uid() ) ;
+          try {
+            output._skipped = not sequence->processEvent( output._event, _commitIndex, end ) ;
+          }
+          catch(...) {
+            output._exception = std::current_exception() ;
+          }
+          AsyncLogger::setCurrentEvent( 0 ) ;
+        }
+        finishEvent( std::move( output ) ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void PEPScheduler::processRunHeader( std::shared_ptr<RunHeader> rhdr ) {
+      // The run header opens a new epoch in the run context. Events pushed
+      // from now on are tagged with this epoch and each worker applies the
+      // run header to its processors before processing its first event of
+      // the new epoch. No need to drain the thread pool here.
+      // The critical stages can't wait on the run epoch barrier without
+      // blocking the older events: drain the events in flight in this case
       auto rhdrStart = clock::now() ;
-      _superSequence->processRunHeader( rhdr ) ;
-      auto rhdrEnd = clock::now() ;
-      _runHeaderTime += clock::time_difference<clock::seconds>( rhdrStart, rhdrEnd ) ;
-      _pool.setAcceptPush( true ) ;
+      if( not _criticalStages.empty() ) {
+        std::unique_lock<std::mutex> lock( _activeMutex ) ;
+        _activeConditionVariable.wait( lock, [this](){
+          return ( 0 == _nActiveEvents ) ;
+        }) ;
+      }
+      _superSequence->runContext().addRunHeader( rhdr ) ;
+      _runHeaderTime += clock::elapsed_since<clock::seconds>( rhdrStart ) ;
     }
 
     //--------------------------------------------------------------------------
 
     void PEPScheduler::pushEvent( std::shared_ptr<EventStore> event ) {
-      // push event to thread pool queue. It might throw !
+      // push event to thread pool queue. Sleeps until a slot is free if the queue is full
       auto start = clock::now() ;
-      _pushResults.push_back( _pool.push( WorkerPool::PushPolicy::ThrowIfFull, std::move(event) ) ) ;
-      _lockingTime += clock::elapsed_since<clock::milliseconds>( start ) ;
+      if( clock::time_point() != _lastPushEnd ) {
+        // the main thread time between two events: reading, dispatch and finished events
+        _dispatchTime += clock::time_difference<clock::milliseconds>( _lastPushEnd, start ) ;
+      }
+      auto &runContext = _superSequence->runContext() ;
+      const auto epoch = runContext.currentEpoch() ;
+      event->extensions().recyclable<extensions::RunEpoch, RunContextExtension>( epoch, runContext.runHeader( epoch ) ) ;
+      runContext.eventStarted( epoch ) ;
+      if( not _criticalStages.empty() ) {
+        // sleeps until the number of events in flight is below the limit
+        auto waitStart = clock::now() ;
+        std::unique_lock<std::mutex> lock( _activeMutex ) ;
+        _activeConditionVariable.wait( lock, [this](){
+          return ( _nActiveEvents < _maxActiveEvents ) ;
+        }) ;
+        ++ _nActiveEvents ;
+        _activeWaitTime += clock::elapsed_since<clock::milliseconds>( waitStart ) ;
+      }
+      InputType input {} ;
+      input._event = std::move(event) ;
+      if( _ordered ) {
+        // sleeps until the reorder buffer has a free slot
+        input._sequenceNumber = _commitBuffer.acquire() ;
+      }
+      _pool.post( WorkerPool::PushPolicy::Blocking, std::move(input) ) ;
+      ++_nInFlight ;
+      _lastPushEnd = clock::now() ;
+      _lockingTime += clock::time_difference<clock::milliseconds>( start, _lastPushEnd ) ;
     }
 
     //--------------------------------------------------------------------------
 
     void PEPScheduler::popFinishedEvents( std::vector<std::shared_ptr<EventStore>> &events ) {
       auto start = clock::now() ;
-      auto iter = _pushResults.begin() ;
-      while( iter != _pushResults.end() ) {
-        const bool finished = (iter->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ;
-        if( finished ) {
-          auto output = iter->second.get() ;
-          // if an exception was raised during processing rethrow it there !
-          if( nullptr != output._exception ) {
-            std::rethrow_exception( output._exception ) ;
-          }
-          message() << "Finished event uid " << output._event->uid() << std::endl ;
-          events.push_back( output._event ) ;
-          iter = _pushResults.erase( iter ) ;
-          continue;
+      OutputType output {} ;
+      while( _completionQueue.pop( output ) ) {
+        --_nInFlight ;
+        // if an exception was raised during processing rethrow it there !
+        if( nullptr != output._exception ) {
+          std::rethrow_exception( output._exception ) ;
+        }
+        // written as the last line of the event, before its flush
+        AsyncLogger::setCurrentEvent( output._event->uid() ) ;
+        MARLINMT_LOG_LINE( *this, MESSAGE, "Finished event uid ", output._event->uid() ) ;
+        AsyncLogger::setCurrentEvent( 0 ) ;
+        if( nullptr != _asyncLogger ) {
+          _asyncLogger->flushEvent( output._event->uid() ) ;
         }
-        ++iter ;
+        events.push_back( std::move( output._event ) ) ;
       }
       _popTime += clock::elapsed_since<clock::milliseconds>( start ) ;
     }
@@ -0,0 +1,159 @@
+#include <marlinmt/concurrency/ReadAheadBuffer.h>
+
+// -- marlinmt headers
+#include <marlinmt/Exceptions.h>
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    ReadAheadBuffer::ReadAheadBuffer( std::size_t maxSize ) :
+      _maxSize(maxSize) {
+      if( 0 == _maxSize ) {
+        throw Exception( "ReadAheadBuffer: buffer size must be > 0" ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    ReadAheadBuffer::~ReadAheadBuffer() {
+      stop() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void ReadAheadBuffer::start( ReaderFunction reader ) {
+      if( _thread.joinable() ) {
+        throw Exception( "ReadAheadBuffer::start: reader already started!" ) ;
+      }
+      _thread = std::thread( [this, reader](){
+        std::exception_ptr exception {nullptr} ;
+        try {
+          reader() ;
+        }
+        catch(...) {
+          exception = std::current_exception() ;
+        }
+        std::lock_guard<std::mutex> lock( _mutex ) ;
+        _exception = exception ;
+        _readerFinished = true ;
+        _pushConditionVariable.notify_all() ;
+      }) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void ReadAheadBuffer::stop() {
+      {
+        std::lock_guard<std::mutex> lock( _mutex ) ;
+        _stop = true ;
+        _records.clear() ;
+        _popConditionVariable.notify_all() ;
+      }
+      if( _thread.joinable() ) {
+        _thread.join() ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool ReadAheadBuffer::push( std::shared_ptr<EventStore> event ) {
+      return pushRecord( Record{ event, nullptr } ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool ReadAheadBuffer::push( std::shared_ptr<RunHeader> rhdr ) {
+      return pushRecord( Record{ nullptr, rhdr } ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool ReadAheadBuffer::pop( Record &record ) {
+      std::unique_lock<std::mutex> lock( _mutex ) ;
+      if( _records.empty() and not _readerFinished ) {
+        auto start = clock::now() ;
+        _pushConditionVariable.wait( lock, [this](){
+          return ( not _records.empty() ) or _readerFinished ;
+        }) ;
+        _dispatcherStallTime += clock::elapsed_since<clock::milliseconds>( start ) ;
+      }
+      if( _records.empty() ) {
+        // reader finished. Forward the reader exception, if any
+        if( nullptr != _exception ) {
+          auto exception = _exception ;
+          _exception = nullptr ;
+          std::rethrow_exception( exception ) ;
+        }
+        return false ;
+      }
+      _occupancySum += _records.size() ;
+      ++ _nRecords ;
+      record = std::move( _records.front() ) ;
+      _records.pop_front() ;
+      _popConditionVariable.notify_one() ;
+      return true ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool ReadAheadBuffer::stopped() const {
+      return _stop.load() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::size_t ReadAheadBuffer::maxSize() const {
+      return _maxSize ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::size_t ReadAheadBuffer::nRecords() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return _nRecords ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    double ReadAheadBuffer::averageOccupancy() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return ( 0 == _nRecords ) ? 0. : static_cast<double>( _occupancySum ) / static_cast<double>( _nRecords ) ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    clock::duration_rep ReadAheadBuffer::readerStallTime() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return _readerStallTime ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    clock::duration_rep ReadAheadBuffer::dispatcherStallTime() const {
+      std::lock_guard<std::mutex> lock( _mutex ) ;
+      return _dispatcherStallTime ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool ReadAheadBuffer::pushRecord( Record &&record ) {
+      std::unique_lock<std::mutex> lock( _mutex ) ;
+      if( _records.size() >= _maxSize and not _stop.load() ) {
+        auto start = clock::now() ;
+        _popConditionVariable.wait( lock, [this](){
+          return ( _records.size() < _maxSize ) or _stop.load() ;
+        }) ;
+        _readerStallTime += clock::elapsed_since<clock::milliseconds>( start ) ;
+      }
+      if( _stop.load() ) {
+        return false ;
+      }
+      _records.push_back( std::move( record ) ) ;
+      _pushConditionVariable.notify_one() ;
+      return true ;
+    }
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
@@ -0,0 +1,153 @@
+#include <marlinmt/concurrency/WorkStealingPool.h>
+
+// -- marlinmt headers
+#include <marlinmt/Exceptions.h>
+
+namespace marlinmt {
+
+  namespace concurrency {
+
+    namespace {
+      /// The pool owning the current thread, if any
+      thread_local const WorkStealingPool *currentPool = nullptr ;
+      /// The worker index of the current thread in its pool
+      thread_local std::size_t currentIndex = 0 ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    WorkStealingPool::~WorkStealingPool() {
+      stop() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void WorkStealingPool::start( std::size_t nworkers ) {
+      if( not _threads.empty() ) {
+        throw Exception( "WorkStealingPool::start: already running!" ) ;
+      }
+      if( 0 == nworkers ) {
+        throw Exception( "WorkStealingPool::start: number of workers must be > 0" ) ;
+      }
+      _stop = false ;
+      for( std::size_t i=0 ; i<nworkers ; ++i ) {
+        _queues.push_back( std::make_unique<TaskQueue>() ) ;
+      }
+      for( std::size_t i=0 ; i<nworkers ; ++i ) {
+        _threads.push_back( std::thread( &WorkStealingPool::run, this, i ) ) ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void WorkStealingPool::stop() {
+      if( _threads.empty() ) {
+        return ;
+      }
+      _stop = true ;
+      {
+        std::unique_lock<std::mutex> lock( _mutex ) ;
+        _conditionVariable.notify_all() ;
+      }
+      for( auto &thread : _threads ) {
+        thread.join() ;
+      }
+      _threads.clear() ;
+      _queues.clear() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void WorkStealingPool::submit( Task task ) {
+      if( _queues.empty() ) {
+        throw Exception( "WorkStealingPool::submit: pool not running!" ) ;
+      }
+      const std::size_t index = ( this == currentPool ) ?
+        currentIndex :
+        ( _nextQueue.fetch_add( 1, std::memory_order_relaxed ) % _queues.size() ) ;
+      // count the task first so that the counter never underflows
+      ++ _nPendingTasks ;
+      {
+        std::lock_guard<std::mutex> lock( _queues[index]->_mutex ) ;
+        _queues[index]->_tasks.push_back( std::move( task ) ) ;
+      }
+      // pairs with the fence in run(): either the worker sees the
+      // pending task before sleeping or we see the worker sleeping here
+      std::atomic_thread_fence( std::memory_order_seq_cst ) ;
+      if( _nSleepingWorkers.load() > 0 ) {
+        std::unique_lock<std::mutex> lock( _mutex ) ;
+        _conditionVariable.notify_one() ;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::size_t WorkStealingPool::size() const {
+      return _threads.size() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    std::size_t WorkStealingPool::nStolenTasks() const {
+      return _nStolenTasks.load() ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void WorkStealingPool::run( std::size_t index ) {
+      currentPool = this ;
+      currentIndex = index ;
+      Task task {} ;
+      while( true ) {
+        if( takeTask( index, task ) ) {
+          task( index ) ;
+          task = nullptr ;
+          continue ;
+        }
+        std::unique_lock<std::mutex> lock( _mutex ) ;
+        ++ _nSleepingWorkers ;
+        std::atomic_thread_fence( std::memory_order_seq_cst ) ;
+        _conditionVariable.wait( lock, [this](){
+          return ( _nPendingTasks.load() > 0 ) or _stop.load() ;
+        }) ;
+        -- _nSleepingWorkers ;
+        if( _stop.load() and ( 0 == _nPendingTasks.load() ) ) {
+          break ;
+        }
+      }
+      currentPool = nullptr ;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool WorkStealingPool::takeTask( std::size_t index, Task &task ) {
+      // own queue first, newest task
+      {
+        auto &queue = *_queues[index] ;
+        std::lock_guard<std::mutex> lock( queue._mutex ) ;
+        if( not queue._tasks.empty() ) {
+          task = std::move( queue._tasks.back() ) ;
+          queue._tasks.pop_back() ;
+          -- _nPendingTasks ;
+          return true ;
+        }
+      }
+      // steal the oldest task of another worker
+      const std::size_t nqueues = _queues.size() ;
+      for( std::size_t i=1 ; i<nqueues ; ++i ) {
+        auto &queue = *_queues[ (index + i) % nqueues ] ;
+        std::lock_guard<std::mutex> lock( queue._mutex ) ;
+        if( not queue._tasks.empty() ) {
+          task = std::move( queue._tasks.front() ) ;
+          queue._tasks.pop_front() ;
+          -- _nPendingTasks ;
+          ++ _nStolenTasks ;
+          return true ;
+        }
+      }
+      return false ;
+    }
+
+  } // end namespace concurrency
+
+} // end namespace marlinmt
@@ -48,6 +48,7 @@ namespace marlinmt {
   public:
     using EventFunction = std::function<void(std::shared_ptr<EventStore>)> ;
     using RunHeaderFunction = std::function<void(std::shared_ptr<RunHeader>)> ;
+    using EventStoreFunction = std::function<std::shared_ptr<EventStore>()> ;
 
   public:
     ReaderListener() = default ;
@@ -65,6 +66,12 @@ namespace marlinmt {
      */
     void onRunHeaderRead( RunHeaderFunction func ) ;
 
+    /**
+     *  @brief  Set the function providing the event stores to fill.
+     *  If not set, a new event store is allocated for each event
+     */
+    void setEventStoreFactory( EventStoreFunction func ) ;
+
   protected:
     void processEvent( std::shared_ptr<EVENT::LCEvent> event ) override ;
     void processRunHeader( std::shared_ptr<EVENT::LCRunHeader> rhdr ) override ;
@@ -74,6 +81,8 @@ namespace marlinmt {
     EventFunction          _onEventRead {nullptr} ;
     /// Callback function on run info read
     RunHeaderFunction      _onRunHeaderRead {nullptr} ;
+    /// Event store factory function
+    EventStoreFunction     _eventStoreFactory {nullptr} ;
   };
 
 }
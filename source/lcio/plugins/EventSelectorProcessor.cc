@@ -79,11 +79,9 @@ namespace marlinmt {
     }
     auto iter = _evtSet.find( std::make_pair( lcevent->getEventNumber() , lcevent->getRunNumber() ) ) ;
     const bool isInList = (iter != _evtSet.end() ) ;
-    //-- note: this will not be printed if compiled w/o MARLINMTDEBUG=1 !
-    log<DEBUG>() << "   processing event: " << lcevent->getEventNumber()
-  		       << "   in run:  " << lcevent->getRunNumber()
-  		       << " - in event list : " << isInList
-  		       << std::endl ;
+    //-- note: this will not be compiled if MARLINMT_MIN_LOG_LEVEL is above DEBUG !
+    MARLINMT_LOG_LINE( *this, DEBUG, "   processing event: ", lcevent->getEventNumber(),
+      "   in run:  ", lcevent->getRunNumber(), " - in event list : ", isInList ) ;
     ProcessorApi::setReturnValue( this, evt, isInList ) ;
   }
 
@@ -86,6 +86,7 @@ namespace marlinmt {
     _fileReader = std::make_shared<FileReader>( flag ) ;
     _listener.onRunHeaderRead( std::bind( &LCIOFileSource::processRunHeader, this, _1 ) ) ;
     _listener.onEventRead( std::bind( &LCIOFileSource::processEvent, this, _1 ) ) ;
+    _listener.setEventStoreFactory( std::bind( &LCIOFileSource::createEventStore, this ) ) ;
 
     if( _inputFileNames.empty() ) {
       throw Exception( "LCIOFileSource::init: LCIO input file list is empty" ) ;
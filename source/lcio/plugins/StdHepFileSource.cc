@@ -94,7 +94,7 @@ namespace marlinmt {
     event->setRunNumber( 0 ) ;
     event->setEventNumber( _currentReadEvents ) ;
     event->addCollection( collection, _collectionName ) ;
-    auto store = std::make_shared<EventStore>() ;
+    auto store = createEventStore() ;
     store->setEvent( event ) ;
     // generate the event unique id
     auto evtn = event->getEventNumber() ;
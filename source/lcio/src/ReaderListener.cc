@@ -23,9 +23,15 @@ namespace marlinmt {
 
   //--------------------------------------------------------------------------
 
+  void ReaderListener::setEventStoreFactory( EventStoreFunction func ) {
+    _eventStoreFactory = func ;
+  }
+
+  //--------------------------------------------------------------------------
+
   void ReaderListener::processEvent( std::shared_ptr<EVENT::LCEvent> event ) {
     if( nullptr != _onEventRead ) {
-      auto store = std::make_shared<EventStore>() ;
+      auto store = ( nullptr != _eventStoreFactory ) ? _eventStoreFactory() : std::make_shared<EventStore>() ;
       store->setEvent( event ) ;
       // generate the event unique id
       auto evtn = event->getEventNumber() ;
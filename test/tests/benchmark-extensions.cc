@@ -0,0 +1,107 @@
+// -- marlinmt headers
+#include <marlinmt/Extensions.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <chrono>
+#include <iostream>
+#include <map>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+constexpr unsigned int NEvents = 200000 ;
+constexpr unsigned int NLookups = 20 ;
+
+namespace keys {
+  struct Key0 {} ;
+  struct Key1 {} ;
+  struct Key2 {} ;
+  struct Key3 {} ;
+}
+
+/**
+ *  The former implementation of Extensions: a map keyed
+ *  on the key type hash code, for comparison
+ */
+class MapExtensions {
+public:
+  using ExtensionMap = std::map<std::size_t, std::shared_ptr<Extension>> ;
+
+  template <typename K, typename T>
+  inline void add( T *ptr, bool isOwned = true ) {
+    std::type_index typeidx( typeid(K) ) ;
+    _extensions.insert( { typeidx.hash_code(), std::make_shared<Extension>( ptr, isOwned ) } ) ;
+  }
+
+  template <typename K, typename T>
+  inline T *get() {
+    std::type_index typeidx( typeid(K) ) ;
+    auto iter = _extensions.find( typeidx.hash_code() ) ;
+    if( iter == _extensions.end() ) {
+      MARLINMT_THROW( "Extension of type " + std::string(typeidx.name()) + " doesn't exists" ) ;
+    }
+    return iter->second->object<T>() ;
+  }
+
+private:
+  ExtensionMap         _extensions {} ;
+};
+
+/**
+ *  Create the extensions for each event and look them up several times,
+ *  as the sequence and the processors do. Returns the elapsed time in seconds
+ */
+template <typename EXTENSIONS>
+double runLookups( UnitTest &test, const std::string &name ) {
+  unsigned long sum {0} ;
+  auto start = std::chrono::steady_clock::now() ;
+  for( unsigned int e=0 ; e<NEvents ; ++e ) {
+    EXTENSIONS extensions ;
+    extensions.template add<keys::Key0>( new int(0) ) ;
+    extensions.template add<keys::Key1>( new int(1) ) ;
+    extensions.template add<keys::Key2>( new int(2) ) ;
+    extensions.template add<keys::Key3>( new int(3) ) ;
+    for( unsigned int l=0 ; l<NLookups ; ++l ) {
+      sum += *extensions.template get<keys::Key0, int>() ;
+      sum += *extensions.template get<keys::Key1, int>() ;
+      sum += *extensions.template get<keys::Key2, int>() ;
+      sum += *extensions.template get<keys::Key3, int>() ;
+    }
+  }
+  auto end = std::chrono::steady_clock::now() ;
+  test.test( name + " lookups", sum == 6ul * NLookups * NEvents ) ;
+  const double elapsed = std::chrono::duration<double>( end - start ).count() ;
+  std::cout << name << ": " << NEvents << " events, " << 4*NLookups << " lookups per event in "
+            << elapsed << " s (" << (elapsed * 1e9 / NEvents) << " ns/event)" << std::endl ;
+  return elapsed ;
+}
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "ExtensionsBenchmark" ) ;
+
+  // basic semantics
+  Extensions extensions ;
+  extensions.add<keys::Key0>( new int(42) ) ;
+  test.test( "slot index stable", Extensions::slotIndex<keys::Key0>() == Extensions::slotIndex<keys::Key0>() ) ;
+  test.test( "slot index dense", Extensions::slotIndex<keys::Key1>() != Extensions::slotIndex<keys::Key0>() ) ;
+  test.test( "extension exists", extensions.exits<keys::Key0>() ) ;
+  test.test( "extension doesn't exist", not extensions.exits<keys::Key1>() ) ;
+  test.test( "extension value", *extensions.get<keys::Key0, int>() == 42 ) ;
+  try {
+    extensions.add<keys::Key0>( new int(43) ) ;
+    test.error( "extension added twice" ) ;
+  }
+  catch( Exception & ) {
+    test.pass( "extension can't be added twice" ) ;
+  }
+  extensions.remove<keys::Key0>() ;
+  test.test( "extension removed", not extensions.exits<keys::Key0>() and 0 == extensions.size() ) ;
+
+  const double mapTime = runLookups<MapExtensions>( test, "Map extensions" ) ;
+  const double slotTime = runLookups<Extensions>( test, "Slot extensions" ) ;
+  std::cout << "Slot extensions speedup: " << (mapTime / slotTime) << std::endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,73 @@
+#include <chrono>
+#include <random>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <cmath>
+
+#include <UnitTesting.h>
+
+#include "marlinmt/book/configs/ROOTv7.h"
+#include "marlinmt/book/Hist.h"
+
+using namespace marlinmt::book ;
+using namespace marlinmt::book::types ;
+
+constexpr unsigned int nPoints = 1000000 ;
+constexpr unsigned int nIterations = 100 ;
+constexpr std::pair<double, double> range(0, 1000) ;
+
+int main( int /*argc*/, char * /*argv*/[] ) {
+
+  marlinmt::test::UnitTest test( " Performance Test weighted FillN: " ) ;
+
+  AxisConfig<double> axis( "a", 250, range.first, range.second ) ;
+  H1F loopHist( "loop", axis ) ;
+  H1F bulkHist( "bulk", axis ) ;
+
+  std::vector< H1F::Point_t >  points( nPoints ) ;
+  std::vector< H1F::Weight_t > weights( nPoints ) ;
+  {
+    std::random_device rd ;
+    std::mt19937 e2( rd() ) ;
+    std::uniform_real_distribution<> dist( range.first, range.second ) ;
+    std::uniform_real_distribution<> wdist( 0.5, 1.5 ) ;
+    for ( unsigned int i = 0 ; i < nPoints ; ++i ) {
+      points[i] = H1F::Point_t{ dist( e2 ) } ;
+      weights[i] = static_cast< float >( wdist( e2 ) ) ;
+    }
+  }
+
+  std::chrono::duration<double> loopFill{} ;
+  std::chrono::duration<double> bulkFill{} ;
+  for ( unsigned int i = 0 ; i < nIterations ; ++i ) {
+    auto start = std::chrono::high_resolution_clock::now() ;
+    for ( unsigned int j = 0 ; j < nPoints ; ++j ) {
+      loopHist.Fill( points[j], weights[j] ) ;
+    }
+    auto end = std::chrono::high_resolution_clock::now() ;
+    loopFill += end - start ;
+
+    start = std::chrono::high_resolution_clock::now() ;
+    bulkHist.FillN( points.data(), points.data() + nPoints, weights.data(), weights.data() + nPoints ) ;
+    end = std::chrono::high_resolution_clock::now() ;
+    bulkFill += end - start ;
+  }
+
+  std::cout << "              \tLoop\t\tFillN\n"
+            << "Time to fill:\t" << loopFill.count() << "\t" << bulkFill.count() << "\n"
+            << "Points per second:\t" << ( nPoints * nIterations / loopFill.count() )
+            << "\t" << ( nPoints * nIterations / bulkFill.count() ) << "\n" ;
+
+  test.test( "same entries", loopHist.get().GetEntries() == bulkHist.get().GetEntries() ) ;
+  bool sameContent = true ;
+  for ( unsigned int i = 0 ; i < 250 ; ++i ) {
+    const H1F::Point_t x{ range.first + ( i + 0.5 ) * ( range.second - range.first ) / 250 } ;
+    const double loopContent = loopHist.get().GetBinContent( x ) ;
+    const double bulkContent = bulkHist.get().GetBinContent( x ) ;
+    sameContent = sameContent && std::abs( loopContent - bulkContent ) <= 1e-3 * std::abs( loopContent ) ;
+  }
+  test.test( "same bin contents", sameContent ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <UnitTesting.h>
+
+#include "marlinmt/book/configs/Native.h"
+
+#include "marlinmt/book/Handle.h"
+#include "marlinmt/book/BookStore.h"
+#include "marlinmt/book/Hist.h"
+
+using namespace marlinmt::book ;
+using namespace marlinmt::book::types ;
+
+constexpr unsigned int NumThreads = 4;
+// a large histogram ...
+constexpr std::size_t nBins = 500;
+// ... filled rarely: a few points per event
+constexpr unsigned int nEvents = 20000;
+constexpr unsigned int nFillsPerEvent = 5;
+constexpr std::pair<double, double> range(0, 100);
+
+struct LayoutResult {
+  double fill{0};
+  double merge{0};
+  std::size_t memory{0};
+  std::vector<double> content{};
+};
+
+/**
+ *  Fill one histogram booked with the given layout from NumThreads threads,
+ *  one handle() call per event, then merge it.
+ */
+template<typename EntryData_t>
+LayoutResult run(BookStore &store, const std::string &name, const EntryData_t &data,
+  std::size_t instances, const std::vector<H2D::Point_t> &points, const std::vector<H2D::Weight_t> &weights) {
+  Handle entry = store.book("/", name, data);
+  LayoutResult result;
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> threads;
+  for(unsigned int t = 0; t < NumThreads; ++t) {
+    threads.emplace_back([&, t](){
+      for(unsigned int event = t; event < nEvents; event += NumThreads) {
+        auto hnd = entry.handle();
+        for(unsigned int j = event * nFillsPerEvent; j < (event + 1) * nFillsPerEvent; ++j) {
+          hnd.fill(points[j], weights[j]);
+        }
+      }
+    });
+  }
+  for(auto &thread : threads) {
+    thread.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  result.fill = std::chrono::duration<double>(end - start).count();
+  start = std::chrono::high_resolution_clock::now();
+  const auto &hist = entry.merged().get();
+  end = std::chrono::high_resolution_clock::now();
+  result.merge = std::chrono::duration<double>(end - start).count();
+  result.content = hist.content();
+  // bin contents and sum of squared weights of each instance
+  result.memory = instances * hist.size() * sizeof(double) * (hist.hasSumw2() ? 2 : 1);
+  return result;
+}
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+  marlinmt::test::UnitTest test(" Histogram memory layouts: ");
+
+  std::vector<H2D::Point_t> points(nEvents * nFillsPerEvent);
+  std::vector<H2D::Weight_t> weights(points.size());
+  {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<> dist(range.first, range.second);
+    for(std::size_t i = 0; i < points.size(); ++i) {
+      points[i] = {dist(generator), dist(generator)};
+      weights[i] = (i % 2 == 0) ? 0.5 : 1.5;
+    }
+  }
+
+  BookStore store;
+  AxisConfig<double> axis("a", nBins, range.first, range.second);
+  // the entry data keeps a reference to the title
+  const std::string_view title("title");
+  EntryData<H2D> data(title, axis, axis);
+
+  try {
+    const auto copy = run(store, "copy", data.multiCopy(NumThreads), NumThreads, points, weights);
+    const auto shared = run(store, "shared", data.multiShared(NumThreads), 1, points, weights);
+    const auto atomic = run(store, "atomic", data.multiAtomic(), 1, points, weights);
+
+    std::cout << "            \tCopy\t\tShared\t\tAtomic\n"
+              << "Time to fill:\t" << copy.fill << "\t" << shared.fill << "\t" << atomic.fill << "\n"
+              << "Time to merge:\t" << copy.merge << "\t" << shared.merge << "\t" << atomic.merge << "\n"
+              << "Bin memory:\t" << copy.memory << "\t\t" << shared.memory << "\t\t" << atomic.memory << "\n";
+
+    test.test("shared layout fills as copies", shared.content == copy.content);
+    test.test("atomic layout fills as copies", atomic.content == copy.content);
+  } catch ( const exceptions::BookStoreException &e ) {
+    test.error( e.what() ) ;
+  }
+
+  return 0;
+}
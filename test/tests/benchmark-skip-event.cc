@@ -0,0 +1,136 @@
+// -- marlinmt headers
+#include <marlinmt/Sequence.h>
+#include <marlinmt/Processor.h>
+#include <marlinmt/ProcessorApi.h>
+#include <marlinmt/EventStore.h>
+#include <marlinmt/EventExtensions.h>
+#include <marlinmt/CompiledConditions.h>
+#include <marlinmt/RunContext.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <algorithm>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+constexpr unsigned int NEventsPerThread = 20000 ;
+constexpr unsigned int NProcessors = 10 ;
+// the first processor is a filter skipping 95% of the events
+constexpr unsigned int SkipModulo = 20 ;
+
+namespace {
+
+  /// Skips most of the events, either by throwing or by flagging the event
+  class FilterProcessor : public Processor {
+  public:
+    FilterProcessor( bool useFlag ) : Processor( "FilterProcessor" ), _useFlag(useFlag) {}
+    void processEvent( EventStore *event ) override {
+      if( 0 != event->uid() % SkipModulo ) {
+        if( _useFlag ) {
+          ProcessorApi::skipCurrentEvent( this, event ) ;
+        }
+        else {
+          ProcessorApi::skipCurrentEvent( this ) ;
+        }
+      }
+    }
+  private:
+    bool         _useFlag {true} ;
+  };
+
+  /// Counts the events it processes
+  class WorkProcessor : public Processor {
+  public:
+    WorkProcessor() : Processor( "WorkProcessor" ) {}
+    void processEvent( EventStore * ) override { _nEvents.fetch_add( 1, std::memory_order_relaxed ) ; }
+    std::atomic<unsigned int> _nEvents {0} ;
+  };
+
+  /// A sequence of processors starting with the filter, as run by a worker thread
+  std::unique_ptr<Sequence> createSequence( bool useFlag ) {
+    auto sequence = std::make_unique<Sequence>( std::make_shared<RunContext>() ) ;
+    auto filter = std::make_shared<FilterProcessor>( useFlag ) ;
+    filter->setName( "Filter" ) ;
+    // the throwing API logs each skip
+    filter->setVerbosity( "ERROR" ) ;
+    sequence->addItem( sequence->createItem( filter, nullptr ) ) ;
+    for( unsigned int index=1 ; index<NProcessors ; ++index ) {
+      auto processor = std::make_shared<WorkProcessor>() ;
+      processor->setName( "Work" + std::to_string( index ) ) ;
+      sequence->addItem( sequence->createItem( processor, nullptr ) ) ;
+    }
+    return sequence ;
+  }
+
+}
+
+double runThreads( UnitTest &test, const std::string &name, unsigned int nthreads, bool useFlag ) {
+  const auto conditions = std::make_shared<const CompiledConditions>( std::map<std::string, std::string>{} ) ;
+  std::vector<std::unique_ptr<Sequence>> sequences ;
+  for( unsigned int t=0 ; t<nthreads ; ++t ) {
+    sequences.push_back( createSequence( useFlag ) ) ;
+  }
+  std::atomic<unsigned int> nSkipped {0} ;
+  std::vector<std::thread> threads ;
+  auto start = std::chrono::steady_clock::now() ;
+  for( unsigned int t=0 ; t<nthreads ; ++t ) {
+    threads.emplace_back( [&,t](){
+      // one event store recycled for all the events, as with the event store pool
+      auto event = std::make_shared<EventStore>() ;
+      unsigned int skipped {0} ;
+      for( unsigned int e=0 ; e<NEventsPerThread ; ++e ) {
+        event->recycle() ;
+        event->setUID( e ) ;
+        event->extensions().recyclable<extensions::ProcessorConditions, ProcessorConditionsExtension>( conditions ) ;
+        if( not sequences[t]->processEvent( event ) ) {
+          ++ skipped ;
+        }
+      }
+      nSkipped += skipped ;
+    }) ;
+  }
+  for( auto &thread : threads ) {
+    thread.join() ;
+  }
+  auto end = std::chrono::steady_clock::now() ;
+  const unsigned int expectedSkipped = nthreads * ( NEventsPerThread - NEventsPerThread / SkipModulo ) ;
+  test.test( name + " skipped events", expectedSkipped == nSkipped.load() ) ;
+  std::size_t nCounted {0} ;
+  for( auto &sequence : sequences ) {
+    nCounted += sequence->statistics( 0 )._skipped ;
+  }
+  test.test( name + " skips counted for the filter", expectedSkipped == nCounted ) ;
+  const double elapsed = std::chrono::duration<double>( end - start ).count() ;
+  std::cout << name << ": " << nthreads << " threads, " << nthreads * NEventsPerThread << " events in "
+            << elapsed << " s (" << (elapsed * 1e9 / (nthreads * NEventsPerThread)) << " ns/event)" << std::endl ;
+  return elapsed ;
+}
+
+int main( int argc, char ** argv ) {
+
+  UnitTest test( "SkipEventBenchmark" ) ;
+
+  EventStore event ;
+  test.test( "not skipped by default", not event.skipped() ) ;
+  event.skip() ;
+  test.test( "skip flag set", event.skipped() ) ;
+  event.recycle() ;
+  test.test( "skip flag reset on recycle", not event.skipped() ) ;
+
+  // e.g: benchmark-skip-event 32
+  const unsigned int nthreads = ( argc > 1 ) ? static_cast<unsigned int>( std::stoul( argv[1] ) ) : std::max( 1u, std::thread::hardware_concurrency() ) ;
+  const double throwTime = runThreads( test, "Throwing skip", nthreads, false ) ;
+  const double flagTime = runThreads( test, "Flag skip", nthreads, true ) ;
+  std::cout << "Flag skip speedup: " << (throwTime / flagTime) << std::endl ;
+
+  return 0 ;
+}
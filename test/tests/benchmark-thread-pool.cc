@@ -0,0 +1,84 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/ThreadPool.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <chrono>
+#include <iostream>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using namespace marlinmt::concurrency ;
+
+using Function = std::function<void()> ;
+using MutexPool = ThreadPool<Function,void,Queue<QueueElement<Function,void>>> ;
+using RingPool = ThreadPool<Function,void,RingQueue<QueueElement<Function,void>>> ;
+
+constexpr unsigned int NTasks = 200000 ;
+constexpr unsigned int QueueSize = 64 ;
+
+class BenchmarkWorker : public WorkerBase<Function,void> {
+public:
+  void process( Function && f ) override {
+    f() ;
+  }
+};
+
+/**
+ *  Push many tiny tasks from the main thread into a pool with as many
+ *  workers as hardware threads, so that the task queue is heavily contended.
+ *  Returns the elapsed time in seconds
+ */
+template <typename POOL>
+double runContention( UnitTest &test, const std::string &name ) {
+  POOL pool ;
+  unsigned int nworkers = std::max( 1u, std::thread::hardware_concurrency() ) ;
+  for( unsigned int w=0 ; w<nworkers ; ++w ) {
+    pool.template addWorker<BenchmarkWorker>() ;
+  }
+  pool.setMaxQueueSize( QueueSize ) ;
+  pool.start() ;
+  std::atomic<unsigned int> counter {0} ;
+  auto start = std::chrono::steady_clock::now() ;
+  for( unsigned int i=0 ; i<NTasks ; ++i ) {
+    Function f = [&counter](){ counter.fetch_add( 1, std::memory_order_relaxed ) ; } ;
+    pool.post( POOL::PushPolicy::Blocking, std::move( f ) ) ;
+  }
+  pool.stop(false) ;
+  auto end = std::chrono::steady_clock::now() ;
+  test.test( name + " all tasks processed", counter.load() == NTasks ) ;
+  const double elapsed = std::chrono::duration<double>( end - start ).count() ;
+  std::cout << name << ": " << nworkers << " workers, " << NTasks << " tasks in "
+            << elapsed << " s (" << (NTasks / elapsed) << " tasks/s), "
+            << std::chrono::duration<double>( pool.pushWaitTime() ).count() << " s waiting in "
+            << pool.nPushWaits() << " blocked push" << std::endl ;
+  return elapsed ;
+}
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "ThreadPoolBenchmark" ) ;
+
+  // basic ring queue semantics
+  RingQueue<int> queue( 2 ) ;
+  int a = 1, b = 2, c = 3, out = 0 ;
+  test.test( "ring empty", queue.empty() ) ;
+  test.test( "ring push 1", queue.push( a ) ) ;
+  test.test( "ring push 2", queue.push( b ) ) ;
+  test.test( "ring full", queue.isFull() ) ;
+  test.test( "ring push full", not queue.push( c ) ) ;
+  test.test( "ring pop 1", queue.pop( out ) && (1 == out) ) ;
+  test.test( "ring free slots", queue.freeSlots() == 1 ) ;
+  test.test( "ring push 3", queue.push( c ) ) ;
+  test.test( "ring pop 2", queue.pop( out ) && (2 == out) ) ;
+  test.test( "ring pop 3", queue.pop( out ) && (3 == out) ) ;
+  test.test( "ring pop empty", not queue.pop( out ) ) ;
+  test.test( "ring set max size", queue.setMaxSize( 4 ) == 2 ) ;
+  test.test( "ring new max size", queue.maxSize() == 4 ) ;
+
+  const double mutexTime = runContention<MutexPool>( test, "Mutex queue" ) ;
+  const double ringTime = runContention<RingPool>( test, "Ring queue" ) ;
+  std::cout << "Ring queue speedup: " << (mutexTime / ringTime) << std::endl ;
+
+  return 0 ;
+}
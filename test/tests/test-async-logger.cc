@@ -0,0 +1,129 @@
+// -- marlinmt headers
+#include <marlinmt/AsyncLogger.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+constexpr unsigned int NThreads = 4 ;
+constexpr unsigned int NLinesPerThread = 5000 ;
+
+std::vector<std::string> splitLines( const std::string &str ) {
+  std::vector<std::string> lines ;
+  std::istringstream in( str ) ;
+  std::string line ;
+  while( std::getline( in, line ) ) {
+    lines.push_back( line ) ;
+  }
+  return lines ;
+}
+
+int main() {
+
+  UnitTest test( "AsyncLogger" ) ;
+
+  test.test( "level rank: DEBUG < MESSAGE", AsyncLogger::levelRank("DEBUG") < AsyncLogger::levelRank("MESSAGE") ) ;
+  test.test( "level rank: MESSAGE < MESSAGE5", AsyncLogger::levelRank("MESSAGE") < AsyncLogger::levelRank("MESSAGE5") ) ;
+  test.test( "level rank: MESSAGE9 < WARNING", AsyncLogger::levelRank("MESSAGE9") < AsyncLogger::levelRank("WARNING") ) ;
+  test.test( "level rank: ERROR < SILENT", AsyncLogger::levelRank("ERROR") < AsyncLogger::levelRank("SILENT") ) ;
+
+  // line mode, small rings to exercise the full ring waits
+  std::ostringstream lineOutput ;
+  {
+    AsyncLogger logger( lineOutput, AsyncLogger::FlushMode::Line, 16, 1 ) ;
+    auto channel = logger.channel( "Test" ) ;
+    test.test( "channel: MESSAGE enabled", channel.enabled( "MESSAGE" ) ) ;
+    test.test( "channel: DEBUG disabled", not channel.enabled( "DEBUG" ) ) ;
+    channel.log( "DEBUG", "not written" ) ;
+    std::vector<std::thread> threads ;
+    for( unsigned int t=0 ; t<NThreads ; ++t ) {
+      threads.emplace_back( [&,t](){
+        for( unsigned int l=0 ; l<NLinesPerThread ; ++l ) {
+          channel.log( "MESSAGE", "thread ", t, " line ", l, std::string( " (captured copy)" ) ) ;
+        }
+      }) ;
+    }
+    for( auto &thread : threads ) {
+      thread.join() ;
+    }
+    logger.stop() ;
+    test.test( "line mode: number of lines", NThreads * NLinesPerThread == logger.nLines() ) ;
+  }
+  auto lines = splitLines( lineOutput.str() ) ;
+  test.test( "line mode: number of output lines", NThreads * NLinesPerThread == lines.size() ) ;
+  test.test( "line mode: line format", not lines.empty() and 0 == lines.front().find( "[ MESSAGE \"Test\"] thread " ) ) ;
+  test.test( "line mode: debug line dropped", std::string::npos == lineOutput.str().find( "not written" ) ) ;
+  // the lines of each thread are in order
+  bool ordered {true} ;
+  for( unsigned int t=0 ; t<NThreads ; ++t ) {
+    const std::string prefix = "[ MESSAGE \"Test\"] thread " + std::to_string(t) + " line " ;
+    unsigned int expected {0} ;
+    for( auto &line : lines ) {
+      if( 0 == line.find( prefix ) ) {
+        ordered = ordered and ( prefix + std::to_string(expected) + " (captured copy)" == line ) ;
+        ++ expected ;
+      }
+    }
+    ordered = ordered and ( NLinesPerThread == expected ) ;
+  }
+  test.test( "line mode: lines of each thread in order", ordered ) ;
+
+  // event mode: the lines of an event are written together
+  std::ostringstream eventOutput ;
+  {
+    AsyncLogger logger( eventOutput, AsyncLogger::FlushMode::Event ) ;
+    auto channel = logger.channel( "Event" ) ;
+    std::thread other( [&](){
+      AsyncLogger::setCurrentEvent( 2 ) ;
+      channel.log( "MESSAGE", "event 2 first" ) ;
+      channel.log( "MESSAGE", "event 2 second" ) ;
+      AsyncLogger::setCurrentEvent( 0 ) ;
+    }) ;
+    AsyncLogger::setCurrentEvent( 1 ) ;
+    channel.log( "MESSAGE", "event 1 first" ) ;
+    other.join() ;
+    channel.log( "MESSAGE", "event 1 second" ) ;
+    AsyncLogger::setCurrentEvent( 0 ) ;
+    logger.flushEvent( 2 ) ;
+    logger.flushEvent( 1 ) ;
+    logger.stop() ;
+  }
+  auto eventLines = splitLines( eventOutput.str() ) ;
+  test.test( "event mode: number of lines", 4 == eventLines.size() ) ;
+  if( 4 == eventLines.size() ) {
+    test.test( "event mode: event 2 first", std::string::npos != eventLines[0].find( "event 2 first" ) ) ;
+    test.test( "event mode: event 2 second", std::string::npos != eventLines[1].find( "event 2 second" ) ) ;
+    test.test( "event mode: event 1 first", std::string::npos != eventLines[2].find( "event 1 first" ) ) ;
+    test.test( "event mode: event 1 second", std::string::npos != eventLines[3].find( "event 1 second" ) ) ;
+  }
+
+  // character strings not owned by the caller are copied in the record
+  std::ostringstream tempOutput ;
+  {
+    AsyncLogger logger( tempOutput, AsyncLogger::FlushMode::Line, 16, 1000 ) ;
+    auto channel = logger.channel( "Temp" ) ;
+    std::string buffer( "temporary view" ) ;
+    channel.log( "MESSAGE", std::string( "temporary pointer" ).c_str(), " ", std::string_view( buffer ) ) ;
+    buffer.assign( buffer.size(), 'x' ) ;
+    logger.stop() ;
+  }
+  test.test( "temporary strings captured", std::string::npos != tempOutput.str().find( "temporary pointer temporary view" ) ) ;
+
+  try {
+    AsyncLogger::flushModeFromString( "unknown" ) ;
+    test.error( "flush mode: unknown mode didn't throw" ) ;
+  }
+  catch( ... ) {
+    test.pass( "flush mode: unknown mode throws" ) ;
+  }
+
+  return 0 ;
+}
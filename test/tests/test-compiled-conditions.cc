@@ -0,0 +1,95 @@
+// -- marlinmt headers
+#include <marlinmt/CompiledConditions.h>
+#include <marlinmt/LogicalExpressions.h>
+#include <marlinmt/Exceptions.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <vector>
+#include <string>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "CompiledConditions" ) ;
+
+  CompiledConditions::ConditionsMap conds {
+    { "P0", "" },
+    { "P1", "A" },
+    { "P2", "!A" },
+    { "P3", "A && B" },
+    { "P4", "A || B && C" },
+    { "P5", "( A && ( B || !C ) ) || ( !B && C )" },
+    { "P6", "!( A || B ) && true" },
+    { "P7", "A.sub || false" },
+    { "P8", "True && !False" }
+  } ;
+  const std::vector<std::string> names { "A", "B", "C", "A.sub" } ;
+
+  CompiledConditions compiled( conds ) ;
+  test.test( "number of conditions", compiled.nConditions() == conds.size() ) ;
+  test.test( "number of values", compiled.nValues() == names.size() ) ;
+  test.test( "unknown condition", compiled.conditionIndex( "Unknown" ) == CompiledConditions::npos ) ;
+  test.test( "unused value", compiled.valueIndex( "D" ) == CompiledConditions::npos ) ;
+
+  // same results as LogicalExpressions for all value combinations
+  CompiledConditions::Values values( compiled.nValues() ) ;
+  bool allEqual {true} ;
+  for( unsigned int bits=0 ; bits < (1u << names.size()) ; ++bits ) {
+    LogicalExpressions expressions ;
+    for( auto &cond : conds ) {
+      expressions.addCondition( cond.first, cond.second ) ;
+    }
+    values.clear() ;
+    for( unsigned int i=0 ; i<names.size() ; ++i ) {
+      const bool value = (bits >> i) & 1 ;
+      expressions.setValue( names[i], value ) ;
+      values.set( compiled.valueIndex( names[i] ), value ) ;
+    }
+    for( auto &cond : conds ) {
+      const bool expected = expressions.conditionIsTrue( cond.first ) ;
+      const bool result = compiled.evaluate( compiled.conditionIndex( cond.first ), values ) ;
+      if( expected != result ) {
+        test.error( "condition " + cond.first + " differs for values " + std::to_string(bits) ) ;
+        allEqual = false ;
+      }
+    }
+  }
+  test.test( "same results as LogicalExpressions", allEqual ) ;
+  test.test( "no condition is true", compiled.evaluate( CompiledConditions::npos, values ) ) ;
+
+  // reading an unset value throws
+  values.clear() ;
+  try {
+    compiled.evaluate( compiled.conditionIndex( "P3" ), values ) ;
+    test.error( "unset value didn't throw" ) ;
+  }
+  catch( ParseException & ) {
+    test.pass( "unset value throws" ) ;
+  }
+
+  // known false conditions, used for early release of events
+  test.test( "unset value not known false", not compiled.isFalse( compiled.conditionIndex( "P3" ), values ) ) ;
+  test.test( "no condition never false", not compiled.isFalse( CompiledConditions::npos, values ) ) ;
+  values.set( compiled.valueIndex( "A" ), false ) ;
+  test.test( "partially set condition not known false", not compiled.isFalse( compiled.conditionIndex( "P3" ), values ) ) ;
+  test.test( "false condition", compiled.isFalse( compiled.conditionIndex( "P1" ), values ) ) ;
+  test.test( "true condition not false", not compiled.isFalse( compiled.conditionIndex( "P2" ), values ) ) ;
+  values.set( compiled.valueIndex( "B" ), true ) ;
+  test.test( "set condition known false", compiled.isFalse( compiled.conditionIndex( "P3" ), values ) ) ;
+
+  // the value slots of a processor, resolved once
+  CompiledConditions::ValueSlots slots ;
+  slots.resolve( compiled, "A" ) ;
+  test.test( "processor value slot", compiled.valueIndex( "A" ) == slots.index() ) ;
+  test.test( "named value slot", compiled.valueIndex( "A.sub" ) == slots.index( "sub" ) ) ;
+  test.test( "unused named value", CompiledConditions::npos == slots.index( "other" ) ) ;
+  CompiledConditions other( CompiledConditions::ConditionsMap{ { "P0", "Ax.sub && A.other" } } ) ;
+  slots.resolve( other, "A" ) ;
+  test.test( "resolved for new conditions", CompiledConditions::npos == slots.index() and CompiledConditions::npos == slots.index( "sub" ) ) ;
+  test.test( "named value of new conditions", other.valueIndex( "A.other" ) == slots.index( "other" ) ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,200 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/DAGScheduler.h>
+#include <marlinmt/Sequence.h>
+#include <marlinmt/Processor.h>
+#include <marlinmt/ProcessorApi.h>
+#include <marlinmt/EventStore.h>
+#include <marlinmt/EventExtensions.h>
+#include <marlinmt/CompiledConditions.h>
+#include <marlinmt/RunContext.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using marlinmt::concurrency::DAGScheduler ;
+
+namespace {
+
+  using Declaration = DAGScheduler::ProcessorDeclaration ;
+  using Successors = std::vector<std::vector<DAGScheduler::Index>> ;
+
+  Declaration declaration( std::set<std::string> inputs, std::set<std::string> outputs, bool canSkipEvents ) {
+    Declaration decl ;
+    decl._inputs = std::move( inputs ) ;
+    decl._outputs = std::move( outputs ) ;
+    decl._canSkipEvents = canSkipEvents ;
+    return decl ;
+  }
+
+  bool hasEdge( const Successors &successors, std::size_t from, std::size_t to ) {
+    const auto &succ = successors[from] ;
+    return ( succ.end() != std::find( succ.begin(), succ.end(), to ) ) ;
+  }
+
+  /// Reads a collection and skips the events with an even unique id
+  class FilterProcessor : public Processor {
+  public:
+    FilterProcessor() : Processor( "FilterProcessor" ) {}
+    void processEvent( EventStore *event ) override {
+      if( 0 == event->uid() % 2 ) {
+        ProcessorApi::skipCurrentEvent( this, event ) ;
+      }
+    }
+  };
+
+  /// Reads a collection and counts the events it processes
+  class ReaderProcessor : public Processor {
+  public:
+    ReaderProcessor() : Processor( "ReaderProcessor" ) {}
+    void processEvent( EventStore *event ) override {
+      ++ _nEvents ;
+      if( 0 == event->uid() % 2 ) {
+        ++ _nSkippedSeen ;
+      }
+    }
+    std::atomic<unsigned int> _nEvents {0} ;
+    std::atomic<unsigned int> _nSkippedSeen {0} ;
+  };
+
+  /// Run the processors of an event following the graph: the ready processors run concurrently
+  void runGraph( Sequence &sequence, const Successors &successors, const std::shared_ptr<EventStore> &event ) {
+    const auto nprocs = successors.size() ;
+    std::vector<unsigned int> nPending( nprocs, 0 ) ;
+    for( auto &succ : successors ) {
+      for( auto s : succ ) {
+        ++ nPending[s] ;
+      }
+    }
+    std::vector<bool> done( nprocs, false ) ;
+    bool skipped {false} ;
+    while( std::find( done.begin(), done.end(), false ) != done.end() ) {
+      std::vector<std::size_t> ready ;
+      for( std::size_t i=0 ; i<nprocs ; ++i ) {
+        if( not done[i] and 0 == nPending[i] ) {
+          ready.push_back( i ) ;
+        }
+      }
+      std::vector<std::thread> threads ;
+      std::vector<char> results( ready.size(), 1 ) ;
+      for( std::size_t r=0 ; r<ready.size() ; ++r ) {
+        threads.emplace_back( [&,r](){
+          if( not skipped ) {
+            results[r] = sequence.processEvent( event, ready[r] ) ? 1 : 0 ;
+          }
+        }) ;
+      }
+      for( auto &thread : threads ) {
+        thread.join() ;
+      }
+      for( std::size_t r=0 ; r<ready.size() ; ++r ) {
+        skipped = skipped or ( 0 == results[r] ) ;
+        done[ready[r]] = true ;
+        for( auto s : successors[ready[r]] ) {
+          -- nPending[s] ;
+        }
+      }
+    }
+  }
+
+}
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "DAG graph" ) ;
+
+  // graph edges
+  {
+    // a filter and two readers of the same collection
+    auto successors = DAGScheduler::dependencies( {
+      declaration( {"A"}, {}, true ),
+      declaration( {"A"}, {}, false ),
+      declaration( {"A"}, {}, false )
+    } ) ;
+    test.test( "filter before first reader", hasEdge( successors, 0, 1 ) ) ;
+    test.test( "filter before second reader", hasEdge( successors, 0, 2 ) ) ;
+    test.test( "readers run concurrently", not hasEdge( successors, 1, 2 ) ) ;
+  }
+  {
+    // without skipping processor, only the data dependencies remain
+    auto successors = DAGScheduler::dependencies( {
+      declaration( {}, {"B"}, false ),
+      declaration( {"B"}, {"C"}, false ),
+      declaration( {"A"}, {}, false ),
+      declaration( {"C"}, {}, false )
+    } ) ;
+    test.test( "writer before reader", hasEdge( successors, 0, 1 ) ) ;
+    test.test( "transitive writer before reader", hasEdge( successors, 1, 3 ) ) ;
+    test.test( "independent processor", not hasEdge( successors, 0, 2 ) and not hasEdge( successors, 1, 2 ) and not hasEdge( successors, 2, 3 ) ) ;
+  }
+  {
+    // undeclared processors and conditions are barriers
+    Declaration undeclared ;
+    undeclared._canSkipEvents = false ;
+    auto conditional = declaration( {"A"}, {}, false ) ;
+    conditional._conditional = true ;
+    auto successors = DAGScheduler::dependencies( {
+      declaration( {"A"}, {}, false ),
+      undeclared,
+      declaration( {"A"}, {}, false ),
+      conditional
+    } ) ;
+    test.test( "undeclared depends on previous", hasEdge( successors, 0, 1 ) ) ;
+    test.test( "next depends on undeclared", hasEdge( successors, 1, 2 ) ) ;
+    test.test( "conditional depends on all previous", hasEdge( successors, 0, 3 ) and hasEdge( successors, 1, 3 ) and hasEdge( successors, 2, 3 ) ) ;
+  }
+  {
+    // processors declared in the code: may skip events by default
+    auto reader = std::make_shared<ReaderProcessor>() ;
+    test.test( "processors may skip by default", reader->canSkipEvents() ) ;
+    ProcessorApi::declareNoEventSkip( reader.get() ) ;
+    test.test( "declared as not skipping", not reader->canSkipEvents() ) ;
+  }
+
+  // skip behaviour: the readers only see the events kept by the filter
+  {
+    constexpr unsigned int nEvents = 20 ;
+    const auto conditions = std::make_shared<const CompiledConditions>( std::map<std::string, std::string>{} ) ;
+    Sequence sequence( std::make_shared<RunContext>() ) ;
+    auto filter = std::make_shared<FilterProcessor>() ;
+    filter->setName( "Filter" ) ;
+    ProcessorApi::declareInputCollection( filter.get(), "A" ) ;
+    std::vector<std::shared_ptr<ReaderProcessor>> readers ;
+    sequence.addItem( sequence.createItem( filter, nullptr ) ) ;
+    for( auto name : { "Reader1", "Reader2" } ) {
+      auto reader = std::make_shared<ReaderProcessor>() ;
+      reader->setName( name ) ;
+      ProcessorApi::declareInputCollection( reader.get(), "A" ) ;
+      ProcessorApi::declareNoEventSkip( reader.get() ) ;
+      sequence.addItem( sequence.createItem( reader, nullptr ) ) ;
+      readers.push_back( reader ) ;
+    }
+    std::vector<Declaration> declarations ;
+    for( std::size_t i=0 ; i<sequence.size() ; ++i ) {
+      auto processor = sequence.at(i)->processor() ;
+      declarations.push_back( declaration( processor->inputCollections(), processor->outputCollections(), processor->canSkipEvents() ) ) ;
+    }
+    const auto successors = DAGScheduler::dependencies( declarations ) ;
+    for( unsigned int e=0 ; e<nEvents ; ++e ) {
+      auto event = std::make_shared<EventStore>() ;
+      event->setUID( e ) ;
+      event->extensions().recyclable<extensions::ProcessorConditions, ProcessorConditionsExtension>( conditions ) ;
+      runGraph( sequence, successors, event ) ;
+    }
+    for( auto &reader : readers ) {
+      test.test( reader->name() + ": kept events processed", nEvents / 2 == reader->_nEvents ) ;
+      test.test( reader->name() + ": skipped events not seen", 0 == reader->_nSkippedSeen ) ;
+    }
+    test.test( "skips counted for the filter", nEvents / 2 == sequence.statistics( 0 )._skipped ) ;
+  }
+
+  return 0 ;
+}
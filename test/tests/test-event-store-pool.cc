@@ -0,0 +1,140 @@
+// -- marlinmt headers
+#include <marlinmt/EventStorePool.h>
+#include <marlinmt/EventStore.h>
+#include <marlinmt/EventExtensions.h>
+#include <UnitTesting.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <vector>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+namespace {
+
+  struct RecyclableKey {} ;
+  struct OtherKey {} ;
+
+  struct RecyclableObject {
+    RecyclableObject( int value ) : _value(value) {}
+    void reset( int value ) { _value = value ; ++ _nResets ; }
+    int _value {0} ;
+    int _nResets {0} ;
+  };
+
+  std::atomic<std::size_t> nAllocations {0} ;
+
+}
+
+// count the heap allocations to measure the allocation rate per event
+void *operator new( std::size_t size ) {
+  ++ nAllocations ;
+  if( void *ptr = std::malloc( size == 0 ? 1 : size ) ) {
+    return ptr ;
+  }
+  throw std::bad_alloc() ;
+}
+
+void operator delete( void *ptr ) noexcept {
+  std::free( ptr ) ;
+}
+
+void operator delete( void *ptr, std::size_t /*size*/ ) noexcept {
+  std::free( ptr ) ;
+}
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "EventStorePool" ) ;
+
+  // recyclable extensions are reset in place
+  {
+    Extensions extensions ;
+    auto obj = extensions.recyclable<RecyclableKey, RecyclableObject>( 1 ) ;
+    extensions.add<OtherKey>( new int(42) ) ;
+    test.test( "two extensions", extensions.size() == 2 ) ;
+    extensions.recycle() ;
+    test.test( "recyclable extension kept", extensions.size() == 1 ) ;
+    test.test( "other extension removed", not extensions.exits<OtherKey>() ) ;
+    auto obj2 = extensions.recyclable<RecyclableKey, RecyclableObject>( 2 ) ;
+    test.test( "same extension object", obj == obj2 ) ;
+    test.test( "extension reset", obj2->_value == 2 and obj2->_nResets == 1 ) ;
+    extensions.clear() ;
+    test.test( "extensions cleared", extensions.size() == 0 ) ;
+  }
+
+  // released stores are recycled
+  {
+    EventStorePool pool( 2 ) ;
+    auto store = pool.acquire() ;
+    store->setUID( 12 ) ;
+    store->allocate<int>( 3 ) ;
+    store->extensions().recyclable<RecyclableKey, RecyclableObject>( 1 ) ;
+    store->extensions().add<OtherKey>( new int(42) ) ;
+    auto storePtr = store.get() ;
+    pool.release( std::move(store) ) ;
+    test.test( "store in pool", pool.size() == 1 ) ;
+    auto store2 = pool.acquire() ;
+    test.test( "same store", store2.get() == storePtr ) ;
+    test.test( "uid reset", store2->uid() == 0 ) ;
+    test.test( "event reset", nullptr == store2->event<int>() ) ;
+    test.test( "recyclable extension kept", store2->extensions().exits<RecyclableKey>() ) ;
+    test.test( "other extension removed", not store2->extensions().exits<OtherKey>() ) ;
+    test.test( "allocated once", pool.nAllocated() == 1 ) ;
+    test.test( "recycled once", pool.nRecycled() == 1 ) ;
+  }
+
+  // shared stores are not recycled and the pool size is bounded
+  {
+    EventStorePool pool( 2 ) ;
+    auto store = pool.acquire() ;
+    auto copy = store ;
+    pool.release( std::move(store) ) ;
+    test.test( "shared store not recycled", pool.size() == 0 ) ;
+    std::vector<std::shared_ptr<EventStore>> stores {} ;
+    for( unsigned int i=0 ; i<4 ; ++i ) {
+      stores.push_back( pool.acquire() ) ;
+    }
+    for( auto &s : stores ) {
+      pool.release( std::move(s) ) ;
+    }
+    test.test( "pool size bounded", pool.size() == 2 ) ;
+  }
+
+  // allocations per event, as in Application::onEventRead()
+  // and Application::prepareEvent(), without and with the pool
+  {
+    constexpr std::size_t nEvents = 1000 ;
+    const std::map<std::string, std::string> conds { { "P1", "A && B" } } ;
+    const auto compiled = std::make_shared<const CompiledConditions>( conds ) ;
+    std::size_t before = nAllocations ;
+    for( std::size_t i=0 ; i<nEvents ; ++i ) {
+      auto store = std::make_shared<EventStore>() ;
+      store->extensions().create<extensions::RandomSeed, RandomSeedExtension>( true, i ) ;
+      store->extensions().create<extensions::ProcessorConditions, ProcessorConditionsExtension>( true, compiled ) ;
+    }
+    const double allocNoPool = static_cast<double>( nAllocations - before ) / nEvents ;
+    EventStorePool pool ;
+    auto warmup = pool.acquire() ;
+    warmup->extensions().recyclable<extensions::RandomSeed, RandomSeedExtension>( 0 ) ;
+    warmup->extensions().recyclable<extensions::ProcessorConditions, ProcessorConditionsExtension>( compiled ) ;
+    pool.release( std::move(warmup) ) ;
+    before = nAllocations ;
+    for( std::size_t i=0 ; i<nEvents ; ++i ) {
+      auto store = pool.acquire() ;
+      store->extensions().recyclable<extensions::RandomSeed, RandomSeedExtension>( i ) ;
+      store->extensions().recyclable<extensions::ProcessorConditions, ProcessorConditionsExtension>( compiled ) ;
+      pool.release( std::move(store) ) ;
+    }
+    const double allocPool = static_cast<double>( nAllocations - before ) / nEvents ;
+    std::cout << "Allocations per event: " << allocNoPool << " without pool, " << allocPool << " with pool" << std::endl ;
+    test.test( "allocations without pool", allocNoPool > 0. ) ;
+    test.test( "no allocation with warm pool", allocPool == 0. ) ;
+  }
+
+  return 0 ;
+}
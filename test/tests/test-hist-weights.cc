@@ -0,0 +1,114 @@
+#include <UnitTesting.h>
+
+#include <vector>
+#include <cmath>
+#include <random>
+
+#include "marlinmt/book/configs/ROOTv7.h"
+#include "marlinmt/book/BookStore.h"
+#include "marlinmt/book/Handle.h"
+#include "marlinmt/book/Hist.h"
+
+using namespace marlinmt::book ;
+using namespace marlinmt::book::types ;
+
+int main( int /*argc*/, char * /*argv*/[] ) {
+
+  marlinmt::test::UnitTest test( " Histogram weights " ) ;
+  constexpr std::size_t  bins         = 4 ;
+  constexpr float        min          = 0.F ;
+  constexpr float        max          = 4.F ;
+  AxisConfig<double>     axis( "a", bins, min, max ) ;
+  BookStore              store{} ;
+
+  // one point per bin, with weight (bin + 1) * 0.5
+  std::vector< H1F::Point_t >  xs ;
+  std::vector< H1F::Weight_t > ws ;
+  for ( std::size_t i = 0 ; i < bins ; ++i ) {
+    xs.push_back( H1F::Point_t{ static_cast<double>( i ) + 0.5 } ) ;
+    ws.push_back( static_cast<float>( i + 1 ) * 0.5F ) ;
+  }
+
+  try {
+    {
+      Handle entry = store.book( "/", "fill", EntryData< H1F >( axis ).single() ) ;
+      Handle< H1F > hnd = entry.handle() ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        hnd.fill( xs[i], ws[i] ) ;
+      }
+      const auto &hist = hnd.merged().get() ;
+      bool correct = true ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        correct = correct && std::fabs( hist.GetBinContent( xs[i] ) - ws[i] ) < 1e-6 ;
+      }
+      test.test( "Fill honours the weight", correct ) ;
+      test.test( "Fill entries", hist.GetEntries() == static_cast<int64_t>( bins ) ) ;
+    }
+    {
+      Handle entry = store.book( "/", "fillN", EntryData< H1F >( axis ).single() ) ;
+      Handle< H1F > hnd = entry.handle() ;
+      hnd.fillN( xs, ws ) ;
+      hnd.fillN( xs, ws ) ;
+      const auto &hist = hnd.merged().get() ;
+      bool correct = true ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        correct = correct && std::fabs( hist.GetBinContent( xs[i] ) - 2 * ws[i] ) < 1e-6 ;
+      }
+      test.test( "FillN honours the weights", correct ) ;
+      test.test( "FillN entries", hist.GetEntries() == static_cast<int64_t>( 2 * bins ) ) ;
+    }
+    {
+      Handle entry = store.book( "/", "fillNShort", EntryData< H1F >( axis ).single() ) ;
+      Handle< H1F > hnd = entry.handle() ;
+      std::vector< H1F::Weight_t > fewWeights( ws.begin(), ws.begin() + 2 ) ;
+      hnd.fillN( xs, fewWeights ) ;
+      test.test( "FillN ignores the points without weight",
+        hnd.merged().get().GetEntries() == 2 ) ;
+    }
+    {
+      Handle entry = store.book( "/", "fillND", EntryData< H1D >( axis ).multiCopy( 2 ) ) ;
+      Handle< H1D > hnd = entry.handle() ;
+      std::vector< H1D::Weight_t > wsD( ws.begin(), ws.end() ) ;
+      hnd.fillN( xs, wsD ) ;
+      const auto &hist = entry.merged().get() ;
+      bool correct = true ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        correct = correct && std::fabs( hist.GetBinContent( xs[i] ) - wsD[i] ) < 1e-12 ;
+      }
+      test.test( "Multi copy FillN honours the weights", correct ) ;
+    }
+    {
+      // weighted FillN gives the same bins and sums of squared weights as a Fill loop
+      std::mt19937 generator( 42 ) ;
+      std::uniform_real_distribution<double> pdist( min - 1., max + 1. ) ;
+      std::uniform_real_distribution<float> wdist( 0.5F, 1.5F ) ;
+      std::vector< H1F::Point_t >  points( 1000 ) ;
+      std::vector< H1F::Weight_t > weights( points.size() ) ;
+      for ( std::size_t i = 0 ; i < points.size() ; ++i ) {
+        points[i] = H1F::Point_t{ pdist( generator ) } ;
+        weights[i] = wdist( generator ) ;
+      }
+      H1F loop( "loop", axis ) ;
+      H1F bulk( "bulk", axis ) ;
+      for ( std::size_t i = 0 ; i < points.size() ; ++i ) {
+        loop.Fill( points[i], weights[i] ) ;
+      }
+      bulk.FillN( points.data(), points.data() + points.size(), weights.data(), weights.data() + weights.size() ) ;
+      const auto &loopStat = loop.get().GetImpl()->GetStat() ;
+      const auto &bulkStat = bulk.get().GetImpl()->GetStat() ;
+      bool sameContent = loopStat.size() == bulkStat.size() ;
+      bool sameSumw2 = sameContent && loopStat.HasBinUncertainty() && bulkStat.HasBinUncertainty() ;
+      for ( std::size_t bin = 0 ; sameContent && bin < loopStat.size() ; ++bin ) {
+        sameContent = sameContent && std::fabs( loopStat.GetBinContent( bin ) - bulkStat.GetBinContent( bin ) ) < 1e-6 ;
+        sameSumw2 = sameSumw2 && std::fabs( loopStat.GetBinUncertainty( bin ) - bulkStat.GetBinUncertainty( bin ) ) < 1e-6 ;
+      }
+      test.test( "FillN and Fill loop entries", loopStat.GetEntries() == bulkStat.GetEntries() ) ;
+      test.test( "FillN and Fill loop bin contents", sameContent ) ;
+      test.test( "FillN and Fill loop sumw2", sameSumw2 ) ;
+    }
+  } catch ( const exceptions::BookStoreException &e ) {
+    test.error( e.what() ) ;
+  }
+
+  return 0 ;
+}
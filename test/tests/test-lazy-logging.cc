@@ -0,0 +1,60 @@
+// -- marlinmt headers
+#include <marlinmt/Component.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <iostream>
+#include <string_view>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+static_assert( loglevel::rank<DEBUG>::value < loglevel::rank<DEBUG9>::value, "DEBUG < DEBUG9" ) ;
+static_assert( loglevel::rank<DEBUG9>::value < loglevel::rank<MESSAGE>::value, "DEBUG9 < MESSAGE" ) ;
+static_assert( loglevel::rank<MESSAGE9>::value < loglevel::rank<WARNING>::value, "MESSAGE9 < WARNING" ) ;
+static_assert( loglevel::rank<WARNING9>::value < loglevel::rank<ERROR>::value, "WARNING9 < ERROR" ) ;
+static_assert( loglevel::rank<ERROR9>::value < loglevel::rank<SILENT>::value, "ERROR9 < SILENT" ) ;
+static_assert( loglevel::compiled<ERROR>, "ERROR is always compiled in" ) ;
+static_assert( std::string_view( "MESSAGE5" ) == loglevel::rank<MESSAGE5>::name, "MESSAGE5 name" ) ;
+
+int main() {
+
+  UnitTest test( "LazyLogging" ) ;
+
+  Component component( "Test" ) ;
+  unsigned int nEvaluated {0} ;
+  auto count = [&](){ ++ nEvaluated ; return nEvaluated ; } ;
+
+  component.setVerbosity( "WARNING" ) ;
+  test.test( "WARNING: MESSAGE not logged", not component.isLogged<MESSAGE>() ) ;
+  test.test( "WARNING: WARNING logged", component.isLogged<WARNING>() ) ;
+  test.test( "WARNING: ERROR logged", component.isLogged<ERROR>() ) ;
+
+  MARLINMT_LOG( component, MESSAGE ) << "Not written: " << count() << std::endl ;
+  test.test( "disabled level: operands not evaluated", 0 == nEvaluated ) ;
+  component.logLazy<DEBUG>( [&]( auto &out ){ out << "Not written: " << count() << std::endl ; } ) ;
+  test.test( "disabled level: lazy function not called", 0 == nEvaluated ) ;
+  MARLINMT_LOG_LINE( component, MESSAGE, "Not written: ", count() ) ;
+  test.test( "disabled level: line arguments not evaluated", 0 == nEvaluated ) ;
+
+  MARLINMT_LOG( component, ERROR ) << "Written: " << count() << std::endl ;
+  test.test( "enabled level: operands evaluated", 1 == nEvaluated ) ;
+  component.logLazy<ERROR>( [&]( auto &out ){ out << "Written: " << count() << std::endl ; } ) ;
+  test.test( "enabled level: lazy function called", 2 == nEvaluated ) ;
+  MARLINMT_LOG_LINE( component, ERROR, "Written: ", count() ) ;
+  test.test( "enabled level: line arguments evaluated", 3 == nEvaluated ) ;
+
+  // no dangling else
+  bool elseBranch {false} ;
+  if( false )
+    MARLINMT_LOG( component, ERROR ) << "Not written" << std::endl ;
+  else
+    elseBranch = true ;
+  test.test( "macro in if statement", elseBranch ) ;
+
+  component.setVerbosity( "DEBUG" ) ;
+  test.test( "DEBUG: DEBUG logged if compiled in", loglevel::compiled<DEBUG> == component.isLogged<DEBUG>() ) ;
+  test.test( "DEBUG: MESSAGE logged if compiled in", loglevel::compiled<MESSAGE> == component.isLogged<MESSAGE>() ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,187 @@
+#include <UnitTesting.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "marlinmt/book/configs/Native.h"
+#include "marlinmt/book/BookStore.h"
+#include "marlinmt/book/Handle.h"
+#include "marlinmt/book/Hist.h"
+
+using namespace marlinmt::book ;
+using namespace marlinmt::book::types ;
+
+int main( int /*argc*/, char * /*argv*/[] ) {
+
+  marlinmt::test::UnitTest test( " Native histograms " ) ;
+  constexpr std::size_t  bins         = 10 ;
+  constexpr double       min          = -5. ;
+  constexpr double       max          = 5. ;
+  AxisConfig<double>     axis( "a", bins, min, max ) ;
+
+  std::cout << "SIMD bin finding: " << ( native::simdBinning() ? "yes" : "no" ) << std::endl ;
+
+  try {
+    {
+      native::Axis<double> nativeAxis( axis ) ;
+      test.test( "underflow bin", nativeAxis.bin( -5.5 ) == 0 ) ;
+      test.test( "first bin", nativeAxis.bin( -5. ) == 1 ) ;
+      test.test( "last bin", nativeAxis.bin( 4.99 ) == bins ) ;
+      test.test( "upper limit in overflow", nativeAxis.bin( max ) == bins + 1 ) ;
+      test.test( "infinity in overflow", nativeAxis.bin( std::numeric_limits<double>::infinity() ) == bins + 1 ) ;
+      test.test( "NaN in underflow", nativeAxis.bin( std::numeric_limits<double>::quiet_NaN() ) == 0 ) ;
+
+      // the vectorised bin finding gives the same bins as the scalar one
+      std::mt19937 generator( 42 ) ;
+      std::uniform_real_distribution<double> distribution( -7., 7. ) ;
+      std::vector<double> xs( 1003 ) ;
+      for ( auto &x : xs ) {
+        x = distribution( generator ) ;
+      }
+      xs[5] = std::numeric_limits<double>::quiet_NaN() ;
+      xs[6] = -std::numeric_limits<double>::infinity() ;
+      std::vector<std::int32_t> vbins( xs.size() ) ;
+      nativeAxis.bins( xs.data(), xs.size(), vbins.data() ) ;
+      bool same = true ;
+      for ( std::size_t i = 0 ; i < xs.size() ; ++i ) {
+        same = same && static_cast<std::size_t>( vbins[i] ) == nativeAxis.bin( xs[i] ) ;
+      }
+      test.test( "vectorised bins", same ) ;
+    }
+    {
+      const std::vector<double> borders { 0., 1., 3., 10. } ;
+      native::Axis<double> irregular( AxisConfig<double>( "irregular", borders ) ) ;
+      test.test( "irregular bins", irregular.bins() == 3 ) ;
+      test.test( "irregular underflow", irregular.bin( -1. ) == 0 ) ;
+      test.test( "irregular bin", irregular.bin( 2. ) == 2 ) ;
+      test.test( "irregular overflow", irregular.bin( 10. ) == 4 ) ;
+    }
+    {
+      // FillN gives the same histogram as a Fill loop
+      std::mt19937 generator( 7 ) ;
+      std::normal_distribution<double> distribution( 0., 2. ) ;
+      std::vector<H2F::Point_t> points( 1000 ) ;
+      std::vector<H2F::Weight_t> weights( points.size() ) ;
+      for ( std::size_t i = 0 ; i < points.size() ; ++i ) {
+        points[i] = { distribution( generator ), distribution( generator ) } ;
+        weights[i] = static_cast<float>( i % 3 ) * 0.5F ;
+      }
+      H2F loop( "loop", axis, axis ) ;
+      H2F bulk( "bulk", axis, axis ) ;
+      for ( std::size_t i = 0 ; i < points.size() ; ++i ) {
+        loop.Fill( points[i], weights[i] ) ;
+      }
+      bulk.FillN( points.data(), points.data() + points.size(), weights.data(), weights.data() + weights.size() ) ;
+      test.test( "FillN entries", bulk.get().entries() == points.size() ) ;
+      test.test( "FillN bins", loop.get().content() == bulk.get().content() ) ;
+      test.test( "sumw2 stored for non-unit weights", bulk.get().hasSumw2() ) ;
+      const auto global = bulk.get().bin( points[1] ) ;
+      test.test( "bin content", bulk.get().binContent( global ) >= 0.5F ) ;
+
+      // merge
+      add( loop, bulk ) ;
+      bool doubled = true ;
+      for ( std::size_t i = 0 ; i < bulk.get().size() ; ++i ) {
+        doubled = doubled && std::fabs( loop.get().binContent( i ) - 2 * bulk.get().binContent( i ) ) < 1e-4 ;
+      }
+      test.test( "merged bins", doubled ) ;
+      test.test( "merged entries", loop.get().entries() == 2 * points.size() ) ;
+    }
+    {
+      H1I hist( axis ) ;
+      std::vector<H1I::Point_t> points { { 0.5 }, { 0.5 }, { 4.5 } } ;
+      hist.FillN( points.data(), points.data() + points.size() ) ;
+      test.test( "unit weights", hist.get().binContent( hist.get().bin( H1I::Point_t{ 0.5 } ) ) == 2 ) ;
+      test.test( "no sumw2 for unit weights", not hist.get().hasSumw2() ) ;
+      H1I other( AxisConfig<double>( "b", bins, min, 2 * max ) ) ;
+      bool thrown = false ;
+      try {
+        add( hist, other ) ;
+      } catch ( const exceptions::BookStoreException & ) {
+        thrown = true ;
+      }
+      test.test( "merge different binning", thrown ) ;
+    }
+    {
+      // book store modes
+      BookStore store{} ;
+      std::vector<H1D::Point_t> points ;
+      std::vector<H1D::Weight_t> weights ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        points.push_back( { min + static_cast<double>( i ) + 0.5 } ) ;
+        weights.push_back( static_cast<double>( i ) ) ;
+      }
+      Handle copies = store.book( "/", "copies", EntryData< H1D >( axis ).multiCopy( 2 ) ) ;
+      Handle shared = store.book( "/", "shared", EntryData< H1D >( axis ).multiShared( 2 ) ) ;
+      std::vector<std::thread> threads ;
+      for ( int t = 0 ; t < 2 ; ++t ) {
+        threads.emplace_back( [&](){
+          Handle< H1D > copy = copies.handle() ;
+          Handle< H1D > share = shared.handle() ;
+          copy.fillN( points, weights ) ;
+          for ( std::size_t i = 0 ; i < points.size() ; ++i ) {
+            share.fill( points[i], weights[i] ) ;
+          }
+        }) ;
+      }
+      for ( auto &thread : threads ) {
+        thread.join() ;
+      }
+      const auto &copiesHist = copies.merged().get() ;
+      const auto &sharedHist = shared.merged().get() ;
+      bool correct = true ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        correct = correct
+          && copiesHist.binContent( i + 1 ) == 2 * weights[i]
+          && sharedHist.binContent( i + 1 ) == 2 * weights[i] ;
+      }
+      test.test( "multi copy and shared merge", correct ) ;
+      test.test( "multi copy entries", copiesHist.entries() == 2 * bins ) ;
+      test.test( "shared entries", sharedHist.entries() == 2 * bins ) ;
+    }
+    {
+      // one bin array filled with atomic adds
+      BookStore store{} ;
+      constexpr int nThreads = 4 ;
+      std::vector<H1D::Point_t> points ;
+      std::vector<H1D::Weight_t> weights ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        points.push_back( { min + static_cast<double>( i ) + 0.5 } ) ;
+        weights.push_back( static_cast<double>( i ) + 0.5 ) ;
+      }
+      Handle atomic = store.book( "/", "atomic", EntryData< H1D >( axis ).multiAtomic() ) ;
+      std::vector<std::thread> threads ;
+      for ( int t = 0 ; t < nThreads ; ++t ) {
+        threads.emplace_back( [&](){
+          Handle< H1D > hnd = atomic.handle() ;
+          hnd.fillN( points, weights ) ;
+          for ( std::size_t i = 0 ; i < points.size() ; ++i ) {
+            hnd.fill( points[i], weights[i] ) ;
+          }
+        }) ;
+      }
+      for ( auto &thread : threads ) {
+        thread.join() ;
+      }
+      const auto &hist = atomic.merged().get() ;
+      bool correct = true ;
+      for ( std::size_t i = 0 ; i < bins ; ++i ) {
+        correct = correct
+          && hist.binContent( i + 1 ) == 2 * nThreads * weights[i]
+          && hist.binSumw2( i + 1 ) == 2 * nThreads * weights[i] * weights[i] ;
+      }
+      test.test( "multi atomic bins", correct ) ;
+      test.test( "multi atomic entries", hist.entries() == 2 * nThreads * bins ) ;
+      test.test( "multi atomic single instance", &hist == &atomic.merged().get() ) ;
+      test.test( "native bins are atomic", AtomicBins ) ;
+    }
+  } catch ( const exceptions::BookStoreException &e ) {
+    test.error( e.what() ) ;
+  }
+
+  return 0 ;
+}
@@ -0,0 +1,42 @@
+// -- marlinmt headers
+#include <marlinmt/ProcessorTiming.h>
+#include <marlinmt/Exceptions.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <cmath>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "ProcessorTiming" ) ;
+
+  test.test( "full mode", TimingMode::Full == timingModeFromString( "full" ) ) ;
+  test.test( "sampled mode", TimingMode::Sampled == timingModeFromString( "sampled" ) ) ;
+  test.test( "fast mode", TimingMode::Fast == timingModeFromString( "fast" ) ) ;
+  test.test( "mode names round trip", "sampled" == timingModeToString( timingModeFromString( "sampled" ) ) ) ;
+  try {
+    timingModeFromString( "slow" ) ;
+    test.error( "unknown timing mode accepted" ) ;
+  }
+  catch( Exception & ) {
+    test.pass( "unknown timing mode rejected" ) ;
+  }
+
+  test.test( "fast clock calibrated", fastclock::secondsPerTick() > 0. ) ;
+
+  // the fast clock must agree with the steady clock on a long enough interval
+  const clock::duration_rep crunchTime = 0.2f ;
+  auto start = clock::now() ;
+  auto fastStart = fastclock::now() ;
+  clock::crunchFor<clock::seconds>( crunchTime ) ;
+  auto fastEnd = fastclock::now() ;
+  auto steadyTime = clock::elapsed_since<clock::seconds>( start ) ;
+  auto fastTime = fastclock::time_difference( fastStart, fastEnd ) ;
+  std::cout << "Steady clock: " << steadyTime << " s, fast clock: " << fastTime << " s" << std::endl ;
+  test.test( "fast clock agrees with steady clock", std::fabs( fastTime - steadyTime ) < 0.1f * steadyTime ) ;
+
+  return 0 ;
+}
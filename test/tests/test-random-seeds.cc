@@ -0,0 +1,47 @@
+// -- marlinmt headers
+#include <marlinmt/RandomSeedManager.h>
+#include <marlinmt/Exceptions.h>
+#include <UnitTesting.h>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "RandomSeeds" ) ;
+
+  RandomSeedManager mgr1( 1234567890 ) ;
+  RandomSeedManager mgr2( 1234567890 ) ;
+  RandomSeedManager mgr3( 42 ) ;
+  int proc1 {0}, clone1 {0}, proc2 {0} ;
+
+  auto key1 = mgr1.addEntry( &proc1, "Proc1" ) ;
+  auto cloneKey1 = mgr1.addEntry( &clone1, "Proc1" ) ;
+  auto key2 = mgr1.addEntry( &proc2, "Proc2" ) ;
+  test.test( "clones share the key", key1 == cloneKey1 ) ;
+  test.test( "different names, different keys", key1 != key2 ) ;
+  test.test( "keys don't depend on the instance", mgr2.addEntry( &proc2, "Proc1" ) == key1 ) ;
+  try {
+    mgr1.addEntry( &proc1, "Proc1" ) ;
+    test.error( "entry registered twice" ) ;
+  }
+  catch( Exception & ) {
+    test.pass( "entry can't be registered twice" ) ;
+  }
+
+  // seeds only depend on the global seed, the event uid and the entry name
+  bool reproducible {true}, differentEvents {true}, differentGlobal {true} ;
+  for( std::size_t uid=0 ; uid<1000 ; ++uid ) {
+    const auto seed = RandomSeedManager::randomSeed( mgr1.eventSeed( uid ), key1 ) ;
+    reproducible = reproducible and ( seed == RandomSeedManager::randomSeed( mgr2.eventSeed( uid ), key1 ) ) ;
+    differentEvents = differentEvents and ( seed != RandomSeedManager::randomSeed( mgr1.eventSeed( uid+1 ), key1 ) ) ;
+    differentGlobal = differentGlobal and ( seed != RandomSeedManager::randomSeed( mgr3.eventSeed( uid ), key1 ) ) ;
+  }
+  test.test( "seeds reproducible", reproducible ) ;
+  test.test( "seeds differ between events", differentEvents ) ;
+  test.test( "seeds differ between global seeds", differentGlobal ) ;
+  test.test( "seeds differ between entries",
+    RandomSeedManager::randomSeed( mgr1.eventSeed( 0 ), key1 ) != RandomSeedManager::randomSeed( mgr1.eventSeed( 0 ), key2 ) ) ;
+
+  return 0 ;
+}
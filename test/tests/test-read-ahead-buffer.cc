@@ -0,0 +1,82 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/ReadAheadBuffer.h>
+#include <marlinmt/Exceptions.h>
+#include <UnitTesting.h>
+
+#include <thread>
+#include <chrono>
+#include <vector>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using namespace marlinmt::concurrency ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "ReadAheadBuffer" ) ;
+
+  // records are popped in the reading order
+  {
+    ReadAheadBuffer buffer( 4 ) ;
+    test.test( "max size", buffer.maxSize() == 4 ) ;
+    buffer.start( [&](){
+      for( unsigned int i=0 ; i<100 ; ++i ) {
+        if( 0 == i % 10 ) {
+          buffer.push( std::shared_ptr<RunHeader>( nullptr ) ) ;
+        }
+        else {
+          buffer.push( std::shared_ptr<EventStore>( nullptr ) ) ;
+        }
+      }
+    }) ;
+    ReadAheadBuffer::Record record {} ;
+    unsigned int nrecords {0} ;
+    while( buffer.pop( record ) ) {
+      ++ nrecords ;
+      // slow dispatcher: the reader fills the buffer
+      std::this_thread::sleep_for( std::chrono::microseconds( 100 ) ) ;
+    }
+    test.test( "all records popped", nrecords == 100 ) ;
+    test.test( "records counted", buffer.nRecords() == 100 ) ;
+    test.test( "occupancy in range", buffer.averageOccupancy() > 0. and buffer.averageOccupancy() <= 4. ) ;
+  }
+
+  // reader exceptions are forwarded to the dispatcher
+  {
+    ReadAheadBuffer buffer( 2 ) ;
+    buffer.start( [&](){
+      buffer.push( std::shared_ptr<EventStore>( nullptr ) ) ;
+      throw Exception( "read error" ) ;
+    }) ;
+    ReadAheadBuffer::Record record {} ;
+    bool thrown = false ;
+    unsigned int nrecords {0} ;
+    try {
+      while( buffer.pop( record ) ) {
+        ++ nrecords ;
+      }
+    }
+    catch( const Exception & ) {
+      thrown = true ;
+    }
+    test.test( "records before exception", nrecords == 1 ) ;
+    test.test( "exception forwarded", thrown ) ;
+  }
+
+  // stopping the buffer unblocks the reader
+  {
+    ReadAheadBuffer buffer( 1 ) ;
+    unsigned int npushed {0} ;
+    buffer.start( [&](){
+      while( buffer.push( std::shared_ptr<EventStore>( nullptr ) ) ) {
+        ++ npushed ;
+      }
+    }) ;
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) ) ;
+    buffer.stop() ;
+    test.test( "stopped", buffer.stopped() ) ;
+    test.test( "reader blocked on full buffer", npushed == 1 ) ;
+  }
+
+  return 0 ;
+}
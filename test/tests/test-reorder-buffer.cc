@@ -0,0 +1,118 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/ReorderBuffer.h>
+#include <UnitTesting.h>
+
+#include <thread>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using namespace marlinmt::concurrency ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "ReorderBuffer" ) ;
+
+  // single thread: insert in reverse order, pop in order
+  {
+    ReorderBuffer<int> buffer ;
+    buffer.setMaxSize( 4 ) ;
+    test.test( "max size", buffer.maxSize() == 4 ) ;
+    std::vector<std::size_t> sequences ;
+    for( unsigned int i=0 ; i<4 ; ++i ) {
+      sequences.push_back( buffer.acquire() ) ;
+    }
+    for( auto iter = sequences.rbegin() ; iter != sequences.rend() ; ++iter ) {
+      buffer.insert( *iter, static_cast<int>( *iter ) ) ;
+    }
+    bool ordered = true ;
+    int value {-1} ;
+    for( int i=0 ; i<4 ; ++i ) {
+      ordered = ordered and buffer.pop( value ) and ( value == i ) ;
+    }
+    test.test( "reverse insertion popped in order", ordered ) ;
+    bool thrown = false ;
+    try {
+      buffer.insert( 1, 1 ) ;
+    }
+    catch( const Exception & ) {
+      thrown = true ;
+    }
+    test.test( "insert popped sequence throws", thrown ) ;
+    buffer.stop() ;
+    test.test( "stopped and empty", not buffer.pop( value ) ) ;
+  }
+
+  // multiple threads inserting out of order with a small window
+  {
+    const unsigned int nelements = 10000 ;
+    const unsigned int nthreads = 4 ;
+    ReorderBuffer<unsigned int> buffer ;
+    buffer.setMaxSize( 8 ) ;
+    std::vector<std::size_t> sequences( nelements ) ;
+    std::vector<std::thread> threads ;
+    std::atomic<unsigned int> nextElement {0} ;
+    std::atomic<unsigned int> acquired {0} ;
+    // producer: acquires sequence numbers, blocks when the window is full
+    std::thread producer( [&](){
+      for( unsigned int i=0 ; i<nelements ; ++i ) {
+        sequences[i] = buffer.acquire() ;
+        ++ acquired ;
+      }
+      buffer.stop() ;
+    }) ;
+    // workers: insert the acquired elements in any order
+    for( unsigned int t=0 ; t<nthreads ; ++t ) {
+      threads.emplace_back( [&, t](){
+        std::mt19937 generator( t ) ;
+        std::uniform_int_distribution<int> sleep( 0, 20 ) ;
+        while( true ) {
+          const unsigned int i = nextElement++ ;
+          if( i >= nelements ) {
+            break ;
+          }
+          while( acquired.load() <= i ) {
+            std::this_thread::yield() ;
+          }
+          std::this_thread::sleep_for( std::chrono::microseconds( sleep( generator ) ) ) ;
+          unsigned int element = i ;
+          buffer.insert( sequences[i], std::move( element ) ) ;
+        }
+      }) ;
+    }
+    unsigned int expected {0} ;
+    unsigned int value {0} ;
+    bool ordered = true ;
+    while( buffer.pop( value ) ) {
+      ordered = ordered and ( value == expected ) ;
+      ++ expected ;
+    }
+    producer.join() ;
+    for( auto &thread : threads ) {
+      thread.join() ;
+    }
+    test.test( "all elements popped", expected == nelements ) ;
+    test.test( "popped in order", ordered ) ;
+    test.test( "occupancy bounded", buffer.averageOccupancy() <= 8. ) ;
+  }
+
+  // stop without draining
+  {
+    ReorderBuffer<int> buffer ;
+    buffer.setMaxSize( 2 ) ;
+    buffer.acquire() ;
+    std::thread stopper( [&](){
+      std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) ) ;
+      buffer.stop( false ) ;
+    }) ;
+    int value {0} ;
+    test.test( "abort releases pop", not buffer.pop( value ) ) ;
+    stopper.join() ;
+  }
+
+  return 0 ;
+}
@@ -0,0 +1,53 @@
+// -- marlinmt headers
+#include <marlinmt/RunContext.h>
+#include <UnitTesting.h>
+
+#include <future>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "RunContext" ) ;
+
+  RunContext context ;
+  test.test( "initial epoch", context.currentEpoch() == 0 ) ;
+  test.test( "no run header in epoch 0", context.runHeader( 0 ) == nullptr ) ;
+
+  // events of epoch 0 in flight
+  context.eventStarted( 0 ) ;
+  context.eventStarted( 0 ) ;
+  auto epoch1 = context.addRunHeader( nullptr ) ;
+  test.test( "new epoch", epoch1 == 1 ) ;
+  test.test( "current epoch", context.currentEpoch() == 1 ) ;
+  context.eventStarted( epoch1 ) ;
+
+  // epoch 0 has nothing older to wait for
+  context.waitPreviousEpochs( 0 ) ;
+
+  // the barrier for epoch 1 must wait for the two events of epoch 0
+  std::atomic<bool> released {false} ;
+  auto barrier = std::async( std::launch::async, [&](){
+    context.waitPreviousEpochs( epoch1 ) ;
+    released = true ;
+  }) ;
+  std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) ) ;
+  test.test( "barrier waiting", not released.load() ) ;
+  context.eventFinished( 0 ) ;
+  std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) ) ;
+  test.test( "barrier still waiting", not released.load() ) ;
+  context.eventFinished( 0 ) ;
+  barrier.get() ;
+  test.test( "barrier released", released.load() ) ;
+  test.test( "barrier time", context.barrierTime() > 0 ) ;
+
+  // events of the same epoch don't block the barrier
+  context.waitPreviousEpochs( epoch1 ) ;
+  context.eventFinished( epoch1 ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,123 @@
+// -- marlinmt headers
+#include <marlinmt/Sequence.h>
+#include <marlinmt/Processor.h>
+#include <marlinmt/ProcessorApi.h>
+#include <marlinmt/EventStore.h>
+#include <marlinmt/EventExtensions.h>
+#include <marlinmt/CompiledConditions.h>
+#include <marlinmt/RunContext.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+
+namespace {
+
+  /// Counts the events it processes
+  class CountingProcessor : public Processor {
+  public:
+    CountingProcessor() : Processor( "CountingProcessor" ) {}
+    void processEvent( EventStore * ) override { ++ _nEvents ; }
+    std::atomic<unsigned int> _nEvents {0} ;
+  };
+
+  /// Skips the events with an even unique id
+  class SkippingProcessor : public Processor {
+  public:
+    SkippingProcessor() : Processor( "SkippingProcessor" ) {}
+    void processEvent( EventStore *event ) override {
+      ++ _nEvents ;
+      if( 0 == event->uid() % 2 ) {
+        ProcessorApi::skipCurrentEvent( this, event ) ;
+      }
+    }
+    std::atomic<unsigned int> _nEvents {0} ;
+  };
+
+  template <typename T>
+  std::shared_ptr<T> addProcessor( Sequence &sequence, const std::string &name ) {
+    auto processor = std::make_shared<T>() ;
+    processor->setName( name ) ;
+    sequence.addItem( sequence.createItem( processor, nullptr ) ) ;
+    return processor ;
+  }
+
+  std::shared_ptr<EventStore> createEvent( std::size_t uid, const std::shared_ptr<const CompiledConditions> &conditions ) {
+    auto event = std::make_shared<EventStore>() ;
+    event->setUID( uid ) ;
+    event->extensions().recyclable<extensions::ProcessorConditions, ProcessorConditionsExtension>( conditions ) ;
+    return event ;
+  }
+
+}
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "Sequence skip" ) ;
+  constexpr unsigned int nEvents = 10 ;
+  const auto conditions = std::make_shared<const CompiledConditions>( std::map<std::string, std::string>{} ) ;
+
+  // the event stops at the skipping processor
+  {
+    Sequence sequence( std::make_shared<RunContext>() ) ;
+    auto first = addProcessor<CountingProcessor>( sequence, "First" ) ;
+    auto skipper = addProcessor<SkippingProcessor>( sequence, "Skipper" ) ;
+    auto last = addProcessor<CountingProcessor>( sequence, "Last" ) ;
+    unsigned int nProcessed {0} ;
+    for( unsigned int e=0 ; e<nEvents ; ++e ) {
+      auto event = createEvent( e, conditions ) ;
+      if( sequence.processEvent( event ) ) {
+        ++ nProcessed ;
+      }
+      if( 0 == e % 2 ) {
+        test.test( "skipped by the skipper", event->skippedBy() == skipper.get() ) ;
+      }
+    }
+    test.test( "processed events", nProcessed == nEvents / 2 ) ;
+    test.test( "first processor runs all events", first->_nEvents == nEvents ) ;
+    test.test( "skipper runs all events", skipper->_nEvents == nEvents ) ;
+    test.test( "last processor runs the kept events", last->_nEvents == nEvents / 2 ) ;
+    test.test( "no skip counted for first", sequence.statistics( 0 )._skipped == 0 ) ;
+    test.test( "skips counted for skipper", sequence.statistics( 1 )._skipped == nEvents / 2 ) ;
+    test.test( "no skip counted for last", sequence.statistics( 2 )._skipped == 0 ) ;
+  }
+
+  // items run one by one, as the DAG scheduler does: the skip is
+  // counted for the skipping item only and the next items don't run
+  {
+    Sequence sequence( std::make_shared<RunContext>() ) ;
+    auto skipper = addProcessor<SkippingProcessor>( sequence, "Skipper" ) ;
+    auto other = addProcessor<CountingProcessor>( sequence, "Other" ) ;
+    auto event = createEvent( 0, conditions ) ;
+    test.test( "skipping item returns false", not sequence.processEvent( event, 0 ) ) ;
+    test.test( "next item returns false", not sequence.processEvent( event, 1 ) ) ;
+    test.test( "next item not run", other->_nEvents == 0 ) ;
+    test.test( "skip counted once", sequence.statistics( 0 )._skipped == 1 ) ;
+    test.test( "skip not counted for next item", sequence.statistics( 1 )._skipped == 0 ) ;
+  }
+
+  // items of the same event on different threads
+  {
+    Sequence sequence( std::make_shared<RunContext>() ) ;
+    auto skipper = addProcessor<SkippingProcessor>( sequence, "Skipper" ) ;
+    auto other = addProcessor<CountingProcessor>( sequence, "Other" ) ;
+    for( unsigned int e=0 ; e<nEvents ; ++e ) {
+      auto event = createEvent( e, conditions ) ;
+      std::thread skipThread( [&](){ sequence.processEvent( event, 0 ) ; } ) ;
+      std::thread otherThread( [&](){ sequence.processEvent( event, 1 ) ; } ) ;
+      skipThread.join() ;
+      otherThread.join() ;
+    }
+    test.test( "concurrent skips counted for the skipper", sequence.statistics( 0 )._skipped == nEvents / 2 ) ;
+    test.test( "concurrent skips not counted for the other item", sequence.statistics( 1 )._skipped == 0 ) ;
+  }
+
+  return 0 ;
+}
@@ -0,0 +1,97 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/ThreadPool.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <set>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using namespace marlinmt::concurrency ;
+
+using Pool = ThreadPool<unsigned int,void> ;
+
+std::mutex idsMutex ;
+std::set<unsigned int> workerIds ;
+
+class IdWorker : public WorkerBase<unsigned int,void> {
+public:
+  IdWorker(unsigned int id) : _id(id) {}
+
+  void process( unsigned int && /*value*/ ) override {
+    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) ) ;
+    std::lock_guard<std::mutex> lock( idsMutex ) ;
+    workerIds.insert( _id ) ;
+  }
+
+private:
+  unsigned int _id {0} ;
+};
+
+void pushAndWait( Pool &pool, unsigned int n ) {
+  std::vector<Pool::PushResult> results ;
+  for( unsigned int i=0 ; i<n ; ++i ) {
+    unsigned int element = i ;
+    results.push_back( pool.push( Pool::PushPolicy::Blocking, std::move( element ) ) ) ;
+  }
+  for( auto &res : results ) {
+    res.second.get() ;
+  }
+}
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "ThreadPoolParking" ) ;
+
+  const unsigned int nworkers = 4 ;
+  Pool pool ;
+  for( unsigned int w=0 ; w<nworkers ; ++w ) {
+    pool.addWorker<IdWorker>( w ) ;
+  }
+  pool.setMaxQueueSize( 8 ) ;
+  pool.start() ;
+  test.test( "all active by default", pool.activeWorkers() == nworkers ) ;
+
+  bool thrown = false ;
+  try {
+    pool.setActiveWorkers( 0 ) ;
+  }
+  catch( const Exception & ) {
+    thrown = true ;
+  }
+  test.test( "no active worker throws", thrown ) ;
+
+  // only the first two workers take tasks
+  pool.setActiveWorkers( 2 ) ;
+  test.test( "two active", pool.activeWorkers() == 2 ) ;
+  pushAndWait( pool, 100 ) ;
+  {
+    std::lock_guard<std::mutex> lock( idsMutex ) ;
+    test.test( "parked workers idle", workerIds.count( 2 ) == 0 and workerIds.count( 3 ) == 0 ) ;
+    workerIds.clear() ;
+  }
+
+  // a single active worker must still process everything
+  pool.setActiveWorkers( 1 ) ;
+  pushAndWait( pool, 50 ) ;
+  {
+    std::lock_guard<std::mutex> lock( idsMutex ) ;
+    test.test( "single active worker", workerIds.size() == 1 and workerIds.count( 0 ) == 1 ) ;
+    workerIds.clear() ;
+  }
+
+  // unpark all workers
+  pool.setActiveWorkers( nworkers ) ;
+  pushAndWait( pool, 200 ) ;
+  {
+    std::lock_guard<std::mutex> lock( idsMutex ) ;
+    test.test( "unparked workers run", workerIds.size() > 1 ) ;
+  }
+
+  // stopping the pool releases the parked workers
+  pool.setActiveWorkers( 2 ) ;
+  pool.stop( false ) ;
+  test.test( "stopped", pool.size() == 0 ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,100 @@
+// -- marlinmt headers
+#include <marlinmt/book/ThreadSlot.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using marlinmt::book::ThreadSlot ;
+
+constexpr std::size_t NThreads = 8 ;
+
+int main() {
+
+  UnitTest test( "ThreadSlot" ) ;
+
+  const auto mainSlot = ThreadSlot::current() ;
+  test.test( "main thread slot", 0 == mainSlot ) ;
+  test.test( "main thread slot is stable", mainSlot == ThreadSlot::current() ) ;
+  test.test( "one slot assigned", 1 == ThreadSlot::assigned() ) ;
+
+  // all threads alive at the same time get distinct dense slots
+  std::vector<std::size_t> slots( NThreads, ThreadSlot::Unassigned ) ;
+  std::mutex mutex ;
+  std::condition_variable condition ;
+  std::size_t nReady {0} ;
+  bool release {false} ;
+  std::vector<std::thread> threads ;
+  for( std::size_t t=0 ; t<NThreads ; ++t ) {
+    threads.emplace_back( [&,t](){
+      slots[t] = ThreadSlot::current() ;
+      std::unique_lock<std::mutex> lock( mutex ) ;
+      ++ nReady ;
+      condition.notify_all() ;
+      condition.wait( lock, [&](){ return release ; } ) ;
+    }) ;
+  }
+  {
+    std::unique_lock<std::mutex> lock( mutex ) ;
+    condition.wait( lock, [&](){ return NThreads == nReady ; } ) ;
+    test.test( "all slots assigned", NThreads + 1 == ThreadSlot::assigned() ) ;
+    release = true ;
+    condition.notify_all() ;
+  }
+  for( auto &thread : threads ) {
+    thread.join() ;
+  }
+  std::sort( slots.begin(), slots.end() ) ;
+  bool dense {true} ;
+  for( std::size_t t=0 ; t<NThreads ; ++t ) {
+    dense = dense and ( t + 1 == slots[t] ) ;
+  }
+  test.test( "thread slots are distinct and dense", dense ) ;
+
+  // the slots of the exited threads are reused
+  test.test( "slots released on thread exit", 1 == ThreadSlot::assigned() ) ;
+  std::size_t reused {ThreadSlot::Unassigned} ;
+  std::thread( [&](){ reused = ThreadSlot::current() ; } ).join() ;
+  test.test( "lowest free slot reused", 1 == reused ) ;
+
+  // repeated lookups from concurrent threads, while other threads come and go
+  std::vector<std::size_t> firstSlots( NThreads, ThreadSlot::Unassigned ) ;
+  std::vector<char> stable( NThreads, 0 ) ;
+  std::size_t nStarted {0} ;
+  threads.clear() ;
+  for( std::size_t t=0 ; t<NThreads ; ++t ) {
+    threads.emplace_back( [&,t](){
+      firstSlots[t] = ThreadSlot::current() ;
+      {
+        // all the threads hold their slot before the lookups start
+        std::unique_lock<std::mutex> lock( mutex ) ;
+        ++ nStarted ;
+        condition.notify_all() ;
+        condition.wait( lock, [&](){ return NThreads == nStarted ; } ) ;
+      }
+      bool same {true} ;
+      for( unsigned int l=0 ; l<100000 ; ++l ) {
+        same = same and ( firstSlots[t] == ThreadSlot::current() ) ;
+        if( 0 == l % 10000 ) {
+          std::thread( [](){ static_cast<void>( ThreadSlot::current() ) ; } ).join() ;
+        }
+      }
+      stable[t] = same ? 1 : 0 ;
+    }) ;
+  }
+  for( auto &thread : threads ) {
+    thread.join() ;
+  }
+  test.test( "lookups stable in concurrent threads", std::all_of( stable.begin(), stable.end(), []( char s ){ return 1 == s ; } ) ) ;
+  std::sort( firstSlots.begin(), firstSlots.end() ) ;
+  test.test( "concurrent threads have distinct slots", std::adjacent_find( firstSlots.begin(), firstSlots.end() ) == firstSlots.end() ) ;
+  test.test( "all slots released", 1 == ThreadSlot::assigned() ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,65 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/WorkStealingPool.h>
+#include <marlinmt/Exceptions.h>
+#include <UnitTesting.h>
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using namespace marlinmt::concurrency ;
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "WorkStealingPool" ) ;
+
+  const std::size_t nworkers = 4 ;
+  WorkStealingPool pool ;
+  test.test( "not running", pool.size() == 0 ) ;
+  pool.start( nworkers ) ;
+  test.test( "running", pool.size() == nworkers ) ;
+
+  // tasks submitted from outside the pool
+  std::atomic<std::size_t> counter {0} ;
+  std::atomic<bool> validIndex {true} ;
+  for( unsigned int i=0 ; i<1000 ; ++i ) {
+    pool.submit( [&]( std::size_t worker ){
+      if( worker >= nworkers ) {
+        validIndex = false ;
+      }
+      ++ counter ;
+    }) ;
+  }
+  // tasks submitted from the workers (task graph)
+  std::atomic<std::size_t> children {0} ;
+  for( unsigned int i=0 ; i<100 ; ++i ) {
+    pool.submit( [&]( std::size_t ){
+      for( unsigned int j=0 ; j<10 ; ++j ) {
+        pool.submit( [&]( std::size_t ){
+          std::this_thread::sleep_for( std::chrono::microseconds( 10 ) ) ;
+          ++ children ;
+        }) ;
+      }
+    }) ;
+  }
+  // stop processes all submitted tasks
+  pool.stop() ;
+  test.test( "all tasks processed", counter.load() == 1000 ) ;
+  test.test( "all child tasks processed", children.load() == 1000 ) ;
+  test.test( "valid worker index", validIndex.load() ) ;
+  test.test( "stopped", pool.size() == 0 ) ;
+
+  bool thrown = false ;
+  try {
+    pool.submit( []( std::size_t ){} ) ;
+  }
+  catch( const Exception & ) {
+    thrown = true ;
+  }
+  test.test( "submit on stopped pool throws", thrown ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,146 @@
+// -- marlinmt headers
+#include <marlinmt/concurrency/ThreadPool.h>
+#include <marlinmt/concurrency/CpuResources.h>
+#include <UnitTesting.h>
+
+// -- std headers
+#include <set>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace marlinmt ;
+using namespace marlinmt::test ;
+using namespace marlinmt::concurrency ;
+
+using Pool = ThreadPool<unsigned int,void> ;
+
+class InitWorker : public WorkerBase<unsigned int,void> {
+public:
+  InitWorker( std::thread::id *initThread, bool fail ) :
+    _initThread(initThread),
+    _fail(fail) {}
+
+  void initialize() override {
+    *_initThread = std::this_thread::get_id() ;
+    if( _fail ) {
+      throw Exception( "InitWorker: initialization failure" ) ;
+    }
+  }
+
+  void process( unsigned int && /*value*/ ) override {
+    /* nop */
+  }
+
+private:
+  std::thread::id     *_initThread {nullptr} ;
+  bool                 _fail {false} ;
+};
+
+int main( int /*argc*/, char ** /*argv*/ ) {
+
+  UnitTest test( "WorkerAffinity" ) ;
+
+  const auto allowed = allowedCpus() ;
+  test.test( "allowed cpus", not allowed.empty() ) ;
+  test.test( "available cpus", availableCpus() >= 1 and availableCpus() <= allowed.size() ) ;
+  test.test( "policy from string", AffinityPolicy::Scatter == affinityPolicyFromString( "scatter" ) ) ;
+
+  // cgroup limits, read from a fake cgroup tree: the lowest limit on the path wins
+  {
+    namespace fs = std::filesystem ;
+    const auto root = fs::temp_directory_path() / "marlinmt-test-cgroup" ;
+    fs::remove_all( root ) ;
+    auto writeFile = []( const fs::path &path, const std::string &content ) {
+      fs::create_directories( path.parent_path() ) ;
+      std::ofstream( path ) << content << std::endl ;
+    } ;
+    auto isLimit = []( const std::optional<double> &limit, double value ) {
+      return limit.has_value() and std::fabs( limit.value() - value ) < 1e-9 ;
+    } ;
+    // cgroup v2
+    writeFile( root / "v2/proc", "0::/batch/job/step" ) ;
+    writeFile( root / "v2/fs/cpu.max", "max 100000" ) ;
+    writeFile( root / "v2/fs/batch/cpu.max", "200000 100000" ) ;
+    writeFile( root / "v2/fs/batch/job/cpu.max", "400000 100000" ) ;
+    writeFile( root / "v2/fs/batch/job/step/cpu.max", "max 100000" ) ;
+    test.test( "cgroup v2: lowest limit on the path", isLimit( cgroupCpuLimit( ( root / "v2/proc" ).string(), ( root / "v2/fs" ).string() ), 2. ) ) ;
+    writeFile( root / "v2/fs/batch/job/step/cpu.max", "150000 100000" ) ;
+    test.test( "cgroup v2: process cgroup limit", isLimit( cgroupCpuLimit( ( root / "v2/proc" ).string(), ( root / "v2/fs" ).string() ), 1.5 ) ) ;
+    writeFile( root / "v2/other", "0::/other" ) ;
+    test.test( "cgroup v2: no limit", not cgroupCpuLimit( ( root / "v2/other" ).string(), ( root / "v2/fs" ).string() ).has_value() ) ;
+    // cgroup v1, on a hybrid setup
+    writeFile( root / "v1/proc", "5:cpuacct,cpu:/slurm/job\n0::/unified" ) ;
+    writeFile( root / "v1/fs/cpu/cpu.cfs_quota_us", "-1" ) ;
+    writeFile( root / "v1/fs/cpu/cpu.cfs_period_us", "100000" ) ;
+    writeFile( root / "v1/fs/cpu/slurm/cpu.cfs_quota_us", "300000" ) ;
+    writeFile( root / "v1/fs/cpu/slurm/cpu.cfs_period_us", "100000" ) ;
+    writeFile( root / "v1/fs/cpu/slurm/job/cpu.cfs_quota_us", "-1" ) ;
+    writeFile( root / "v1/fs/cpu/slurm/job/cpu.cfs_period_us", "100000" ) ;
+    writeFile( root / "v1/fs/unified/cpu.max", "50000 100000" ) ;
+    test.test( "cgroup v1: parent limit", isLimit( cgroupCpuLimit( ( root / "v1/proc" ).string(), ( root / "v1/fs" ).string() ), 3. ) ) ;
+    test.test( "cgroup: unreadable files", not cgroupCpuLimit( ( root / "missing" ).string(), ( root / "missing" ).string() ).has_value() ) ;
+    fs::remove_all( root ) ;
+  }
+
+  bool thrown = false ;
+  try {
+    affinityPolicyFromString( "random" ) ;
+  }
+  catch( const Exception & ) {
+    thrown = true ;
+  }
+  test.test( "unknown policy throws", thrown ) ;
+
+  // more workers than cpus: all cpus are used
+  const std::size_t nworkers = 2 * allowed.size() ;
+  for( auto policy : { AffinityPolicy::Compact, AffinityPolicy::Scatter } ) {
+    auto cpus = workerCpus( policy, nworkers ) ;
+    std::set<unsigned int> used( cpus.begin(), cpus.end() ) ;
+    test.test( "worker cpus size", cpus.size() == nworkers ) ;
+    test.test( "worker cpus cover allowed", used.size() == allowed.size() ) ;
+  }
+  test.test( "no affinity", workerCpus( AffinityPolicy::None, nworkers ).empty() ) ;
+  auto listCpus = workerCpus( AffinityPolicy::List, 3, { allowed.front() } ) ;
+  test.test( "cpu list", listCpus.size() == 3 and listCpus[2] == allowed.front() ) ;
+
+  // workers are pinned and initialized in their own thread
+  {
+    const unsigned int npool = 3 ;
+    std::vector<std::thread::id> initThreads( npool ) ;
+    Pool pool ;
+    for( unsigned int w=0 ; w<npool ; ++w ) {
+      pool.addWorker<InitWorker>( &initThreads[w], false ) ;
+    }
+    pool.setWorkerCpus( workerCpus( AffinityPolicy::Compact, npool ) ) ;
+    pool.start() ;
+    const bool workerThreads = std::none_of( initThreads.begin(), initThreads.end(), []( std::thread::id id ){
+      return ( std::thread::id() == id ) or ( std::this_thread::get_id() == id ) ;
+    }) ;
+    test.test( "initialized in worker threads", workerThreads ) ;
+#ifdef __linux__
+    test.test( "workers pinned", pool.nPinnedWorkers() == npool ) ;
+#endif
+    pool.stop( false ) ;
+  }
+
+  // an initialization failure is rethrown by start()
+  {
+    std::vector<std::thread::id> initThreads( 2 ) ;
+    Pool pool ;
+    pool.addWorker<InitWorker>( &initThreads[0], false ) ;
+    pool.addWorker<InitWorker>( &initThreads[1], true ) ;
+    bool startThrown = false ;
+    try {
+      pool.start() ;
+    }
+    catch( const Exception & ) {
+      startThrown = true ;
+    }
+    test.test( "init failure rethrown", startThrown ) ;
+  }
+
+  return 0 ;
+}